@@ -0,0 +1,95 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+//
+// Element-wise kernel throughput per instruction set. Each benchmark reports items/s
+// (elements per second) so the ISAs compare directly; run with
+//   ./kernels_benchmark --benchmark_counters_tabular=true
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "finlib/core/Kernels.hpp"
+#include "finlib/core/TimeSeries.hpp"
+
+namespace {
+
+using ts::kernels::Isa;
+using ts::kernels::KernelTable;
+
+std::vector<double> ramp(size_t n, double offset) {
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) v[i] = offset + static_cast<double>(i % 97);
+    return v;
+}
+
+template <ts::kernels::BinaryKernel KernelTable::*Kernel>
+void binaryKernel(benchmark::State& state, Isa isa) {
+    const auto& table = ts::kernels::table(isa);
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto a = ramp(n, 1.0);
+    const auto b = ramp(n, 0.0);  // every 97th divisor is 0, exercising the masked lanes
+    std::vector<double> out(n);
+    for (auto _ : state) {
+        (table.*Kernel)(a.data(), b.data(), out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(n));
+}
+
+template <ts::kernels::ScalarKernel KernelTable::*Kernel>
+void scalarKernel(benchmark::State& state, Isa isa) {
+    const auto& table = ts::kernels::table(isa);
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto a = ramp(n, 1.0);
+    std::vector<double> out(n);
+    for (auto _ : state) {
+        (table.*Kernel)(a.data(), 1.0001, out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(n));
+}
+
+// End to end through the operator the callers actually use (dispatch + allocation).
+void seriesMultiply(benchmark::State& state) {
+    const auto n = static_cast<size_t>(state.range(0));
+    std::vector<int64_t> timestamps(n);
+    for (size_t i = 0; i < n; ++i) timestamps[i] = static_cast<int64_t>(i) * 60'000;
+    const ts::TimeSeries a("a", timestamps, ramp(n, 1.0));
+    const ts::TimeSeries b("b", a.getSharedTimestamps(), ramp(n, 2.0));
+    for (auto _ : state) {
+        auto product = a * b;
+        benchmark::DoNotOptimize(product.getValues().data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(n));
+    state.SetLabel(std::string(ts::kernels::toString(ts::kernels::detectedIsa())));
+}
+
+// Registered at static-init time for whatever this machine supports, so the table never
+// lists an ISA that would throw.
+const bool kRegistered = [] {
+    constexpr int64_t kSmall = 4'096;       // fits in L1/L2
+    constexpr int64_t kLarge = 5'000'000;   // 10 years of minutes-ish, memory bound
+    for (Isa isa : ts::kernels::supportedIsas()) {
+        const std::string suffix = "/" + std::string(ts::kernels::toString(isa));
+        benchmark::RegisterBenchmark(("add" + suffix).c_str(), binaryKernel<&KernelTable::add>, isa)
+            ->Arg(kSmall)
+            ->Arg(kLarge);
+        benchmark::RegisterBenchmark(("mul" + suffix).c_str(), binaryKernel<&KernelTable::mul>, isa)
+            ->Arg(kSmall)
+            ->Arg(kLarge);
+        benchmark::RegisterBenchmark(("divMasked" + suffix).c_str(), binaryKernel<&KernelTable::div>, isa)
+            ->Arg(kSmall)
+            ->Arg(kLarge);
+        benchmark::RegisterBenchmark(("mulScalar" + suffix).c_str(), scalarKernel<&KernelTable::mulScalar>, isa)
+            ->Arg(kSmall)
+            ->Arg(kLarge);
+    }
+    benchmark::RegisterBenchmark("TimeSeries::operator*", seriesMultiply)->Arg(kSmall)->Arg(kLarge);
+    return true;
+}();
+
+}  // namespace
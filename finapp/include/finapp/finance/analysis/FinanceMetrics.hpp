@@ -24,6 +24,12 @@ inline ts::analysis::MetricFn<double> annualizedVolatility(double annualizationF
     return [annualizationFactor](TimeSeriesView v) { return finapp::stats::volatility(v, annualizationFactor); };
 }
 
+inline ts::analysis::MetricFn<double> annualizedEwmaVolatility(double halfLife, double annualizationFactor = 252.0) {
+    return [halfLife, annualizationFactor](TimeSeriesView v) {
+        return finapp::stats::ewmaVolatility(v, halfLife, annualizationFactor);
+    };
+}
+
 inline ts::analysis::MultiMetricFn<std::vector<std::vector<double>>> correlationMatrix() {
     return [](const std::unordered_map<std::string, TimeSeriesView>& views) {
         std::vector<const TimeSeriesView*> ordered;
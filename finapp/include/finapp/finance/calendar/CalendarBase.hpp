@@ -39,12 +39,13 @@ class CalendarBase : public TradingCalendar {
         return ts;
     }
 
-    // One tick per trading day in [start, end], aligned to local midnight (in UTC).
+    // One tick per trading day in [start, end], aligned to local midnight (in UTC). Interned by
+    // content: the same schedule from any calendar instance is one shared grid.
     TimestampsPtr schedule(Timestamp start, Timestamp end) const override {
-        auto out = std::make_shared<std::vector<Timestamp>>();
+        std::vector<Timestamp> out;
         for (Timestamp d = floorDay_(start); d <= end; d += kMsPerDay_)
-            if (isTradingDay(d)) out->push_back(d);
-        return out;
+            if (isTradingDay(d)) out.push_back(d);
+        return ts::TimestampGrid::intern(std::make_shared<const ts::TimestampGrid>(std::move(out)));
     }
 
     double periodsPerYear(Timestamp start, Timestamp end) const override {
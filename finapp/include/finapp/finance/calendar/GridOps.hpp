@@ -6,13 +6,15 @@
 #include <cstdint>
 #include <memory>
 #include <span>
+#include <utility>
 #include <vector>
 
+#include "finlib/common/FinlibTypes.hpp"
+
 namespace finance {
 using Timestamp = int64_t;
-// Same type as ts::TimestampsPtr (const inner vector) so grids interoperate with the
-// TimeSeries layer without conversion.
-using TimestampsPtr = std::shared_ptr<const std::vector<int64_t>>;
+// The TimeSeries layer's own grid handle, so grids interoperate without conversion.
+using TimestampsPtr = ts::TimestampsPtr;
 
 enum class GridMode { Union, Intersection };
 
@@ -23,30 +25,30 @@ enum class GridMode { Union, Intersection };
 inline TimestampsPtr unionPair(const TimestampsPtr& gridA, const TimestampsPtr& gridB) {
     const auto& a = *gridA;
     const auto& b = *gridB;
-    auto output = std::make_shared<std::vector<Timestamp>>();
-    output->reserve(a.size() + b.size());
+    std::vector<Timestamp> output;
+    output.reserve(a.size() + b.size());
     size_t i{0}, j{0};
     while (i < a.size() && j < b.size()) {
         if (a[i] < b[j]) {
-            output->push_back(a[i++]);
+            output.push_back(a[i++]);
         } else if (b[j] < a[i]) {
-            output->push_back(b[j++]);
+            output.push_back(b[j++]);
         } else {
-            output->push_back(a[i]);
+            output.push_back(a[i]);
             ++i;
             ++j;
         }
     }
-    while (i < a.size()) output->push_back(a[i++]);
-    while (j < b.size()) output->push_back(b[j++]);
-    return output;
+    while (i < a.size()) output.push_back(a[i++]);
+    while (j < b.size()) output.push_back(b[j++]);
+    return std::make_shared<const ts::TimestampGrid>(std::move(output));
 }
 
 inline TimestampsPtr intersectionPair(const TimestampsPtr& gridA, const TimestampsPtr& gridB) {
     const auto& a = *gridA;
     const auto& b = *gridB;
-    auto output = std::make_shared<std::vector<Timestamp>>();
-    output->reserve(std::min(a.size(), b.size()));
+    std::vector<Timestamp> output;
+    output.reserve(std::min(a.size(), b.size()));
     size_t i{0}, j{0};
     while (i < a.size() && j < b.size()) {
         if (a[i] < b[j]) {
@@ -54,23 +56,23 @@ inline TimestampsPtr intersectionPair(const TimestampsPtr& gridA, const Timestam
         } else if (b[j] < a[i]) {
             ++j;
         } else {
-            output->push_back(a[i]);
+            output.push_back(a[i]);
             ++i;
             ++j;
         }
     }
-    return output;
+    return std::make_shared<const ts::TimestampGrid>(std::move(output));
 }
 
 inline TimestampsPtr unionOf(std::span<const TimestampsPtr> grids) {
-    if (grids.empty()) return std::make_shared<std::vector<Timestamp>>();
+    if (grids.empty()) return std::make_shared<const ts::TimestampGrid>();
     TimestampsPtr output = grids[0];
     for (size_t i = 1; i < grids.size(); ++i) output = unionPair(output, grids[i]);
     return output;
 }
 
 inline TimestampsPtr intersectionOf(std::span<const TimestampsPtr> grids) {
-    if (grids.empty()) return std::make_shared<std::vector<Timestamp>>();
+    if (grids.empty()) return std::make_shared<const ts::TimestampGrid>();
     TimestampsPtr output = grids[0];
     for (size_t i = 1; i < grids.size(); ++i) output = intersectionPair(output, grids[i]);
     return output;
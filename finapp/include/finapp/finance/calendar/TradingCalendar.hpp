@@ -5,10 +5,12 @@
 #include <memory>
 #include <vector>
 
+#include "finlib/common/FinlibTypes.hpp"
+
 namespace finance {
 using Timestamp = int64_t;
-// Same type as ts::TimestampsPtr (const inner vector).
-using TimestampsPtr = std::shared_ptr<const std::vector<int64_t>>;
+// Same type as ts::TimestampsPtr.
+using TimestampsPtr = ts::TimestampsPtr;
 
 enum class RollConvention : std::uint8_t {
     Following,          //
@@ -1,10 +1,14 @@
 // Copyright 2026 JBBLET
 #pragma once
 
+#include <Eigen/Dense>
+#include <format>
+#include <string_view>
 #include <vector>
 
 namespace ts {
 class TimeSeriesView;
+class TimeSeriesPanel;
 }  // namespace ts
 
 using ts::TimeSeriesView;
@@ -18,11 +22,52 @@ double volatility(const TimeSeriesView& returnSeries, double annualizationFactor
 // sharpe = mean(returns) / standardDeviation(returns) * sqrt(annualizationFactor)
 double sharpeRatio(const TimeSeriesView& returnSeries, double annualizationFactor = 252.0);
 
+// Annualized EWMA volatility at the last row, RiskMetrics style: squared returns around zero,
+// weighted by 0.5^(age / halfLife) (decay 0.94 is a half-life of about 11.2 observations).
+double ewmaVolatility(const TimeSeriesView& returnSeries, double halfLife, double annualizationFactor = 252.0);
+
 // Total return from a price series: (last - first) / first
 double totalReturn(const TimeSeriesView& priceSeries);
 
-// Pearson correlation matrix over an ordered set of return series.
+// What the sample covariance is pulled towards before it is returned. LedoitWolf shrinks it
+// towards mean-variance · I with the intensity of Ledoit & Wolf (2004), which keeps an N-asset
+// matrix well conditioned when N is not small next to the number of rows.
+enum class Shrinkage { None, LedoitWolf };
+
+constexpr std::string_view toString(Shrinkage shrinkage) {
+    switch (shrinkage) {
+        case Shrinkage::None: return "None";
+        case Shrinkage::LedoitWolf: return "LedoitWolf";
+    }
+    return "<unknown Shrinkage>";
+}
+
+// Sample (n - 1) covariance of aligned return series: the views must all be the same length.
+// The series are packed into one T×N block, centred once, and the matrix comes out of a single
+// symmetric rank-k product (XᵀX), so the cost is one BLAS-3 call rather than N² scalar loops.
+//
+// Missing values (a view's validity mask, or a non-finite value) are handled pairwise-complete:
+// entry (a, b) uses the rows where both a and b are present, with means over those rows — the
+// counts, sums and cross-products for all pairs come from four products against the 0/1 mask.
+// Pairs sharing fewer than two rows are NaN. The shrinkage intensity is estimated on the rows
+// where every series is present; it throws InvalidArgument when there are fewer than two.
+Eigen::MatrixXd covarianceMatrix(const std::vector<const TimeSeriesView*>& views,
+                                 Shrinkage shrinkage = Shrinkage::None);
+Eigen::MatrixXd covarianceMatrix(const ts::TimeSeriesPanel& panel, Shrinkage shrinkage = Shrinkage::None);
+
+// Pearson correlation matrix over an ordered set of return series, same rules as
+// covarianceMatrix (pairwise-complete: each entry is normalised by the variances over the rows
+// it used). A series with zero variance correlates 0 with everything but itself.
 // Result is row-major: result[i][j] = correlation between views[i] and views[j].
-std::vector<std::vector<double>> correlationMatrix(const std::vector<const TimeSeriesView*>& views);
+std::vector<std::vector<double>> correlationMatrix(const std::vector<const TimeSeriesView*>& views,
+                                                   Shrinkage shrinkage = Shrinkage::None);
+Eigen::MatrixXd correlationMatrix(const ts::TimeSeriesPanel& panel, Shrinkage shrinkage = Shrinkage::None);
 
 }  // namespace finapp::stats
+
+template <>
+struct std::formatter<finapp::stats::Shrinkage> : std::formatter<std::string_view> {
+    auto format(finapp::stats::Shrinkage shrinkage, std::format_context& ctx) const -> std::format_context::iterator {
+        return std::formatter<std::string_view>::format(finapp::stats::toString(shrinkage), ctx);
+    }
+};
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "finapp/data/providers/interfaces/IAssetProviders.hpp"
 #include "finapp/data/repository/interface/IAssetRepository.hpp"
@@ -11,6 +12,7 @@
 #include "finlib/analysis/session/TimeSeriesSession.hpp"
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/services/TimeSeriesService.hpp"
 
 using ts::InterpolationStrategy;
@@ -38,6 +40,9 @@ class AssetService {
     // Overload sharing a caller-owned timestamp grid. Cash positions return a constant
     // 1.0 series in their own denomination (FX conversion is the caller's job).
     TimeSeries loadTimeSeriesValue(const finance::AssetId& assetId, TimestampsPtr timestamps);
+    // The same for many assets at once: one column per asset, named by its ticker, with every
+    // price series resampled in one TimeSeriesService::getFilledMany batch.
+    ts::TimeSeriesPanel loadTimeSeriesValues(const std::vector<finance::AssetId>& assetIds, TimestampsPtr timestamps);
 
     // Native observation timestamps in [startMs, endMs] — no resampling. Cash/unpriced
     // assets return an empty grid. Used to assemble a portfolio's analysis grid.
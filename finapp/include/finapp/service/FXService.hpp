@@ -5,11 +5,13 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "finapp/data/repository/interface/IFXRepository.hpp"
 #include "finapp/finance/common/Currency.hpp"
 #include "finlib/analysis/session/TimeSeriesSession.hpp"
 #include "finlib/common/FinlibTypes.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/services/TimeSeriesService.hpp"
 
 using ts::InterpolationStrategy;
@@ -34,6 +36,10 @@ class FXService {
     // pointer-aligned in downstream operators (PortfolioService::valueSeries).
     TimeSeries load(const finance::Currency& baseCurrency, const finance::Currency& quoteCurrency,
                     TimestampsPtr timestamps);
+    // Every base currency into one quote currency at once: one column per base, named by the
+    // pair id, resampled in one TimeSeriesService::getFilledMany batch.
+    ts::TimeSeriesPanel load(const std::vector<finance::Currency>& baseCurrencies,
+                             const finance::Currency& quoteCurrency, TimestampsPtr timestamps);
 
     // Native FX observation timestamps in [startMs, endMs] — no resampling. Same-currency
     // pairs return an empty grid. Used to assemble a portfolio's analysis grid.
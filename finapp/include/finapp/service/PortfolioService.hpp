@@ -122,6 +122,13 @@ class PortfolioService {
                             Timestamp frequencyMs);
     void rebuildSnapshotsFrom_(const std::string& portfolioId, Timestamp fromTimestampMs);
 
+    // Fills priceInBase (per unit, in the base currency) for every asset the snapshots hold and
+    // fxCache (to the base currency) for every cash and denomination currency, all on timestamps.
+    // Prices and FX rates are resampled in one batch each rather than one series at a time.
+    void loadPricesInBase_(const std::vector<finance::PortfolioSnapshot>& snapshots, TimestampsPtr timestamps,
+                           std::unordered_map<finance::AssetId, TimeSeries>& priceInBase,
+                           std::unordered_map<finance::Currency, TimeSeries>& fxCache);
+
     finance::PortfolioOverviewAtTs computePortfolioSnapshotAtSpecificTs_(const finance::PortfolioSnapshot& snapshot,
                                                                          Timestamp ts);
 };
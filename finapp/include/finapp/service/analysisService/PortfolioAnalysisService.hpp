@@ -18,6 +18,7 @@ class Portfolio;
 
 using ts::Timestamp;
 using ts::Timestamps;
+using ts::TimestampsPtr;
 
 namespace finapp {
 
@@ -30,7 +31,7 @@ class PortfolioAnalysisService {
                                                                                   Timestamp frequencyMs);
 
     std::shared_ptr<finance::analysis::PortfolioAnalysis> createPortfolioAnalysis(
-        const finance::Portfolio& portfolio, std::shared_ptr<Timestamps> timestamps);
+        const finance::Portfolio& portfolio, TimestampsPtr timestamps);
 
  private:
     std::shared_ptr<AssetAnalysisService> assetAnalysisService_;
@@ -39,7 +40,7 @@ class PortfolioAnalysisService {
         const finance::Portfolio& portfolio, Timestamp startMs, Timestamp endMs, Timestamp frequencyMs);
 
     std::vector<std::shared_ptr<finance::analysis::IAssetAnalysis>> buildAssetAnalyses_(
-        const finance::Portfolio& portfolio, std::shared_ptr<Timestamps> timestamps);
+        const finance::Portfolio& portfolio, TimestampsPtr timestamps);
 
     static std::pair<finance::analysis::NavMode, std::unordered_map<std::string, double>> resolveNavWeights_(
         const finance::Portfolio& portfolio);
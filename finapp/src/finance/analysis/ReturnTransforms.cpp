@@ -22,7 +22,7 @@ ts::TimeSeries logReturns(const ts::TimeSeries& series) {
         else
             returns.push_back(std::numeric_limits<double>::quiet_NaN());
     }
-    auto retTs = std::make_shared<std::vector<int64_t>>(ts.begin() + (ts.empty() ? 0 : 1), ts.end());
+    auto retTs = std::make_shared<const ts::TimestampGrid>(ts::Timestamps(ts.begin() + (ts.empty() ? 0 : 1), ts.end()));
     return ts::TimeSeries("LogReturns_" + series.getId(), std::move(retTs), std::move(returns));
 }
 
@@ -37,7 +37,7 @@ ts::TimeSeries simpleReturns(const ts::TimeSeries& series) {
         else
             returns.push_back(std::numeric_limits<double>::quiet_NaN());
     }
-    auto retTs = std::make_shared<std::vector<int64_t>>(ts.begin() + (ts.empty() ? 0 : 1), ts.end());
+    auto retTs = std::make_shared<const ts::TimestampGrid>(ts::Timestamps(ts.begin() + (ts.empty() ? 0 : 1), ts.end()));
     return ts::TimeSeries("SimpleReturns_" + series.getId(), std::move(retTs), std::move(returns));
 }
 
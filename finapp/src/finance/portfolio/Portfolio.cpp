@@ -18,6 +18,7 @@
 #include "finapp/finance/portfolio/Transaction.hpp"
 #include "finlib/common/utils/TimeSeriesUtils.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesExpression.hpp"
 
 namespace finance {
 // TODO(JBBLET) add extra transaction check such as Dividend on a bond does not make sense
@@ -145,14 +146,13 @@ ts::TimeSeries Portfolio::valueSeries(ts::TimestampsPtr grid,
                                       const std::unordered_map<finance::AssetId, ts::TimeSeries>& priceInBase,
                                       const std::unordered_map<finance::Currency, ts::TimeSeries>& fxToBase) const {
     ts::TimeSeries total = ts::common::utils::timeSeries::generateConstantTimeSeries(id_ + "_value", grid, 0.0);
+    // Folded straight into the accumulator: no per-position temporary series.
     for (const auto& pos : positions_) {
         if (pos.quantity == 0.0) continue;
-        auto pv = priceInBase.at(pos.assetId) * pos.quantity;
-        total += pv;
+        total += ts::lazy(priceInBase.at(pos.assetId)) * pos.quantity;
     }
     for (const auto& [currency, amount] : cashBalances_) {
-        auto cashVal = fxToBase.at(currency) * amount;
-        total += cashVal;
+        total += ts::lazy(fxToBase.at(currency)) * amount;
     }
     return total;
 }
@@ -1,11 +1,17 @@
 // Copyright 2026 JBBLET
 #include "finapp/finance/stats/FinanceStats.hpp"
 
+#include <Eigen/Dense>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <vector>
 
+#include "finlib/common/Error.hpp"
+#include "finlib/core/Ewma.hpp"
 #include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
 
 namespace finapp::stats {
@@ -20,6 +26,24 @@ double sharpeRatio(const TimeSeriesView& returnSeries, double annualizationFacto
     return ts::analysis::stats::mean(returnSeries) * std::sqrt(annualizationFactor) / sigma;
 }
 
+double ewmaVolatility(const TimeSeriesView& returnSeries, double halfLife, double annualizationFactor) {
+    if (returnSeries.size() == 0) return std::numeric_limits<double>::quiet_NaN();
+    // Only the final state is wanted, so the rows stream through one accumulator instead of
+    // filling a full-length series to read its last entry. Missing rows age the weights, as in
+    // stats::ewma.
+    ts::analysis::stats::EwmaMoments moments(ts::analysis::stats::EwmaParameters::fromHalfLife(halfLife, false, false));
+    const ts::ValidityMask valid = returnSeries.validity();
+    for (size_t i = 0; i < returnSeries.size(); ++i) {
+        const double r = returnSeries[i];
+        if (valid.allValid() ? std::isfinite(r) : valid.isValid(i)) {
+            moments.push(r);
+        } else {
+            moments.skip();
+        }
+    }
+    return moments.standardDeviation() * std::sqrt(annualizationFactor);
+}
+
 double totalReturn(const TimeSeriesView& priceSeries) {
     if (priceSeries.size() < 2) return std::numeric_limits<double>::quiet_NaN();
     const double first = priceSeries[0];
@@ -27,30 +51,152 @@ double totalReturn(const TimeSeriesView& priceSeries) {
     return (priceSeries[priceSeries.size() - 1] - first) / first;
 }
 
-std::vector<std::vector<double>> correlationMatrix(const std::vector<const TimeSeriesView*>& views) {
-    const size_t m = views.size();
-    std::vector<std::vector<double>> result(m, std::vector<double>(m, 0.0));
-    if (m == 0) return result;
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// T×N block, one column per view, NaN where a value is missing.
+Eigen::MatrixXd packViews(const std::vector<const TimeSeriesView*>& views) {
+    if (views.empty()) return {};
+    const size_t rows = views.front()->size();
+    Eigen::MatrixXd block(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(views.size()));
+    for (size_t j = 0; j < views.size(); ++j) {
+        const TimeSeriesView& view = *views[j];
+        ts::ensure<ts::InvalidArgument>(view.size() == rows,
+                                        "covarianceMatrix: views must be aligned, '{}' has {} rows, expected {}",
+                                        view.getTimeSeriesId(),
+                                        view.size(),
+                                        rows);
+        auto column = block.col(static_cast<Eigen::Index>(j));
+        column = view.asEigenVector();
+        if (!view.hasValidity()) continue;
+        const ts::ValidityMask mask = view.validity();
+        for (size_t i = 0; i < rows; ++i) {
+            if (!mask.isValid(i)) column(static_cast<Eigen::Index>(i)) = kNaN;
+        }
+    }
+    return block;
+}
+
+// XᵀX as one symmetric rank-k update (half the work of the general product), mirrored to full.
+Eigen::MatrixXd gram(const Eigen::MatrixXd& x) {
+    Eigen::MatrixXd lower = Eigen::MatrixXd::Zero(x.cols(), x.cols());
+    lower.selfadjointView<Eigen::Lower>().rankUpdate(x.transpose());
+    return lower.selfadjointView<Eigen::Lower>();
+}
+
+struct SampleMoments {
+    Eigen::MatrixXd covariance;
+    // pairVariance(a, b): variance of a over the rows it shares with b, which is what entry
+    // (a, b) of the correlation matrix is normalised by.
+    Eigen::MatrixXd pairVariance;
+};
+
+// Shrinkage intensity of Ledoit & Wolf (2004) towards mu·I, on the rows where every series is
+// present: min(beta, delta) / delta with delta = ||S - mu·I||² and beta the estimated
+// variance of S's entries, sum_t ||x_t x_tᵀ - S||² / T², expanded so no T×N×N term is formed.
+double ledoitWolfIntensity(const Eigen::MatrixXd& centred, const Eigen::Array<bool, Eigen::Dynamic, 1>& complete) {
+    const Eigen::Index rows = complete.count();
+    ts::ensure<ts::InvalidArgument>(rows >= 2, "Ledoit-Wolf shrinkage needs two complete rows, have {}", rows);
+    Eigen::MatrixXd x(rows, centred.cols());
+    for (Eigen::Index i = 0, r = 0; i < centred.rows(); ++i) {
+        if (complete(i)) x.row(r++) = centred.row(i);
+    }
+    x.rowwise() -= x.colwise().mean();
+
+    const auto t = static_cast<double>(rows);
+    const Eigen::MatrixXd s = gram(x) / t;
+    const double mu = s.trace() / static_cast<double>(s.cols());
+    Eigen::MatrixXd offTarget = s;
+    offTarget.diagonal().array() -= mu;
+    const double delta = offTarget.squaredNorm();
+    if (delta <= 0.0) return 0.0;  // already a multiple of the identity
+    const double fourth = x.rowwise().squaredNorm().array().square().sum();
+    const double beta = (fourth / t - s.squaredNorm()) / t;
+    return std::clamp(beta / delta, 0.0, 1.0);
+}
 
-    std::vector<double> means(m);
-    std::vector<double> stddevs(m);
-    for (size_t i = 0; i < m; ++i) {
-        means[i] = ts::analysis::stats::mean(*views[i]);
-        stddevs[i] = ts::analysis::stats::standardDeviation(*views[i]);
+SampleMoments sampleMoments(Eigen::MatrixXd block, Shrinkage shrinkage) {
+    const Eigen::Index rows = block.rows();
+    const Eigen::Index cols = block.cols();
+    const Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> present = block.array().isFinite();
+
+    // Centre each column on the mean of its present values: a shift leaves every covariance
+    // unchanged and keeps the raw cross-products below from cancelling. Missing lanes become 0,
+    // so they drop out of every product.
+    for (Eigen::Index j = 0; j < cols; ++j) {
+        const Eigen::Index count = present.col(j).count();
+        const double sum = present.col(j).select(block.col(j), 0.0).sum();
+        const double mean = count == 0 ? 0.0 : sum / static_cast<double>(count);
+        block.col(j) = present.col(j).select(block.col(j).array() - mean, 0.0);
+    }
+
+    SampleMoments moments;
+    if (present.all()) {
+        moments.covariance = rows < 2 ? Eigen::MatrixXd::Constant(cols, cols, kNaN)
+                                      : Eigen::MatrixXd(gram(block) / static_cast<double>(rows - 1));
+        moments.pairVariance = moments.covariance.diagonal().replicate(1, cols);
+    } else {
+        // Pairwise-complete: with M the 0/1 presence mask and X the zero-filled block,
+        //   n = MᵀM (shared rows), S = XᵀM (S(a, b) = sum of a over rows shared with b),
+        //   Q = XᵀX, V = (X∘X)ᵀM,
+        // so cov(a, b) = (Q - S∘Sᵀ/n) / (n - 1) and the matching variance (V - S∘S/n) / (n - 1).
+        const Eigen::MatrixXd mask = present.cast<double>();
+        const Eigen::ArrayXXd n = gram(mask).array();
+        const Eigen::ArrayXXd sums = (block.transpose() * mask).array();
+        const Eigen::ArrayXXd cross = gram(block).array();
+        const Eigen::ArrayXXd squares = (block.array().square().matrix().transpose() * mask).array();
+        const Eigen::ArrayXXd dof = n - 1.0;
+        moments.covariance = (n < 2.0).select(kNaN, (cross - sums * sums.transpose() / n) / dof).matrix();
+        moments.pairVariance = (n < 2.0).select(kNaN, (squares - sums.square() / n) / dof).matrix();
+    }
+
+    if (shrinkage == Shrinkage::LedoitWolf) {
+        const double intensity = ledoitWolfIntensity(block, present.rowwise().all().transpose());
+        const double mu = moments.covariance.diagonal().mean();
+        moments.covariance *= 1.0 - intensity;
+        moments.covariance.diagonal().array() += intensity * mu;
+        // The shrunk matrix is one estimate, so it is normalised by its own diagonal.
+        moments.pairVariance = moments.covariance.diagonal().replicate(1, cols);
     }
+    return moments;
+}
+
+Eigen::MatrixXd correlationFrom(const SampleMoments& moments) {
+    const Eigen::ArrayXXd scale = (moments.pairVariance.array() * moments.pairVariance.transpose().array()).sqrt();
+    Eigen::MatrixXd correlation = (scale > 0.0).select(moments.covariance.array() / scale, 0.0).matrix();
+    // A NaN variance (too few shared rows) leaves the entry undefined rather than 0.
+    correlation = scale.isNaN().select(kNaN, correlation.array()).matrix();
+    for (Eigen::Index j = 0; j < correlation.cols(); ++j) {
+        if (!std::isnan(correlation(j, j))) correlation(j, j) = 1.0;
+    }
+    return correlation;
+}
+}  // namespace
 
-    const size_t n = views[0]->size();
+Eigen::MatrixXd covarianceMatrix(const std::vector<const TimeSeriesView*>& views, Shrinkage shrinkage) {
+    return sampleMoments(packViews(views), shrinkage).covariance;
+}
+
+Eigen::MatrixXd covarianceMatrix(const ts::TimeSeriesPanel& panel, Shrinkage shrinkage) {
+    return sampleMoments(panel.asEigenMatrix(), shrinkage).covariance;
+}
+
+std::vector<std::vector<double>> correlationMatrix(const std::vector<const TimeSeriesView*>& views,
+                                                   Shrinkage shrinkage) {
+    const size_t m = views.size();
+    std::vector<std::vector<double>> result(m, std::vector<double>(m, 0.0));
+    if (m == 0) return result;
+    const Eigen::MatrixXd correlation = correlationFrom(sampleMoments(packViews(views), shrinkage));
     for (size_t a = 0; a < m; ++a) {
-        result[a][a] = 1.0;
-        for (size_t b = a + 1; b < m; ++b) {
-            double cov = 0.0;
-            for (size_t i = 0; i < n; ++i) cov += ((*views[a])[i] - means[a]) * ((*views[b])[i] - means[b]);
-            cov /= static_cast<double>(n - 1);
-            const double corr = (stddevs[a] > 0.0 && stddevs[b] > 0.0) ? cov / (stddevs[a] * stddevs[b]) : 0.0;
-            result[a][b] = result[b][a] = corr;
+        for (size_t b = 0; b < m; ++b) {
+            result[a][b] = correlation(static_cast<Eigen::Index>(a), static_cast<Eigen::Index>(b));
         }
     }
     return result;
 }
 
+Eigen::MatrixXd correlationMatrix(const ts::TimeSeriesPanel& panel, Shrinkage shrinkage) {
+    return correlationFrom(sampleMoments(panel.asEigenMatrix(), shrinkage));
+}
+
 }  // namespace finapp::stats
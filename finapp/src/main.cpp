@@ -368,11 +368,13 @@ int main() {
     std::println("PredictionDistribution: {}", ts::models::PredictionDistribution{.mean = 0.00042, .variance = 1.2e-5});
     std::println("MonteCarloSpec        : {}",
                  ts::simulation::MonteCarloSpecification{.paths = 10'000, .steps = 3'935, .seed = 0xC0FFEE});
-    // Built literally: jarqueBera/adf/breuschPagan/breuschGodfrey are declared in StatsCore.hpp
-    // but have no definition, so calling one is a link error.
+    // Built literally so both ends of the significance marker show; the NAV gets the real thing.
     using ts::analysis::hypothesisTesting::HypothesisTestResult;
     std::println("HypothesisTest (sig)  : {}", HypothesisTestResult{.statistic = 812.34, .p_value = 0.0000});
     std::println("HypothesisTest (n.s.) : {}", HypothesisTestResult{.statistic = 1.21, .p_value = 0.2713});
+    std::println("NAV Jarque-Bera       : {}", ts::analysis::hypothesisTesting::jarqueBera(nav->view()));
+    // The regression tests want a gap-free sample.
+    std::println("NAV ADF               : {}", ts::analysis::hypothesisTesting::adf(nav->dropInvalid().getValues()));
 
     // The regularity verdict on its own never said *how* irregular, which is the number that
     // decides between resampling the data and raising the tolerance.
@@ -510,7 +512,7 @@ int main() {
             double priceMaxDrawdown;
         };
 
-        const ts::Timestamps& grid;
+        const ts::TimestampGrid& grid;
         const ts::Timestamps& contributions;
         AssetId asset;
         Currency base;
@@ -525,7 +527,7 @@ int main() {
         double price;
         std::size_t contributionIndex = 0;
 
-        ContributionPath(const ts::Timestamps& gridIn, const ts::Timestamps& contributionsIn, AssetId assetIn,
+        ContributionPath(const ts::TimestampGrid& gridIn, const ts::Timestamps& contributionsIn, AssetId assetIn,
                          Currency baseIn, double spot, double driftIn, double volIn, double initialInvest,
                          double monthlyContributionIn)
             : grid(gridIn),
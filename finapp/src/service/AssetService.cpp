@@ -2,10 +2,13 @@
 
 #include "finapp/service/AssetService.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "finapp/common/Error.hpp"
 #include "finapp/common/Log.hpp"
@@ -16,6 +19,7 @@
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/utils/TimeSeriesUtils.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/services/TimeSeriesService.hpp"
 
 using ts::TimeSeriesService;
@@ -134,15 +138,46 @@ TimeSeries AssetService::loadTimeSeriesValue(const AssetId& assetId, TimestampsP
     return timeSeriesService_->getFilled(seriesId, std::move(timestamps), InterpolationStrategy::Latest);
 }
 
+ts::TimeSeriesPanel AssetService::loadTimeSeriesValues(const std::vector<AssetId>& assetIds, TimestampsPtr timestamps) {
+    ensure<InvalidArgument>(timestamps != nullptr, "AssetService::loadTimeSeriesValues: timestamps pointer is null.");
+
+    std::vector<std::string> tickers;
+    std::vector<std::string> seriesIds;
+    std::vector<size_t> pricedColumns;
+    tickers.reserve(assetIds.size());
+    for (size_t j = 0; j < assetIds.size(); ++j) {
+        tickers.push_back(assetIds[j].ticker);
+        if (assetIds[j].type == AssetType::Cash) continue;
+        std::string seriesId = load(assetIds[j])->priceSeriesId();
+        if (seriesId.empty()) continue;
+        seriesIds.push_back(std::move(seriesId));
+        pricedColumns.push_back(j);
+    }
+
+    // Cash and unpriced assets keep the constant 1.0 the single-asset overload gives them.
+    const size_t rows = timestamps->size();
+    std::vector<double> block(rows * assetIds.size(), 1.0);
+    if (!seriesIds.empty()) {
+        // Latest (look-back only), as in loadTimeSeriesValue.
+        const ts::TimeSeriesPanel priced =
+            timeSeriesService_->getFilledMany(seriesIds, timestamps, InterpolationStrategy::Latest);
+        for (size_t k = 0; k < pricedColumns.size(); ++k) {
+            std::ranges::copy(priced.column(k), block.begin() + static_cast<std::ptrdiff_t>(pricedColumns[k] * rows));
+        }
+    }
+    return ts::TimeSeriesPanel(std::move(timestamps), std::move(tickers), std::move(block));
+}
+
 TimestampsPtr AssetService::rawTicks(const AssetId& assetId, Timestamp startMs, Timestamp endMs) {
     // Cash and unpriced assets have no market observations — they contribute no ticks to a grid.
-    if (assetId.type == AssetType::Cash) return std::make_shared<std::vector<Timestamp>>();
+    if (assetId.type == AssetType::Cash) return std::make_shared<const ts::TimestampGrid>();
     auto asset = load(assetId);
     const std::string seriesId = asset->priceSeriesId();
-    if (seriesId.empty()) return std::make_shared<std::vector<Timestamp>>();
+    if (seriesId.empty()) return std::make_shared<const ts::TimestampGrid>();
     const TimeSeries raw = timeSeriesService_->getRaw(seriesId, startMs, endMs);
     const auto span = raw.getTimestamps();
-    return std::make_shared<std::vector<Timestamp>>(span.begin(), span.end());
+    // Interned: the same ticks requested twice come back as the same grid object.
+    return ts::TimestampGrid::intern(std::make_shared<const ts::TimestampGrid>(ts::Timestamps(span.begin(), span.end())));
 }
 
 double AssetService::loadValueAtTs(const finance::AssetId& assetId, const Timestamp& timestamp) {
@@ -3,8 +3,11 @@
 #include "finapp/service/FXService.hpp"
 
 #include <memory>
+#include <algorithm>
+#include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "finapp/common/Error.hpp"
 #include "finapp/common/Log.hpp"
@@ -13,6 +16,7 @@
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/utils/TimeSeriesUtils.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/services/TimeSeriesService.hpp"
 
 namespace finapp {
@@ -52,13 +56,43 @@ TimeSeries FXService::load(const Currency& baseCurrency, const Currency& quoteCu
     return timeSeriesService_->getFilled(seriesId, std::move(timestamps), InterpolationStrategy::Latest);
 }
 
+ts::TimeSeriesPanel FXService::load(const std::vector<Currency>& baseCurrencies, const Currency& quoteCurrency,
+                                    TimestampsPtr timestamps) {
+    ensure<InvalidArgument>(timestamps != nullptr, "FXService::load: timestamps pointer is null.");
+
+    std::vector<std::string> pairIds;
+    std::vector<std::string> seriesIds;
+    std::vector<size_t> quotedColumns;
+    pairIds.reserve(baseCurrencies.size());
+    for (size_t j = 0; j < baseCurrencies.size(); ++j) {
+        pairIds.push_back(makePairId_(baseCurrencies[j], quoteCurrency));
+        if (baseCurrencies[j] == quoteCurrency) continue;
+        seriesIds.push_back(resolveSeriesId_(baseCurrencies[j], quoteCurrency));
+        quotedColumns.push_back(j);
+    }
+
+    // Same-currency pairs keep the constant 1.0 rate.
+    const size_t rows = timestamps->size();
+    std::vector<double> block(rows * baseCurrencies.size(), 1.0);
+    if (!seriesIds.empty()) {
+        // Latest (look-back only), as in the single-pair overload.
+        const ts::TimeSeriesPanel quoted =
+            timeSeriesService_->getFilledMany(seriesIds, timestamps, InterpolationStrategy::Latest);
+        for (size_t k = 0; k < quotedColumns.size(); ++k) {
+            std::ranges::copy(quoted.column(k), block.begin() + static_cast<std::ptrdiff_t>(quotedColumns[k] * rows));
+        }
+    }
+    return ts::TimeSeriesPanel(std::move(timestamps), std::move(pairIds), std::move(block));
+}
+
 TimestampsPtr FXService::rawTicks(const Currency& baseCurrency, const Currency& quoteCurrency, Timestamp startMs,
                                   Timestamp endMs) {
-    if (baseCurrency == quoteCurrency) return std::make_shared<std::vector<Timestamp>>();
+    if (baseCurrency == quoteCurrency) return std::make_shared<const ts::TimestampGrid>();
     const std::string seriesId = resolveSeriesId_(baseCurrency, quoteCurrency);
     const TimeSeries raw = timeSeriesService_->getRaw(seriesId, startMs, endMs);
     const auto span = raw.getTimestamps();
-    return std::make_shared<std::vector<Timestamp>>(span.begin(), span.end());
+    // Interned: the same ticks requested twice come back as the same grid object.
+    return ts::TimestampGrid::intern(std::make_shared<const ts::TimestampGrid>(ts::Timestamps(span.begin(), span.end())));
 }
 double FXService::loadSingleFxAtTs(const Currency& baseCurrency, const Currency& quoteCurrency, Timestamp ts) {
     if (baseCurrency == quoteCurrency) {
@@ -28,6 +28,8 @@
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/utils/TimeSeriesUtils.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesExpression.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 
 namespace finapp {
 
@@ -172,7 +174,7 @@ void PortfolioService::save(const Portfolio& portfolio, Timestamp timestampMs) {
 TimestampsPtr PortfolioService::grid(const std::string& portfolioId, Timestamp startMs, Timestamp endMs,
                                      finance::GridMode mode) {
     auto snapshots = portfolioRepository_->loadSnapshotsCovering(portfolioId, startMs, endMs);
-    if (snapshots.empty()) return std::make_shared<std::vector<Timestamp>>();
+    if (snapshots.empty()) return std::make_shared<const ts::TimestampGrid>();
     const Currency base = snapshots.front().baseCurrency;
 
     std::unordered_set<AssetId> uniqueAssetIds;
@@ -196,13 +198,52 @@ TimestampsPtr PortfolioService::grid(const std::string& portfolioId, Timestamp s
     // otherwise collapse an intersection to nothing.
     std::erase_if(grids, [](const TimestampsPtr& g) { return !g || g->empty(); });
 
-    return (mode == finance::GridMode::Union) ? finance::unionOf(grids) : finance::intersectionOf(grids);
+    // Interned so repeated valuations over the same constituents share one grid, and every
+    // series resampled onto it aligns by pointer.
+    return ts::TimestampGrid::intern((mode == finance::GridMode::Union) ? finance::unionOf(grids)
+                                                                        : finance::intersectionOf(grids));
 }
 
 // ---------------------------------------------------------------------------
 // Derived TimeSeries over a range
 // ---------------------------------------------------------------------------
-//
+
+void PortfolioService::loadPricesInBase_(const std::vector<PortfolioSnapshot>& snapshots, TimestampsPtr timestamps,
+                                         std::unordered_map<AssetId, TimeSeries>& priceInBase,
+                                         std::unordered_map<finance::Currency, TimeSeries>& fxCache) {
+    const Currency baseCurrency = snapshots.front().baseCurrency;
+
+    // Collect every asset and currency that appears in any snapshot.
+    std::unordered_set<AssetId> uniqueAssetIds;
+    std::unordered_set<Currency> uniqueCurrencies;
+
+    for (const PortfolioSnapshot& snap : snapshots) {
+        for (const SnapshotPosition& pos : snap.positions) uniqueAssetIds.insert(pos.assetId);
+        for (const auto& [c, _] : snap.cashBalances) uniqueCurrencies.insert(c);
+    }
+
+    // The denominations are folded in first so the FX batch covers them.
+    const std::vector<AssetId> assetIds(uniqueAssetIds.begin(), uniqueAssetIds.end());
+    for (const AssetId& aid : assetIds) uniqueCurrencies.insert(assetService_->load(aid)->denomination());
+    const std::vector<Currency> currencies(uniqueCurrencies.begin(), uniqueCurrencies.end());
+    const ts::TimeSeriesPanel fxRates = fxService_->load(currencies, baseCurrency, timestamps);
+    const ts::TimeSeriesPanel prices = assetService_->loadTimeSeriesValues(assetIds, timestamps);
+
+    fxCache.reserve(currencies.size());
+    for (size_t j = 0; j < currencies.size(); ++j) fxCache.emplace(currencies[j], fxRates.columnSeries(j));
+
+    priceInBase.reserve(assetIds.size());
+    for (size_t j = 0; j < assetIds.size(); ++j) {
+        const Currency assetDenom = assetService_->load(assetIds[j])->denomination();
+        TimeSeries price = prices.columnSeries(j);
+        if (assetDenom == baseCurrency) {
+            priceInBase.emplace(assetIds[j], std::move(price));
+        } else {
+            priceInBase.emplace(assetIds[j], ts::lazy(price) * fxCache.at(assetDenom));
+        }
+    }
+}
+
 // This computes both total value and weight series it do so by processing segment between transactions
 // via masks if the number of transactions grow need to change
 finance::PortfolioSeries PortfolioService::valueAndWeightSeries(const std::string& portfolioId,
@@ -219,39 +260,10 @@ finance::PortfolioSeries PortfolioService::valueAndWeightSeries(const std::strin
     });
     auto baseCurrency = snapshots.front().baseCurrency;
 
-    // Collect every asset and currency that appears in any snapshot.
-    std::unordered_set<AssetId> uniqueAssetIds;
-    std::unordered_set<Currency> uniqueCurrencies;
-
-    for (const PortfolioSnapshot& snap : snapshots) {
-        for (const SnapshotPosition& pos : snap.positions) uniqueAssetIds.insert(pos.assetId);
-        for (const auto& [c, _] : snap.cashBalances) uniqueCurrencies.insert(c);
-    }
-
     std::unordered_map<finance::Currency, TimeSeries> fxCache;
     std::unordered_map<AssetId, TimeSeries> priceInBase;
+    loadPricesInBase_(snapshots, timestamps, priceInBase, fxCache);
 
-    priceInBase.reserve(uniqueAssetIds.size() + uniqueCurrencies.size());
-    for (Currency c : uniqueCurrencies) {
-        fxCache[c] = (c != baseCurrency)
-                         ? fxService_->load(c, baseCurrency, timestamps)
-                         : ts::common::utils::timeSeries::generateConstantTimeSeries("fx", timestamps, 1.0);
-    }
-
-    for (const AssetId& aid : uniqueAssetIds) {
-        auto asset = assetService_->load(aid);
-        auto assetDenom = asset->denomination();
-        if (assetDenom == baseCurrency) {
-            priceInBase.emplace(aid, assetService_->loadTimeSeriesValue(aid, timestamps));
-        } else {
-            auto [iterator, notPreviouslyPresent] = uniqueCurrencies.insert(assetDenom);
-            if (notPreviouslyPresent) {
-                fxCache.emplace(assetDenom, fxService_->load(assetDenom, baseCurrency, timestamps));
-            }
-            auto price = assetService_->loadTimeSeriesValue(aid, timestamps) * fxCache.at(assetDenom);
-            priceInBase.emplace(aid, price);
-        }
-    }
     auto totalAccumulation =
         ts::common::utils::timeSeries::generateConstantTimeSeries(portfolioId + "_value", timestamps, 0.0);
     std::unordered_map<AssetId, TimeSeries> weightAccumulation;
@@ -262,14 +274,14 @@ finance::PortfolioSeries PortfolioService::valueAndWeightSeries(const std::strin
             Portfolio::Builder(portfolioId, snapshots[i].name, baseCurrency).fromSnapshot(snapshots[i]).build();
         auto segmentSeries = portfolioSegment.valueAndWeightSeries(timestamps, priceInBase, fxCache);
         auto mask = ts::common::utils::timeSeries::makeSegmentMask(timestamps, tsSnapshot, nextTs);
-        totalAccumulation += segmentSeries.total * mask;
+        totalAccumulation += ts::lazy(segmentSeries.total) * mask;
 
         for (const auto& [assetId, weightSeries] : segmentSeries.weights) {
             if (!weightAccumulation.contains(assetId)) {
                 weightAccumulation[assetId] =
                     ts::common::utils::timeSeries::generateConstantTimeSeries(assetId.ticker, timestamps, 0.0);
             }
-            weightAccumulation[assetId] += weightSeries * mask;
+            weightAccumulation[assetId] += ts::lazy(weightSeries) * mask;
         }
     }
 
@@ -315,19 +327,20 @@ std::unordered_map<AssetId, TimeSeries> PortfolioService::quantitySeries(const s
     }
 
     for (const PortfolioSnapshot& snap : snapshots) {
-        auto ts = std::lower_bound(timestamps->begin(), timestamps->end(), snap.timestampMs);
-        if (ts != timestamps->end()) {
+        const size_t idx = timestamps->lowerBound(snap.timestampMs);
+        if (idx < timestamps->size()) {
+            const Timestamp ts = (*timestamps)[idx];
             for (const auto& assetId : uniqueAssetIds) {
-                assetQuantities.at(assetId).push_back({*ts, 0.0});
+                assetQuantities.at(assetId).push_back({ts, 0.0});
             }
             for (const auto& currency : uniqueCurrencies) {
-                cashQuantities.at(currency).push_back({*ts, 0.0});
+                cashQuantities.at(currency).push_back({ts, 0.0});
             }
             for (const SnapshotPosition& pos : snap.positions) {
-                assetQuantities.at(pos.assetId).back() = {*ts, pos.quantity};
+                assetQuantities.at(pos.assetId).back() = {ts, pos.quantity};
             }
             for (const auto& [currency, balance] : snap.cashBalances) {
-                cashQuantities.at(currency).back() = {*ts, balance};
+                cashQuantities.at(currency).back() = {ts, balance};
             }
         } else {
             break;
@@ -367,39 +380,10 @@ TimeSeries PortfolioService::valueSeries(const std::string& portfolioId, Timesta
     });
     auto baseCurrency = snapshots.front().baseCurrency;
 
-    // Collect every asset and currency that appears in any snapshot.
-    std::unordered_set<AssetId> uniqueAssetIds;
-    std::unordered_set<Currency> uniqueCurrencies;
-
-    for (const PortfolioSnapshot& snap : snapshots) {
-        for (const SnapshotPosition& pos : snap.positions) uniqueAssetIds.insert(pos.assetId);
-        for (const auto& [c, _] : snap.cashBalances) uniqueCurrencies.insert(c);
-    }
-
     std::unordered_map<finance::Currency, TimeSeries> fxCache;
     std::unordered_map<AssetId, TimeSeries> priceInBase;
+    loadPricesInBase_(snapshots, timestamps, priceInBase, fxCache);
 
-    priceInBase.reserve(uniqueAssetIds.size() + uniqueCurrencies.size());
-    for (Currency c : uniqueCurrencies) {
-        fxCache[c] = (c != baseCurrency)
-                         ? fxService_->load(c, baseCurrency, timestamps)
-                         : ts::common::utils::timeSeries::generateConstantTimeSeries("fx", timestamps, 1.0);
-    }
-
-    for (const AssetId& aid : uniqueAssetIds) {
-        auto asset = assetService_->load(aid);
-        auto assetDenom = asset->denomination();
-        if (assetDenom == baseCurrency) {
-            priceInBase.emplace(aid, assetService_->loadTimeSeriesValue(aid, timestamps));
-        } else {
-            auto [iterator, notPreviouslyPresent] = uniqueCurrencies.insert(assetDenom);
-            if (notPreviouslyPresent) {
-                fxCache.emplace(assetDenom, fxService_->load(assetDenom, baseCurrency, timestamps));
-            }
-            auto price = assetService_->loadTimeSeriesValue(aid, timestamps) * fxCache.at(assetDenom);
-            priceInBase.emplace(aid, price);
-        }
-    }
     auto totalAccumulation =
         ts::common::utils::timeSeries::generateConstantTimeSeries(portfolioId + "_value", timestamps, 0.0);
 
@@ -410,7 +394,7 @@ TimeSeries PortfolioService::valueSeries(const std::string& portfolioId, Timesta
             Portfolio::Builder(portfolioId, snapshots[i].name, baseCurrency).fromSnapshot(snapshots[i]).build();
         auto segmentSeries = portfolioSegment.valueSeries(timestamps, priceInBase, fxCache);
         auto mask = ts::common::utils::timeSeries::makeSegmentMask(timestamps, tsSnapshot, nextTs);
-        totalAccumulation += segmentSeries * mask;
+        totalAccumulation += ts::lazy(segmentSeries) * mask;
     }
 
     return totalAccumulation;
@@ -28,7 +28,7 @@ std::shared_ptr<finance::analysis::PortfolioAnalysis> PortfolioAnalysisService::
 }
 
 std::shared_ptr<finance::analysis::PortfolioAnalysis> PortfolioAnalysisService::createPortfolioAnalysis(
-    const finance::Portfolio& portfolio, std::shared_ptr<std::vector<int64_t>> timestamps) {
+    const finance::Portfolio& portfolio, ts::TimestampsPtr timestamps) {
     logging::debug("createPortfolioAnalysis '{}' (custom grid) {} positions", portfolio.id(),
                    portfolio.positions().size());
     return assemble_(portfolio, buildAssetAnalyses_(portfolio, std::move(timestamps)));
@@ -47,7 +47,7 @@ std::vector<std::shared_ptr<finance::analysis::IAssetAnalysis>> PortfolioAnalysi
 }
 
 std::vector<std::shared_ptr<finance::analysis::IAssetAnalysis>> PortfolioAnalysisService::buildAssetAnalyses_(
-    const finance::Portfolio& portfolio, std::shared_ptr<std::vector<int64_t>> timestamps) {
+    const finance::Portfolio& portfolio, ts::TimestampsPtr timestamps) {
     std::vector<std::shared_ptr<finance::analysis::IAssetAnalysis>> result;
     result.reserve(portfolio.positions().size());
     // Shared_ptr copy each iteration — all sessions reference the same timestamp grid.
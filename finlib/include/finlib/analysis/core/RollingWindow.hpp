@@ -14,22 +14,34 @@
 
 namespace ts::simulation {
 
+// A fixed-length window of the most recent values, oldest first.
+//
+// The values are stored twice, back to back, and push() overwrites the oldest slot in both
+// copies before advancing the start: the current window is then always the contiguous run
+// [start_, start_ + n), so push() is O(1) instead of shifting every element, and get() still
+// hands out one contiguous vector.
 class RollingWindow {
-    Eigen::VectorXd w_;
+    Eigen::VectorXd buffer_;  // 2n values: the window, then the same window again
+    Eigen::Index start_ = 0;
 
  public:
     RollingWindow() = default;
-    explicit RollingWindow(const std::vector<double>& seed)
-        : w_(Eigen::Map<const Eigen::VectorXd>(seed.data(), static_cast<Eigen::Index>(seed.size()))) {}
+    explicit RollingWindow(const std::vector<double>& seed) : buffer_(2 * static_cast<Eigen::Index>(seed.size())) {
+        const auto n = static_cast<Eigen::Index>(seed.size());
+        const Eigen::Map<const Eigen::VectorXd> values(seed.data(), n);
+        buffer_.head(n) = values;
+        buffer_.tail(n) = values;
+    }
 
-    const Eigen::VectorXd& get() const { return w_; }
-    Eigen::Index size() const { return w_.size(); }
+    Eigen::Map<const Eigen::VectorXd> get() const { return {buffer_.data() + start_, size()}; }
+    Eigen::Index size() const { return buffer_.size() / 2; }
 
     void push(double x) {
-        const auto n = w_.size();
+        const auto n = size();
         if (n == 0) return;
-        if (n > 1) w_.head(n - 1) = w_.tail(n - 1).eval();  // .eval(): segments alias
-        w_(n - 1) = x;
+        buffer_(start_) = x;
+        buffer_(start_ + n) = x;
+        start_ = start_ + 1 == n ? 0 : start_ + 1;
     }
 };
 }  // namespace ts::simulation
@@ -45,7 +57,7 @@ struct std::formatter<ts::simulation::RollingWindow> {
 
     auto format(const ts::simulation::RollingWindow& window, std::format_context& ctx) const
         -> std::format_context::iterator {
-        const auto& values = window.get();
+        const auto values = window.get();
         const auto n = static_cast<std::size_t>(values.size());
         if (n == 0) return std::format_to(ctx.out(), "RollingWindow[empty]");
 
@@ -2,26 +2,41 @@
 #pragma once
 
 #include <cstddef>
-#include <limits>
 #include <vector>
 
 #include "finlib/analysis/seriesAnalysis/MetricHandle.hpp"
+#include "finlib/core/Ewma.hpp"
+#include "finlib/core/RollingStats.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
 
 namespace ts::analysis::metrics {
 
-inline MetricFn<std::vector<double>> movingAverage(size_t window) {
-    return [window](TimeSeriesView v) -> std::vector<double> {
-        const size_t n = v.size();
-        std::vector<double> result(n, std::numeric_limits<double>::quiet_NaN());
-        double sum = 0.0;
-        for (size_t i = 0; i < n; ++i) {
-            sum += v[i];
-            if (i >= window) sum -= v[i - window];
-            if (i + 1 >= window) result[i] = sum / static_cast<double>(window);
-        }
-        return result;
+// Full-length trailing-window series for CustomTimeSeriesAnalysis::addMetric: one value per row
+// of the view, NaN until the first window fills (see stats::rolling for the exact rules). The
+// view's validity mask is honoured, so rows flagged missing are skipped rather than read.
+inline MetricFn<std::vector<double>> rolling(stats::RollingStatistic stat, size_t window,
+                                             stats::VarianceType type = stats::VarianceType::Sample) {
+    return [stat, window, type](TimeSeriesView v) -> std::vector<double> {
+        return stats::rolling(v, v.validity(), window, stat, type);
+    };
+}
+
+inline MetricFn<std::vector<double>> rollingQuantile(size_t window, double q) {
+    return [window, q](TimeSeriesView v) -> std::vector<double> {
+        return stats::rollingQuantile(v, v.validity(), window, q);
+    };
+}
+
+// Exponentially weighted counterpart: row i holds the statistic after rows 0..i (see stats::ewma).
+inline MetricFn<std::vector<double>> ewma(stats::EwmaStatistic stat, stats::EwmaParameters params) {
+    params.validate();
+    return [stat, params](TimeSeriesView v) -> std::vector<double> {
+        return stats::ewma(v, v.validity(), params, stat);
     };
 }
 
+inline MetricFn<std::vector<double>> movingAverage(size_t window) {
+    return rolling(stats::RollingStatistic::Mean, window);
+}
+
 }  // namespace ts::analysis::metrics
@@ -5,12 +5,14 @@
 #include <cstddef>
 #include <format>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "Eigen/Core"
 #include "finlib/common/Format.hpp"
 #include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TDigest.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
 
 namespace ts::analysis {
@@ -30,13 +32,35 @@ class TimeSeriesAnalysis {
     std::optional<double> skewness() const;
     std::optional<double> kurtosis() const;
 
+    // The cached one-pass accumulator behind the statistics above. It merges with other
+    // accumulators, so per-window results can be folded into one for the whole range.
+    const stats::Moments& moments() const;
+
+    // Quantiles and CDF of the window's present values, read off a TDigest built in one pass on
+    // first use and cached: bounded memory and no sorted copy of the window, at the error
+    // documented on TDigest. quantile() throws InvalidArgument on an empty window.
+    double quantile(double q) const;
+    double cdf(double x) const;
+    const stats::TDigest& quantileSketch() const;
+
     // Number of observations backing this analysis (0 when the view is empty).
     size_t size() const { return view_.size(); }
 
+    // The lag caches only ever grow: asking for more lags computes just the missing ones, and
+    // asking for fewer reads what is cached. The results are copies of the first max_lag + 1
+    // cached values, so they stay valid whatever is asked next. Fewer come back when the window
+    // is too short to define them.
     double autocorrelation(size_t lag) const;
-    const std::vector<double>& acf(size_t max_lag) const;
-    const std::vector<double>& autocovariances(size_t max_lag) const;
-
+    std::vector<double> acf(size_t max_lag) const;
+    std::vector<double> autocovariances(size_t max_lag) const;
+    // Durbin-Levinson over the cached autocovariances: every partial autocorrelation and every
+    // AR(k) predictor up to max_lag from one O(max_lag^2) recursion. The innovation variances
+    // are per observation, so they compare directly across orders (AIC, BIC, ...).
+    stats::DurbinLevinson durbinLevinson(size_t max_lag) const;
+    std::vector<double> pacf(size_t max_lag) const;
+
+    // max_lag x max_lag, grown from the cached autocovariances by filling in only the new
+    // rows and columns.
     Eigen::MatrixXd toeplitz(size_t max_lag);
     double zScore(double value) const;
     bool isOutlier(double value, double threshold = 3.0) const;
@@ -57,14 +81,18 @@ class TimeSeriesAnalysis {
  private:
     TimeSeriesView view_;
 
-    mutable std::optional<double> cachedMean_;
-    mutable std::optional<double> cachedVarianceSample_;
-    mutable std::optional<double> cachedVariancePopulation_;
-    mutable std::optional<double> cachedSkewness_;
-    mutable std::optional<double> cachedKurtosis_;
-    mutable std::optional<std::vector<double>> cachedACF_;
-    mutable std::optional<std::vector<double>> cachedAutocovariances_;
-    mutable std::optional<Eigen::MatrixXd> cachedToeplitz_;
+    // mean, both variances, skewness, kurtosis and the describe() extrema all come from this
+    // one pass over the window.
+    mutable std::optional<stats::Moments> cachedMoments_;
+    mutable std::optional<stats::TDigest> cachedSketch_;
+    mutable std::vector<double> cachedACF_;
+    mutable std::vector<double> cachedAutocovariances_;
+    Eigen::MatrixXd cachedToeplitz_;
+
+    // The caches grown to max_lag, as slices of them: for use within one call only, since the
+    // next extension may move the storage.
+    std::span<const double> acf_(size_t max_lag) const;
+    std::span<const double> autocovariances_(size_t max_lag) const;
 };
 
 }  // namespace ts::analysis
@@ -5,6 +5,7 @@
 #include <format>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <print>
 #include <string>
 #include <unordered_map>
@@ -58,6 +59,12 @@ class ITimeSeriesSession {
     // install transforms without knowing the concrete session type (single vs multi).
     virtual void addTransform(std::string name, std::vector<std::string> inputs, SeriesTransform transform) = 0;
 
+    // Per-request memory: while a resource is installed (typically a memory::RequestArena), the
+    // derived series this session builds are allocated from it. Installing one — or nullptr, for
+    // the default heap — first drops everything built on the previous resource, so the owner may
+    // release an arena as soon as it has been swapped out.
+    virtual void setMemoryResource(std::pmr::memory_resource* resource) = 0;
+
     // Display. Virtual so a MultiTimeSeriesSession can summarise its sub-nodes without
     // knowing whether each is a single or another multi.
     //
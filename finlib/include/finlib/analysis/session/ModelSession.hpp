@@ -17,6 +17,8 @@
 #include "finlib/common/Error.hpp"
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/Format.hpp"
+#include "finlib/core/Ewma.hpp"
+#include "finlib/core/SegmentedTimeSeries.hpp"
 #include "finlib/core/TimeSeries.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
 
@@ -36,8 +38,14 @@ class ModelSession {
     };
 
     std::deque<PredictionEntry> predictionContainer_;
-    std::vector<std::pair<Timestamp, double>> writeBuffer_;
+    // Observed actuals waiting for flush_(), held the way the repository's append path takes
+    // them; one block is big enough for a whole batch, so filling it never reallocates.
     size_t writeBufferCapacity_ = 100;
+    SegmentedTimeSeries writeBuffer_;
+    // Batches closed early because a repeated or earlier timestamp arrived, oldest first, still
+    // waiting to be saved. flush_() sends them in order ahead of writeBuffer_, so a failed save
+    // keeps them for the next attempt and the newer value still wins the repository's merge.
+    std::deque<SegmentedTimeSeries> sealedBatches_;
 
     // Running Error Tracking
     size_t errorTrackingWindowSize_;
@@ -45,6 +53,11 @@ class ModelSession {
     double runningSumAbsoluteError_ = 0.0;
     size_t observationCount_ = 0;
 
+    // Exponentially weighted tracking, off until trackEwma(): the observed values, and the
+    // forecast errors around zero (so its variance is an EWMA of the squared error).
+    std::optional<analysis::stats::EwmaMoments> observedEwma_;
+    std::optional<analysis::stats::EwmaMoments> errorEwma_;
+
     Timestamp lastActualTimeStamp_;
     Timestamp deltaT_;
     double deltaTTolerance_;
@@ -53,11 +66,11 @@ class ModelSession {
     ModelSession(AppContext& context, std::shared_ptr<models::IRegressionModel> model, const TimeSeriesView& view,
                  size_t errorTrackingWindowSize, Timestamp deltaT, double deltaTTolerance)
         : context_(context),
-          model_(std::move(model)),
+          model_(fitted_(std::move(model))),
+          writeBuffer_(model_->getViewTimeSeriesId(), writeBufferCapacity_ + 1),
           errorTrackingWindowSize_(errorTrackingWindowSize),
           deltaT_(deltaT),
           deltaTTolerance_(deltaTTolerance) {
-        ensure(model_->isFitted(), "Model used for session not Fitted");
         size_t viewLength = view.size();
         ensure(viewLength >= 1, "View passed in model session cannot be empty");
         windowSize_ = model_->contextSize();
@@ -76,6 +89,13 @@ class ModelSession {
     double rollingMAE(size_t lastN) const;
     bool shouldRefit(double mseTreshold) const;
 
+    // Starts (or restarts) EWMA tracking from the next observe(); each observation then costs
+    // O(1) on top of the rolling error bookkeeping. errorEwma() ignores params.demean: errors are
+    // always taken around zero.
+    void trackEwma(analysis::stats::EwmaParameters params);
+    const std::optional<analysis::stats::EwmaMoments>& observedEwma() const { return observedEwma_; }
+    const std::optional<analysis::stats::EwmaMoments>& errorEwma() const { return errorEwma_; }
+
     void refit(const TimeSeriesView& newView);
 
     // Display — running error, how much of the prediction buffer has been matched against
@@ -87,6 +107,11 @@ class ModelSession {
     // Helper
     size_t nextToFill_ = 0;
     void flush_();
+    // Checked before any member reads the model (the write buffer is named after its series).
+    static std::shared_ptr<models::IRegressionModel> fitted_(std::shared_ptr<models::IRegressionModel> model) {
+        ensure(model->isFitted(), "Model used for session not Fitted");
+        return model;
+    }
 };
 }  // namespace ts
 
@@ -4,6 +4,7 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -47,6 +48,8 @@ class MultiTimeSeriesSession : public ITimeSeriesSession {
 
     void setRange(Timestamp startMs, Timestamp endMs) override;
     void setFrequency(Timestamp freqMs) override;
+    // Installs the resource on every sub-session as well as on the cross-transform caches.
+    void setMemoryResource(std::pmr::memory_resource* resource) override;
 
     // Sub-session registration — accepts any ITimeSeriesSession (TimeSeriesSession or another Multi)
     void addSession(std::string name, std::shared_ptr<ITimeSeriesSession> session);
@@ -83,6 +86,7 @@ class MultiTimeSeriesSession : public ITimeSeriesSession {
     mutable std::unordered_map<std::string, std::optional<TimeSeriesAnalysis>> crossAnalysisCache_;
 
     std::unordered_map<std::string, std::optional<CustomTimeSeriesAnalysis>> crossCustomAnalysisCache_;
+    std::pmr::memory_resource* resource_ = nullptr;  // null = whatever the caller has installed
 
 
     std::unordered_map<std::string, std::shared_ptr<const TimeSeries>> buildAligned_(const std::string& name) const;
@@ -0,0 +1,57 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "finlib/analysis/session/TimeSeriesSession.hpp"
+#include "finlib/core/RollingStats.hpp"
+#include "finlib/core/TimeSeries.hpp"
+
+namespace ts::analysis::transforms {
+
+namespace detail {
+// Same grid and offset as the input, so the result lines up with it row for row. The NaN rows
+// (warm-up, windows with nothing valid) are flagged missing, so the session's analyses skip them.
+inline TimeSeries rollingSeries(const TimeSeries& series, std::string id, std::vector<double> values) {
+    TimeSeries result(std::move(id), series.getSharedTimestamps(), series.tsOffset(), std::move(values));
+    result.markMissing();
+    return result;
+}
+}  // namespace detail
+
+// Trailing-window statistics as session transforms (see stats::rolling). For the source series:
+//     session.addTransform("vol20", transforms::rolling(stats::RollingStatistic::StandardDeviation, 20));
+// and for a derived one, through applyTo:
+//     session.addTransform("vol20", {"logReturn"}, transforms::applyTo("logReturn", transforms::rolling(...)));
+inline DerivedTransform rolling(stats::RollingStatistic stat, size_t window,
+                                stats::VarianceType type = stats::VarianceType::Sample) {
+    return [stat, window, type](const TimeSeries& series) {
+        return detail::rollingSeries(series,
+                                     std::format("Rolling{}{}_{}", stat, window, series.getId()),
+                                     stats::rolling(series.getValues(), series.validity(), window, stat, type));
+    };
+}
+
+inline DerivedTransform rollingQuantile(size_t window, double q) {
+    return [window, q](const TimeSeries& series) {
+        return detail::rollingSeries(series,
+                                     std::format("RollingQuantile{}_{}_{}", window, q, series.getId()),
+                                     stats::rollingQuantile(series.getValues(), series.validity(), window, q));
+    };
+}
+
+// Lifts a one-series transform onto a named input of a multi-input node.
+inline ComputeTransform applyTo(std::string input, DerivedTransform transform) {
+    return [input = std::move(input),
+            transform = std::move(transform)](std::unordered_map<std::string, std::shared_ptr<const TimeSeries>> map) {
+        return transform(*map.at(input));
+    };
+}
+
+}  // namespace ts::analysis::transforms
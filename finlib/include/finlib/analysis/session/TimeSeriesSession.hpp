@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -44,6 +45,9 @@ class TimeSeriesSession : public ITimeSeriesSession {
     void setRange(Timestamp newStartMs, Timestamp newEndMs) override;
     void setFrequency(Timestamp newFrequencyMs) override;
 
+    void setMemoryResource(std::pmr::memory_resource* resource) override;
+    std::pmr::memory_resource* memoryResource() const { return resource_; }
+
     // Named derived transforms
     void addTransform(std::string name, DerivedTransform transform);
     void addTransform(std::string name, std::vector<std::string> inputs, ComputeTransform transform) override;
@@ -89,6 +93,7 @@ class TimeSeriesSession : public ITimeSeriesSession {
     Timestamp startMs_;
     Timestamp endMs_;
     std::optional<Timestamp> frequencyMs_;
+    std::pmr::memory_resource* resource_ = nullptr;  // null = whatever the caller has installed
 
     std::optional<TimeSeriesAnalysis> sourceAnalysis_;
 
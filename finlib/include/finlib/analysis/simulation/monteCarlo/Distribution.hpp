@@ -4,21 +4,34 @@
 #include <cstddef>
 #include <format>
 #include <functional>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "finlib/common/Format.hpp"
+#include "finlib/core/Moments.hpp"
 #include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TDigest.hpp"
 
 namespace ts::simulation {
 
+// An empirical distribution, held one of two ways:
+//   exact    — every sample, sorted once at construction (8 bytes per sample plus the sort);
+//   sketched — a TDigest plus the fused Moments, O(compression) memory whatever the sample
+//              count. quantile/cdf are then TDigest estimates (see TDigest for the error
+//              bounds); count, mean, stddev, min and max stay exact. samples() is empty.
+// runSketched() in MonteCarloEngine builds the second kind without ever storing a path result.
 class Distribution {
     std::vector<double> sorted_;
+    std::optional<analysis::stats::TDigest> sketch_;
+    analysis::stats::Moments moments_;  // sketched only
     std::string id_;
 
  public:
     explicit Distribution(std::string id, std::vector<double> v);
+    // `moments` must summarise the same samples as `sketch`.
+    Distribution(std::string id, analysis::stats::TDigest sketch, analysis::stats::Moments moments);
 
     template <class R, class Proj>
     static Distribution from(std::string id, const std::vector<R>& rs, Proj proj) {
@@ -28,8 +41,10 @@ class Distribution {
         return Distribution(std::move(id), std::move(v));
     }
 
-    std::size_t size() const noexcept { return sorted_.size(); }
-    bool empty() const noexcept { return sorted_.empty(); }
+    std::size_t size() const noexcept { return sketch_ ? sketch_->count() : sorted_.size(); }
+    bool empty() const noexcept { return size() == 0; }
+    bool isSketched() const noexcept { return sketch_.has_value(); }
+    // The sorted samples; empty for a sketched distribution.
     analysis::stats::Samples samples() const noexcept { return sorted_; }
 
     double quantile(double q) const;
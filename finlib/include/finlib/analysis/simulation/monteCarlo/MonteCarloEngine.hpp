@@ -1,13 +1,22 @@
 // Copyright (c) 2026 JBBLET. All Rights Reserved.
 
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <format>
+#include <functional>
+#include <numeric>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "finlib/analysis/simulation/monteCarlo/Distribution.hpp"
+#include "finlib/common/Execution.hpp"
 #include "finlib/common/Random.hpp"
+#include "finlib/core/Moments.hpp"
+#include "finlib/core/TDigest.hpp"
 
 namespace ts::simulation {
 
@@ -25,23 +34,67 @@ concept PathSimulation = requires(P p, std::size_t t, Rng& g) {
     p.result();    // whatever the caller wants collected
 };
 
+namespace detail {
+// Path p on its own RNG stream, so its result does not depend on which thread ran it or when.
+template <class MakePath>
+auto simulatePath(const MonteCarloSpecification& spec, MakePath& makePath, std::size_t p) {
+    using Path = decltype(makePath(std::size_t{}));
+    static_assert(PathSimulation<Path>, "makePath must return a type with step(size_t, Rng&) and result()");
+    Rng rng = rngForStream(spec.seed, RngDomain::Simulation, p);
+    auto path = makePath(p);
+    for (std::size_t t = 1; t <= spec.steps; ++t) path.step(t, rng);
+    return path.result();
+}
+}  // namespace detail
+
 template <class MakePath>
 auto run(const MonteCarloSpecification& spec, MakePath makePath)
     -> std::vector<decltype(makePath(std::size_t{}).result())> {
-    using Path = decltype(makePath(std::size_t{}));
     using Result = decltype(makePath(std::size_t{}).result());
-    static_assert(PathSimulation<Path>, "makePath must return a type with step(size_t, Rng&) and result()");
 
     std::vector<Result> out;
     out.reserve(spec.paths);
-    for (std::size_t p = 0; p < spec.paths; ++p) {
-        Rng rng = rngForStream(spec.seed, RngDomain::Simulation, p);
-        auto path = makePath(p);
-        for (std::size_t t = 1; t <= spec.steps; ++t) path.step(t, rng);
-        out.push_back(path.result());
-    }
+    for (std::size_t p = 0; p < spec.paths; ++p) out.push_back(detail::simulatePath(spec, makePath, p));
     return out;
 }
+
+// Paths per work item in runSketched. Fixed, so the chunk boundaries depend on spec.paths only.
+inline constexpr std::size_t kSketchChunkPaths = 4096;
+
+// Like run(), but nothing per path is kept: proj(result) feeds a TDigest and a Moments per chunk
+// of kSketchChunkPaths paths, so memory is O(compression) however many paths run. Chunks run in
+// parallel and their partials fold in chunk order, which makes the Distribution identical for
+// any thread count. Because of that parallelism, makePath and the paths it builds must not
+// share mutable state (each path already owns its RNG stream).
+template <class MakePath, class Proj>
+Distribution runSketched(std::string id, const MonteCarloSpecification& spec, MakePath makePath, Proj proj,
+                         double compression = analysis::stats::TDigest::kDefaultCompression) {
+    struct Partial {
+        analysis::stats::TDigest sketch;
+        analysis::stats::Moments moments;
+    };
+    const std::size_t chunks = (spec.paths + kSketchChunkPaths - 1) / kSketchChunkPaths;
+    std::vector<Partial> partials(chunks, Partial{analysis::stats::TDigest(compression), {}});
+    std::vector<std::size_t> ordinals(chunks);
+    std::iota(ordinals.begin(), ordinals.end(), std::size_t{0});
+    std::for_each(kParallelPolicy, ordinals.begin(), ordinals.end(), [&](std::size_t c) {
+        const std::size_t end = std::min(spec.paths, (c + 1) * kSketchChunkPaths);
+        for (std::size_t p = c * kSketchChunkPaths; p < end; ++p) {
+            const auto value = static_cast<double>(std::invoke(proj, detail::simulatePath(spec, makePath, p)));
+            if (!std::isfinite(value)) continue;  // the sketch would skip it; keep the moments in step
+            partials[c].sketch.add(value);
+            partials[c].moments.push(value);
+        }
+    });
+
+    analysis::stats::TDigest sketch(compression);
+    analysis::stats::Moments moments;
+    for (const Partial& partial : partials) {
+        sketch.merge(partial.sketch);
+        moments.merge(partial.moments);
+    }
+    return Distribution(std::move(id), std::move(sketch), moments);
+}
 }  // namespace ts::simulation
 
 // The seed is printed in hex because that is how seeds are written down, and a run is only
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "finlib/common/Format.hpp"
+#include "finlib/core/Moments.hpp"
 
 namespace ts::simulation {
 
@@ -23,19 +24,11 @@ namespace ts::simulation {
 // All of these are plain structs on purpose — no virtuals, no allocation, fully inlinable inside the
 // inner loop, and trivially copyable so one per path is free.
 
-// Running mean and variance in a single pass, numerically stable (Welford).
-struct Welford {
-    std::size_t count = 0;
-    double mean = 0.0;
-    double m2 = 0.0;  // sum of squared deviations from the running mean
-
-    void push(double x) {
-        ++count;
-        const double delta = x - mean;
-        mean += delta / static_cast<double>(count);
-        m2 += delta * (x - mean);
-    }
-
+// Running mean and variance in a single pass, numerically stable (Welford). It is the library's
+// stats::Moments accumulator — so it also tracks the higher moments and extrema — and per-path or
+// per-thread partials fold together with merge() exactly as the series statistics do.
+struct Welford : analysis::stats::Moments {
+    // Lenient on purpose: a path that has not produced enough points reads as 0, not an error.
     double populationVariance() const { return count == 0 ? 0.0 : m2 / static_cast<double>(count); }
     double sampleVariance() const { return count < 2 ? 0.0 : m2 / static_cast<double>(count - 1); }
 };
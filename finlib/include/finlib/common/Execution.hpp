@@ -0,0 +1,16 @@
+// "Copyright (c) 2026 JBBLET All Rights Reserved."
+#pragma once
+#include <execution>
+
+namespace ts {
+
+// The policy finlib's parallel algorithms run under. Under libstdc++ std::execution::par needs
+// oneTBB, so the build only defines FINLIB_PARALLEL when it links TBB; without it (the
+// FINLIB_PARALLEL option off, or no TBB found) the same loops run in sequence.
+#if defined(FINLIB_PARALLEL) && FINLIB_PARALLEL
+inline constexpr auto kParallelPolicy = std::execution::par;
+#else
+inline constexpr auto kParallelPolicy = std::execution::seq;
+#endif
+
+}  // namespace ts
@@ -1,11 +1,18 @@
 // Copyright (c) 2026 JBBLET. All Rights Reserved.
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 namespace ts {
 using Timestamp = int64_t;
 using Timestamps = std::vector<Timestamp>;
-using TimestampsPtr = std::shared_ptr<const Timestamps>;
+
+class TimestampGrid;
+using TimestampsPtr = std::shared_ptr<const TimestampGrid>;
 
 }  // namespace ts
+
+// Anything that holds a TimestampsPtr also dereferences it; pull the definition in here so
+// this header stays the one include for the timestamp types.
+#include "finlib/common/TimestampGrid.hpp"
@@ -0,0 +1,57 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace ts::memory {
+
+// The resource new series values are allocated from on this thread. Defaults to
+// std::pmr::get_default_resource() (plain new/delete) until a ScopedResource installs another.
+//
+// Only producers that build fresh value buffers (arithmetic, resampling, view and expression
+// results) read it; series built from a caller's std::vector keep that vector's storage.
+std::pmr::memory_resource* currentResource() noexcept;
+
+// Installs a resource for the current thread until destroyed, then restores the previous one.
+// Scopes nest. Everything allocated inside must be dropped before the resource goes away —
+// a series that outlives its arena dangles.
+class ScopedResource {
+ public:
+    explicit ScopedResource(std::pmr::memory_resource* resource) noexcept;
+    ~ScopedResource();
+
+    ScopedResource(const ScopedResource&) = delete;
+    ScopedResource& operator=(const ScopedResource&) = delete;
+
+ private:
+    std::pmr::memory_resource* previous_;
+};
+
+// A monotonic arena for one analysis request: allocations are a pointer bump, deallocation is a
+// no-op, and release() hands every block back at once. Batch work creates and drops thousands of
+// short-lived temporaries; on the arena none of them reaches the global allocator individually.
+//
+// Not thread-safe: install it on the one thread serving the request.
+class RequestArena : public std::pmr::memory_resource {
+ public:
+    static constexpr size_t kDefaultInitialSize = 64 * 1024;
+
+    explicit RequestArena(size_t initialSize = kDefaultInitialSize,
+                          std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    // Frees every block; only call once nothing allocated here is still referenced.
+    void release();
+    // Bytes handed out since construction or the last release(), padding excluded.
+    size_t bytesAllocated() const { return bytesAllocated_; }
+
+ private:
+    std::pmr::monotonic_buffer_resource arena_;
+    size_t bytesAllocated_ = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+}  // namespace ts::memory
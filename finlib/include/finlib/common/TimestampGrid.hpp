@@ -0,0 +1,125 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "finlib/common/FinlibTypes.hpp"
+
+namespace ts {
+
+// The timestamp axis every TimeSeries, view and panel shares through a TimestampsPtr.
+//
+// A grid is either explicit (a sorted vector, as loaded from a provider or a CSV) or regular
+// (start, step, count) — the shape of every grid makeRegularTimestamps and getFilled build.
+// A regular grid stores three numbers instead of 8 bytes per point, and answers
+// operator[], lowerBound and upperBound arithmetically. The contiguous vector behind data(),
+// begin()/end() and span() is only built the first time someone asks for it, and then kept.
+//
+// The read interface mirrors const std::vector<Timestamp>, so code that used to hold
+// `const Timestamps&` keeps compiling; prefer the indexed accessors in hot paths so regular
+// grids are never materialised.
+class TimestampGrid {
+ public:
+    using value_type = Timestamp;
+    using size_type = size_t;
+    using const_iterator = const Timestamp*;
+    using iterator = const_iterator;
+
+    // Constructor
+    TimestampGrid() = default;
+    // Explicit grid; `timestamps` must be sorted ascending (not checked, same as before).
+    TimestampGrid(Timestamps timestamps);  // NOLINT(runtime/explicit): a vector is a grid
+    // Regular grid start, start + step, ..., start + (count - 1) * step. Throws
+    // InvalidArgument unless step > 0.
+    TimestampGrid(Timestamp start, Timestamp step, size_t count);
+
+    // Shared through TimestampsPtr and never copied: the lazily built vector is cached in place.
+    TimestampGrid(const TimestampGrid&) = delete;
+    TimestampGrid& operator=(const TimestampGrid&) = delete;
+
+    // Accessors — O(1) for both representations, never materialise.
+    size_t size() const { return regular_ ? count_ : points_.size(); }
+    bool empty() const { return size() == 0; }
+    Timestamp operator[](size_t i) const { return regular_ ? start_ + static_cast<Timestamp>(i) * step_ : points_[i]; }
+    Timestamp front() const { return (*this)[0]; }
+    Timestamp back() const { return (*this)[size() - 1]; }
+
+    bool isRegular() const { return regular_; }
+    // Regular grids only; 0 for an explicit grid.
+    Timestamp step() const { return regular_ ? step_ : 0; }
+    // The spacing of an evenly spaced grid, regular or explicit: step() for a regular grid; for an
+    // explicit one the common gap if every gap is equal and positive, else 0 (also for fewer than
+    // two points). Worked out in the fingerprint's pass, so it is free once that is cached.
+    Timestamp uniformStep() const;
+
+    // Index of the first timestamp >= ts (lowerBound) or > ts (upperBound) within
+    // [first, last), clamped to that range. Arithmetic on a regular grid, binary search otherwise.
+    size_t lowerBound(Timestamp ts, size_t first = 0, size_t last = npos) const;
+    size_t upperBound(Timestamp ts, size_t first = 0, size_t last = npos) const;
+
+    // True when [offset, offset + n) here and [otherOffset, otherOffset + n) in `other` hold the
+    // same timestamps. O(1) when both grids are regular, and an O(1) "no" for whole different
+    // grids once their fingerprints are computed; otherwise one indexed pass. Neither side is
+    // materialised.
+    bool matches(size_t offset, const TimestampGrid& other, size_t otherOffset, size_t n) const;
+
+    // 64-bit hash of the timestamps (not of the representation: a regular grid and the explicit
+    // grid of the same points agree). Computed on first use in one pass, then cached. Different
+    // fingerprints prove different content; equal ones are confirmed before anything relies on them.
+    uint64_t fingerprint() const;
+
+    // The canonical grid with the same timestamps as `grid`: the first one interned that is still
+    // alive, else `grid` itself, which becomes canonical. Interned equals are one shared object,
+    // so alignment checks between them stop at pointer equality. Process-wide and thread-safe;
+    // the table holds weak references, so interning never keeps a grid alive. O(1) for a
+    // regular grid; an explicit one pays its fingerprint once.
+    static TimestampsPtr intern(TimestampsPtr grid);
+    // intern() of the regular grid (start, step, count): identical requests share one grid.
+    static TimestampsPtr regular(Timestamp start, Timestamp step, size_t count) {
+        return intern(std::make_shared<const TimestampGrid>(start, step, count));
+    }
+
+    // Contiguous access. Materialises a regular grid on first use (thread-safe, once).
+    const Timestamp* data() const { return materialised_().data(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+    std::span<const Timestamp> span() const { return materialised_(); }
+    operator std::span<const Timestamp>() const { return span(); }  // NOLINT(runtime/explicit)
+
+    // False for a regular grid nobody has asked a span of yet.
+    bool isMaterialised() const { return !regular_ || materialisedFlag_.load(std::memory_order_acquire); }
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Element-wise, through operator[], so comparing never materialises either side.
+    friend bool operator==(const TimestampGrid& grid, const Timestamps& timestamps) {
+        if (grid.size() != timestamps.size()) return false;
+        for (size_t i = 0; i < timestamps.size(); ++i) {
+            if (grid[i] != timestamps[i]) return false;
+        }
+        return true;
+    }
+
+ private:
+    const Timestamps& materialised_() const;
+
+    bool regular_ = false;
+    Timestamp start_ = 0;
+    Timestamp step_ = 0;
+    size_t count_ = 0;
+    // The explicit timestamps, or — for a regular grid — the cache built by materialised_().
+    mutable Timestamps points_;
+    mutable std::once_flag materialiseOnce_;
+    mutable std::atomic<bool> materialisedFlag_{false};
+    mutable std::once_flag fingerprintOnce_;
+    mutable uint64_t fingerprint_ = 0;
+    mutable Timestamp uniformStep_ = 0;
+};
+
+}  // namespace ts
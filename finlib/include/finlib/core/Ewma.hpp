@@ -0,0 +1,176 @@
+// Copyright 2026 JBBLET
+#pragma once
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "finlib/core/StatsCore.hpp"
+#include "finlib/core/ValidityBitmap.hpp"
+
+namespace ts {
+class TimeSeriesView;
+class TimeSeriesPanel;
+}  // namespace ts
+
+namespace ts::analysis::stats {
+
+// How an exponentially weighted statistic forgets: the sample k steps old carries weight decay^k
+// relative to the newest. The weights are normalised by their running sum, so the first sample is
+// not shrunk towards zero the way a recursion seeded at 0 would shrink it.
+//
+// biasCorrected scales the demeaned variance/covariance by W² / (W² - ΣW²), the reliability-weights
+// correction that makes it unbiased (it reduces to n / (n - 1) when decay -> 1). demean = false
+// gives the RiskMetrics convention: second moments around zero rather than around the EWMA mean,
+// which are unbiased without correction, so biasCorrected is ignored there.
+struct EwmaParameters {
+    double decay;
+    bool biasCorrected = true;
+    bool demean = true;
+
+    // decay = 0.5^(1 / halfLife): a sample halfLife steps old weighs half the newest one.
+    static EwmaParameters fromHalfLife(double halfLife, bool biasCorrected = true, bool demean = true);
+    double halfLife() const { return std::log(0.5) / std::log(decay); }
+    // Throws InvalidArgument unless 0 < decay < 1.
+    void validate() const;
+};
+
+enum class EwmaStatistic { Mean, Variance, StandardDeviation };
+
+constexpr std::string_view toString(EwmaStatistic stat) {
+    switch (stat) {
+        case EwmaStatistic::Mean: return "Mean";
+        case EwmaStatistic::Variance: return "Variance";
+        case EwmaStatistic::StandardDeviation: return "StandardDeviation";
+    }
+    return "<unknown EwmaStatistic>";
+}
+
+// Streaming exponentially weighted mean and variance of one series. push() and skip() are O(1),
+// inline and allocation-free, so an instance can ride along an event loop (see
+// ModelSession::trackEwma) as well as the batch kernels below.
+//
+// The update is West's weighted form of Welford's: ageing every old weight by decay leaves the
+// mean alone and scales the weighted sum of squared deviations, then the new sample joins with
+// weight 1.
+class EwmaMoments {
+ public:
+    explicit EwmaMoments(EwmaParameters params) : params_(params) { params_.validate(); }
+
+    void push(double x) {
+        age_();
+        weight_ += 1.0;
+        weight2_ += 1.0;
+        ++count_;
+        const double delta = x - mean_;
+        mean_ += delta / weight_;
+        m2_ += params_.demean ? delta * (x - mean_) : x * x;
+    }
+    // A missing step: time passes, so every sample seen so far ages, but nothing joins.
+    void skip() { age_(); }
+
+    const EwmaParameters& parameters() const { return params_; }
+    size_t count() const { return count_; }
+    // W² / ΣW²: how many equally weighted samples the current weights are worth.
+    double effectiveSampleSize() const { return weight2_ > 0.0 ? weight_ * weight_ / weight2_ : 0.0; }
+
+    // NaN until a first sample, and the variance until it is defined (two samples when
+    // demeaned and bias-corrected).
+    double mean() const { return count_ == 0 ? std::numeric_limits<double>::quiet_NaN() : mean_; }
+    double variance() const {
+        if (count_ == 0) return std::numeric_limits<double>::quiet_NaN();
+        if (!params_.demean || !params_.biasCorrected) return m2_ / weight_;
+        const double denominator = weight_ * weight_ - weight2_;
+        return denominator > 0.0 ? m2_ * weight_ / denominator : std::numeric_limits<double>::quiet_NaN();
+    }
+    double standardDeviation() const { return std::sqrt(variance()); }
+
+ private:
+    EwmaParameters params_;
+    double weight_ = 0.0;   // Σ w
+    double weight2_ = 0.0;  // Σ w²
+    double mean_ = 0.0;
+    double m2_ = 0.0;       // Σ w (x - mean)², or Σ w x² when not demeaned
+    size_t count_ = 0;
+
+    void age_() {
+        weight_ *= params_.decay;
+        weight2_ *= params_.decay * params_.decay;
+        m2_ *= params_.decay;
+    }
+};
+
+// Streaming exponentially weighted covariance of k aligned series, one row (one timestamp, all k
+// values) per push(). Same weights and corrections as EwmaMoments; each row costs one symmetric
+// rank-1 update, O(k²), into storage sized once at construction.
+//
+// A row with any non-finite lane counts as a missing step for every series (listwise), so all
+// entries of the matrix keep describing the same timestamps.
+class EwmaCovariance {
+ public:
+    EwmaCovariance(size_t dimension, EwmaParameters params);
+
+    // Throws InvalidArgument when row.size() != dimension().
+    void push(std::span<const double> row);
+    void skip();
+
+    const EwmaParameters& parameters() const { return params_; }
+    size_t dimension() const { return static_cast<size_t>(mean_.size()); }
+    size_t count() const { return count_; }
+    double effectiveSampleSize() const { return weight2_ > 0.0 ? weight_ * weight_ / weight2_ : 0.0; }
+
+    // NaN until defined, like EwmaMoments. The single-entry forms do not allocate.
+    const Eigen::VectorXd& mean() const { return mean_; }
+    Eigen::MatrixXd covariance() const;
+    double covariance(size_t i, size_t j) const;
+    // Entries whose variances are zero come back NaN.
+    Eigen::MatrixXd correlation() const;
+    double correlation(size_t i, size_t j) const;
+
+ private:
+    EwmaParameters params_;
+    double weight_ = 0.0;
+    double weight2_ = 0.0;
+    size_t count_ = 0;
+    Eigen::VectorXd mean_;
+    Eigen::VectorXd delta_;  // scratch for push(), so a step never allocates
+    Eigen::MatrixXd m2_;     // lower triangle only
+
+    void age_();
+    double scale_() const;
+};
+
+// Full-length series of a streaming statistic: row i holds the state after rows 0..i. Missing
+// samples (same rules as the moment functions) age the weights without joining them.
+std::vector<double> ewma(Samples x, EwmaParameters params, EwmaStatistic stat);
+std::vector<double> ewma(Samples x, ValidityMask valid, EwmaParameters params, EwmaStatistic stat);
+
+// Pairwise series: a row counts only when both lanes are present. Throws InvalidArgument on a
+// length mismatch.
+std::vector<double> ewmaCovariance(Samples x, Samples y, EwmaParameters params);
+std::vector<double> ewmaCovariance(
+    Samples x, ValidityMask validX, Samples y, ValidityMask validY, EwmaParameters params);
+std::vector<double> ewmaCorrelation(Samples x, Samples y, EwmaParameters params);
+std::vector<double> ewmaCorrelation(
+    Samples x, ValidityMask validX, Samples y, ValidityMask validY, EwmaParameters params);
+
+// Every column at once, in a single pass over the rows. The returned accumulator holds the
+// state after the last row and can keep taking rows from there. The views must be aligned on one
+// grid (throws InvalidArgument otherwise); their validity masks mark rows as missing.
+EwmaCovariance ewmaCovariance(std::span<const TimeSeriesView> views, EwmaParameters params);
+EwmaCovariance ewmaCovariance(const TimeSeriesPanel& panel, EwmaParameters params);
+
+}  // namespace ts::analysis::stats
+
+template <>
+struct std::formatter<ts::analysis::stats::EwmaStatistic> : std::formatter<std::string_view> {
+    auto format(ts::analysis::stats::EwmaStatistic stat, std::format_context& ctx) const
+        -> std::format_context::iterator {
+        return std::formatter<std::string_view>::format(ts::analysis::stats::toString(stat), ctx);
+    }
+};
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Element-wise double kernels behind the TimeSeries / TimeSeriesView operators.
+//
+// Each kernel has a scalar, SSE2, AVX2 and AVX-512 body; the widest one the CPU supports is
+// picked once, at first use, from CPUID. Builds for other architectures (or compilers without
+// GCC-style target attributes) only ever see the scalar table. All kernels accept `out`
+// aliasing either input exactly, which is how the compound operators run in place.
+namespace ts::kernels {
+
+enum class Isa { Scalar, SSE2, AVX2, AVX512 };
+
+constexpr std::string_view toString(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "Scalar";
+        case Isa::SSE2: return "SSE2";
+        case Isa::AVX2: return "AVX2";
+        case Isa::AVX512: return "AVX512";
+    }
+    return "<unknown Isa>";
+}
+
+using BinaryKernel = void (*)(const double* a, const double* b, double* out, size_t n);
+using ScalarKernel = void (*)(const double* a, double scalar, double* out, size_t n);
+
+struct KernelTable {
+    Isa isa;
+    BinaryKernel add;
+    BinaryKernel sub;
+    BinaryKernel mul;
+    // a / b, with 0 wherever b == 0 — the TimeSeries::operator/= rule, done with a mask
+    // rather than a per-element branch.
+    BinaryKernel div;
+    ScalarKernel addScalar;
+    ScalarKernel subScalar;
+    ScalarKernel mulScalar;
+    ScalarKernel divScalar;  // callers reject a zero scalar before getting here
+};
+
+// Widest instruction set both compiled in and reported by the CPU.
+Isa detectedIsa();
+// Every Isa usable on this machine, narrowest first. Benchmarks iterate it.
+std::vector<Isa> supportedIsas();
+// The table for a specific Isa; throws InvalidArgument if this machine cannot run it.
+const KernelTable& table(Isa isa);
+// The table for detectedIsa(), resolved once.
+const KernelTable& active();
+
+// Span front-ends over active(). Sizes must match; out may alias a or b.
+void add(std::span<const double> a, std::span<const double> b, std::span<double> out);
+void sub(std::span<const double> a, std::span<const double> b, std::span<double> out);
+void mul(std::span<const double> a, std::span<const double> b, std::span<double> out);
+void div(std::span<const double> a, std::span<const double> b, std::span<double> out);
+void add(std::span<const double> a, double scalar, std::span<double> out);
+void sub(std::span<const double> a, double scalar, std::span<double> out);
+void mul(std::span<const double> a, double scalar, std::span<double> out);
+void div(std::span<const double> a, double scalar, std::span<double> out);
+
+}  // namespace ts::kernels
+
+template <>
+struct std::formatter<ts::kernels::Isa> : std::formatter<std::string_view> {
+    auto format(ts::kernels::Isa isa, std::format_context& ctx) const -> std::format_context::iterator {
+        return std::formatter<std::string_view>::format(ts::kernels::toString(isa), ctx);
+    }
+};
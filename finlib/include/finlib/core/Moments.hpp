@@ -0,0 +1,105 @@
+// Copyright 2026 JBBLET
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <string_view>
+
+namespace ts::analysis::stats {
+
+// Standard
+enum class VarianceType { Population, Sample };
+
+constexpr std::string_view toString(VarianceType type) {
+    switch (type) {
+        case VarianceType::Population: return "Population";
+        case VarianceType::Sample: return "Sample";
+    }
+    return "<unknown VarianceType>";
+}
+
+// The first four central moments plus count and extrema, from one pass over the data.
+//
+// m2..m4 are sums of powered deviations from the mean. Two accumulators combine with merge()
+// (Chan's pairwise update, extended to m3/m4 by Pébay), which is exact in exact arithmetic and
+// stable in floating point, so partial results over chunks, threads or windows can be folded
+// together. Floating-point addition is not associative, though: bit-identical results need the
+// same grouping every time, which is what moments() in StatsCore guarantees.
+//
+// push() and merge() are inline and allocation-free so the type can sit inside a per-path or
+// per-step inner loop (see simulation::Welford). The statistic accessors follow the definitions
+// of the free functions in StatsCore, including their degenerate-sample rules.
+struct Moments {
+    std::size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double m3 = 0.0;
+    double m4 = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+
+    // Terriberry's online form of the pairwise update with a one-point right-hand side. The
+    // higher sums are updated first because they read the previous m2/m3.
+    void push(double x) {
+        const auto n1 = static_cast<double>(count);
+        ++count;
+        const auto n = static_cast<double>(count);
+        const double delta = x - mean;
+        const double dn = delta / n;
+        const double dn2 = dn * dn;
+        const double term1 = delta * dn * n1;
+        mean += dn;
+        m4 += term1 * dn2 * (n * n - 3.0 * n + 3.0) + 6.0 * dn2 * m2 - 4.0 * dn * m3;
+        m3 += term1 * dn * (n - 2.0) - 3.0 * dn * m2;
+        m2 += term1;
+        min = std::min(min, x);
+        max = std::max(max, x);
+    }
+
+    void merge(const Moments& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        const auto na = static_cast<double>(count);
+        const auto nb = static_cast<double>(other.count);
+        const double n = na + nb;
+        const double delta = other.mean - mean;
+        const double delta2 = delta * delta;
+
+        const double newM2 = m2 + other.m2 + delta2 * na * nb / n;
+        const double newM3 = m3 + other.m3 + delta2 * delta * na * nb * (na - nb) / (n * n) +
+                             3.0 * delta * (na * other.m2 - nb * m2) / n;
+        const double newM4 = m4 + other.m4 + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n) +
+                             6.0 * delta2 * (na * na * other.m2 + nb * nb * m2) / (n * n) +
+                             4.0 * delta * (na * other.m3 - nb * m3) / n;
+
+        mean += delta * nb / n;
+        m2 = newM2;
+        m3 = newM3;
+        m4 = newM4;
+        count += other.count;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    // Throws InvalidArgument when the type needs more points than count (see varianceFast).
+    double variance(VarianceType type = VarianceType::Sample) const;
+    double skewness() const;
+    // Throws InvalidArgument on fewer than four points unless the sample is degenerate.
+    double kurtosis() const;
+    double excessKurtosis() const { return kurtosis() - 3.0; }
+};
+
+}  // namespace ts::analysis::stats
+
+template <>
+struct std::formatter<ts::analysis::stats::VarianceType> : std::formatter<std::string_view> {
+    auto format(ts::analysis::stats::VarianceType type, std::format_context& ctx) const
+        -> std::format_context::iterator {
+        return std::formatter<std::string_view>::format(ts::analysis::stats::toString(type), ctx);
+    }
+};
@@ -1,13 +1,20 @@
 // Copyright 2026 JBBLET
 #pragma once
+#include <cstddef>
 #include <format>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "finlib/common/Random.hpp"
 #include "finlib/core/TimeSeries.hpp"
 
 namespace ts {
+class TimeSeriesPanel;
 
 enum class InterpolationStrategy { Linear, Stochastic, Nearest, Exact, Latest };
 
@@ -24,6 +31,24 @@ constexpr std::string_view toString(InterpolationStrategy strategy) {
     return "<unknown InterpolationStrategy>";
 }
 
+// Downsampling: how the source points falling in one target bucket become one value.
+enum class Aggregation { Open, High, Low, Close, Sum, Mean, Count, Last, Vwap };
+
+constexpr std::string_view toString(Aggregation aggregation) {
+    switch (aggregation) {
+        case Aggregation::Open: return "Open";
+        case Aggregation::High: return "High";
+        case Aggregation::Low: return "Low";
+        case Aggregation::Close: return "Close";
+        case Aggregation::Sum: return "Sum";
+        case Aggregation::Mean: return "Mean";
+        case Aggregation::Count: return "Count";
+        case Aggregation::Last: return "Last";
+        case Aggregation::Vwap: return "Vwap";
+    }
+    return "<unknown Aggregation>";
+}
+
 struct StochasticParams {
     std::optional<double> varianceRate = std::nullopt;
     Seed seed = kDefaultSeed;
@@ -31,10 +56,106 @@ struct StochasticParams {
 
 double varianceRatePerTick(const TimeSeries& src);
 
+// Missing source points (src.validity()) are skipped: every strategy reads only present lanes.
+// Exact flags target points without a present source point as missing in the result.
 TimeSeries resample(const TimeSeries& src, TimestampsPtr target, InterpolationStrategy strategy,
                     const StochasticParams& params = {});
 TimeSeries resample(const TimeSeries& src, const Timestamps& target, InterpolationStrategy strategy,
                     const StochasticParams& params = {});
+
+// Whether resample() places every target row arithmetically instead of walking the source: both
+// grids evenly spaced (TimestampGrid::uniformStep, so an explicit grid that happens to be even
+// qualifies), no missing source lanes, two or more source points, and not Stochastic. Such a
+// resample costs no more than replaying an InterpolationPlan, so callers skip building one.
+bool resamplesArithmetically(const TimeSeries& src, const TimestampGrid& target, InterpolationStrategy strategy);
+
+// The walk resample() takes for one (source timestamps, target grid, strategy) triple, recorded
+// once so it can be replayed over any number of value vectors: per target row the source lane(s)
+// it reads and, for Linear, the interpolation weight. Replaying is a branch-free gather, with no
+// search and no per-row strategy switch, and gives the same values the walk does.
+//
+// A plan is built from a series, not from its timestamps alone, because the walk steps over
+// missing lanes: it applies to every series with the same source timestamps and the same
+// validity pattern, which is what a bucket of series loaded at one frequency usually shares.
+// Stochastic has no plan (its noise is drawn per call); the constructor throws InvalidArgument.
+class InterpolationPlan {
+ public:
+    InterpolationPlan(const TimeSeries& src, TimestampsPtr target, InterpolationStrategy strategy);
+
+    // Same timestamps and validity as the series the plan was built from. O(1) when the series
+    // shares the plan's source grid and bitmap; otherwise one pass over the timestamps/lanes.
+    bool appliesTo(const TimeSeries& src) const;
+
+    // The resampled values of `values`, which must be the source lanes (sourceSize() of them;
+    // throws InvalidArgument otherwise). Allocated from memory::currentResource().
+    std::pmr::vector<double> apply(std::span<const double> values) const;
+    // The same into caller-owned storage of target()->size() values (a panel column, say).
+    void apply(std::span<const double> values, std::span<double> out) const;
+
+    const TimestampsPtr& target() const { return target_; }
+    InterpolationStrategy strategy() const { return strategy_; }
+    size_t sourceSize() const { return sourceSize_; }
+    // Heap bytes the plan holds or keeps alive, for callers that keep plans within a memory
+    // budget: the row tables, plus the source and target grids (8 bytes a point, as a regular
+    // grid takes once materialised) and the validity bitmap it pins. Those are counted in full
+    // though other owners may share them, so this bounds what dropping the plan can free.
+    size_t bytes() const;
+
+ private:
+    TimestampsPtr source_;
+    size_t sourceOffset_ = 0;
+    size_t sourceSize_ = 0;
+    std::shared_ptr<const ValidityBitmap> validity_;
+    TimestampsPtr target_;
+    InterpolationStrategy strategy_;
+    // Row i reads lower_[i]; Linear rows blend in upper_[i] by weight_[i] (0 where the row sits
+    // on, before or after a source point). Exact rows with no source point are listed in missing_.
+    std::vector<size_t> lower_;
+    std::vector<size_t> upper_;
+    std::vector<double> weight_;
+    std::vector<size_t> missing_;
+};
+
+// resample(src, plan.target(), plan.strategy()) through the plan. Throws InvalidArgument unless
+// plan.appliesTo(src).
+TimeSeries resample(const TimeSeries& src, const InterpolationPlan& plan);
+
+// Resamples every source onto one target grid and returns them as the columns of one panel:
+// column j holds what resample(*sources[j], target, strategy, params) would, with NaN where
+// Exact has no source point (a panel carries no validity bitmap). Column j is named
+// columnIds[j], or the source's id when columnIds is empty. Stochastic columns get independent
+// noise: column j uses the seed rngForStream(params.seed, RngDomain::Resampling, j)() in place
+// of params.seed.
+//
+// The batch does its grid-side work once: the target is checked once, the block is allocated
+// once, and sources with the same timestamps and gaps share one InterpolationPlan, so only the
+// first of them walks the grid (none is built where resamplesArithmetically holds). Columns are
+// filled in parallel. Throws InvalidArgument on a null source, a null or unsorted target, or a
+// columnIds/sources size mismatch.
+TimeSeriesPanel resampleMany(std::span<const TimeSeries* const> sources, TimestampsPtr target,
+                             InterpolationStrategy strategy, const StochasticParams& params = {},
+                             std::vector<std::string> columnIds = {});
+TimeSeriesPanel resampleMany(std::span<const TimeSeries> sources, TimestampsPtr target,
+                             InterpolationStrategy strategy, const StochasticParams& params = {},
+                             std::vector<std::string> columnIds = {});
+
+// Aggregates a finer source into the buckets of a coarser target: minute ticks into daily bars.
+// Bucket i collects the present source points in [target[i], target[i + 1]); the last bucket is
+// as long as the one before it (a one-point grid's single bucket has no end), and points before
+// target[0] fall in none. An empty bucket reads NaN, except Sum and Count (0) and Last, which
+// carries forward the latest present point before the bucket's end.
+//
+// Vwap is Σ price·volume / Σ volume over the points where both are present. It needs `volume`,
+// aligned with `src` (same timestamps); asking for it without one throws InvalidArgument.
+//
+// Every requested column comes out of one pass over the source, run in chunks of whole buckets
+// on the shared pool. The panel has one row per target timestamp and one column per entry of
+// `columns`, named by toString().
+TimeSeriesPanel aggregate(const TimeSeries& src, TimestampsPtr target, std::span<const Aggregation> columns,
+                          const TimeSeries* volume = nullptr);
+// A single aggregation as a series on the target grid, its NaN buckets flagged missing.
+TimeSeries aggregate(const TimeSeries& src, TimestampsPtr target, Aggregation aggregation,
+                     const TimeSeries* volume = nullptr);
 }  // namespace ts
 
 template <>
@@ -43,3 +164,10 @@ struct std::formatter<ts::InterpolationStrategy> : std::formatter<std::string_vi
         return std::formatter<std::string_view>::format(ts::toString(strategy), ctx);
     }
 };
+
+template <>
+struct std::formatter<ts::Aggregation> : std::formatter<std::string_view> {
+    auto format(ts::Aggregation aggregation, std::format_context& ctx) const -> std::format_context::iterator {
+        return std::formatter<std::string_view>::format(ts::toString(aggregation), ctx);
+    }
+};
@@ -0,0 +1,65 @@
+// Copyright 2026 JBBLET
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <string_view>
+#include <vector>
+
+#include "finlib/core/Moments.hpp"
+#include "finlib/core/StatsCore.hpp"
+#include "finlib/core/ValidityBitmap.hpp"
+
+namespace ts::analysis::stats {
+
+enum class RollingStatistic { Sum, Mean, Variance, StandardDeviation, Skewness, Min, Max, ZScore, Median };
+
+constexpr std::string_view toString(RollingStatistic stat) {
+    switch (stat) {
+        case RollingStatistic::Sum: return "Sum";
+        case RollingStatistic::Mean: return "Mean";
+        case RollingStatistic::Variance: return "Variance";
+        case RollingStatistic::StandardDeviation: return "StandardDeviation";
+        case RollingStatistic::Skewness: return "Skewness";
+        case RollingStatistic::Min: return "Min";
+        case RollingStatistic::Max: return "Max";
+        case RollingStatistic::ZScore: return "ZScore";
+        case RollingStatistic::Median: return "Median";
+    }
+    return "<unknown RollingStatistic>";
+}
+
+// Trailing-window statistics, one output per input row. Row i (i >= window - 1) describes
+// x[i - window + 1 .. i] and matches the StatsCore function of the same name on that slice, with
+// the same skipping rules for missing samples; the first window - 1 rows are NaN, and so is any
+// row whose window holds no valid sample or too few for the variance type (where varianceFast
+// would throw). ZScore is (x[i] - mean) / stddev of the window ending at i, NaN when x[i] is
+// missing or the window is constant.
+//
+// Each step is O(1) amortised for the moment statistics and min/max, O(log window) for the
+// quantiles:
+//   - Sum .. ZScore keep power sums shifted by a recent window mean and add/remove one sample
+//     per step. The shift is re-centred and the sums rebuilt from scratch every `window` steps,
+//     which bounds the cancellation error to that of one window's worth of updates.
+//   - Min/Max keep a monotonic deque of candidate rows.
+//   - Median/rollingQuantile split the window into two ordered multisets around the target rank.
+//
+// Throws InvalidArgument when window is 0, when the mask does not have one lane per sample, or
+// when q is outside [0, 1].
+std::vector<double> rolling(Samples x, size_t window, RollingStatistic stat,
+                            VarianceType type = VarianceType::Sample);
+std::vector<double> rolling(Samples x, ValidityMask valid, size_t window, RollingStatistic stat,
+                            VarianceType type = VarianceType::Sample);
+// Same convention as quantileSorted on each window's valid samples.
+std::vector<double> rollingQuantile(Samples x, size_t window, double q);
+std::vector<double> rollingQuantile(Samples x, ValidityMask valid, size_t window, double q);
+
+}  // namespace ts::analysis::stats
+
+template <>
+struct std::formatter<ts::analysis::stats::RollingStatistic> : std::formatter<std::string_view> {
+    auto format(ts::analysis::stats::RollingStatistic stat, std::format_context& ctx) const
+        -> std::format_context::iterator {
+        return std::formatter<std::string_view>::format(ts::analysis::stats::toString(stat), ctx);
+    }
+};
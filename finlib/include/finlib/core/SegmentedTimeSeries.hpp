@@ -0,0 +1,93 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "finlib/common/FinlibTypes.hpp"
+#include "finlib/common/Format.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+
+namespace ts {
+
+// An append-only series for live feeds: a list of sealed, immutable blocks of blockSize()
+// points plus one tail buffer that takes the appends.
+//
+// A flat TimeSeries grows by building a new series and merging it in, which copies everything
+// already there. Here an append writes into the tail, whose capacity is reserved once per block,
+// and a full tail is sealed by moving its two vectors into a block — nothing already stored is
+// ever copied or reallocated, so append is O(1) amortised.
+//
+// Every sealed block is a shared TimeSeries of its own, so a view inside one block is a plain
+// zero-copy TimeSeriesView that keeps just that block alive. Ranges that cross a block boundary
+// or reach into the (still growing) tail have no single contiguous backing and are copied.
+// compact() flattens the whole thing into one TimeSeries on demand.
+class SegmentedTimeSeries {
+ public:
+    static constexpr size_t kDefaultBlockSize = 4096;
+
+    // Constructor
+    // Throws InvalidArgument when blockSize is 0.
+    explicit SegmentedTimeSeries(std::string id, size_t blockSize = kDefaultBlockSize);
+
+    // Append
+    // Timestamps must be strictly increasing; throws InvalidArgument otherwise.
+    void append(Timestamp ts, double value);
+    // Appends the present points of `series` stamped after back() and returns how many that was.
+    // Earlier points are skipped, so re-delivering an overlapping batch from a feed is harmless.
+    size_t append(const TimeSeries& series);
+
+    // Accessors
+    const std::string& getId() const { return id_; }
+    size_t size() const { return sealedCount() + tailValues_.size(); }
+    bool empty() const { return size() == 0; }
+    size_t blockSize() const { return blockSize_; }
+    size_t blockCount() const { return blocks_.size(); }
+    // Points held in sealed blocks; everything past this index sits in the tail.
+    size_t sealedCount() const { return blocks_.size() * blockSize_; }
+
+    double operator[](size_t i) const;
+    Timestamp timestamp(size_t i) const;
+    Timestamp back() const;
+
+    // Transformation Method
+    // The sealed block k as a shared series (zero-copy).
+    const std::shared_ptr<const TimeSeries>& block(size_t k) const;
+    TimeSeriesView blockView(size_t k) const;
+    // Rows [start, start + len). Zero-copy when they lie inside one sealed block; otherwise the
+    // range is copied into a fresh series that the view owns.
+    TimeSeriesView view(size_t start, size_t len) const;
+    // One flat series holding every point, on a fresh explicit grid.
+    TimeSeries compact() const;
+
+    // Display
+    std::string toString(const fmt::FormatSpec& spec = {}) const;
+
+ private:
+    std::string id_;
+    size_t blockSize_;
+    std::vector<std::shared_ptr<const TimeSeries>> blocks_;
+    Timestamps tailTimestamps_;
+    std::vector<double> tailValues_;
+
+    void sealTail_();
+    // Copies rows [start, start + len) out, block by block then from the tail.
+    void copyRange_(size_t start, size_t len, Timestamps& timestamps, std::vector<double>& values) const;
+};
+
+}  // namespace ts
+
+template <>
+struct std::formatter<ts::SegmentedTimeSeries, char> {
+    ts::fmt::FormatSpec spec;
+
+    constexpr auto parse(std::format_parse_context& ctx) { return ts::fmt::parseFormatSpec(ctx, spec); }
+
+    auto format(const ts::SegmentedTimeSeries& series, std::format_context& ctx) const -> std::format_context::iterator {
+        return std::format_to(ctx.out(), "{}", series.toString(spec));
+    }
+};
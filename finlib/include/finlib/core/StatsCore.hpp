@@ -4,42 +4,109 @@
 #include <Eigen/Dense>
 #include <cstddef>
 #include <format>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "finlib/common/Format.hpp"
+#include "finlib/core/Moments.hpp"
+#include "finlib/core/ValidityBitmap.hpp"
+
+namespace ts {
+class TimeSeriesView;
+class TimeSeriesPanel;
+}  // namespace ts
 
 namespace ts::analysis::stats {
 
 using Samples = std::span<const double>;
 
-// Standard
-enum class VarianceType { Population, Sample };
-
-constexpr std::string_view toString(VarianceType type) {
-    switch (type) {
-        case VarianceType::Population: return "Population";
-        case VarianceType::Sample: return "Sample";
-    }
-    return "<unknown VarianceType>";
-}
+// The moment statistics skip missing samples. Without a mask a sample is missing when it is not
+// finite; with one (a series' or view's validity(), sized like x) the mask alone decides, so no
+// NaN-free copy of the data has to be made first.
 double mean(Samples x);
+double mean(Samples x, ValidityMask valid);
 double varianceFast(Samples x, VarianceType type = VarianceType::Sample);
+double varianceFast(Samples x, ValidityMask valid, VarianceType type = VarianceType::Sample);
 double varianceSlow(Samples x, VarianceType type = VarianceType::Sample);
+double varianceSlow(Samples x, ValidityMask valid, VarianceType type = VarianceType::Sample);
 double standardDeviation(Samples x, VarianceType type = VarianceType::Sample);
+double standardDeviation(Samples x, ValidityMask valid, VarianceType type = VarianceType::Sample);
 
 double skewness(Samples x);
+double skewness(Samples x, ValidityMask valid);
 double kurtosis(Samples x);
+double kurtosis(Samples x, ValidityMask valid);
 double excessKurtosis(Samples x);
+double excessKurtosis(Samples x, ValidityMask valid);
+
+// Same skipping rules as the moment functions above. Values are staged in small blocks so each
+// block's power sums run as plain vectorisable loops, then folded in with Moments::merge.
+// Long inputs are cut into fixed-size chunks that run in parallel and are reduced by a fixed
+// pairwise tree, so the result is bit-identical whatever the thread count; varianceFast and the
+// higher moments all go through here.
+Moments moments(Samples x);
+Moments moments(Samples x, ValidityMask valid);
 
 double quantileSorted(Samples sortedX, double q);
 
+// How the lag sums behind acf / autocovariances are formed. Direct is the O(n·lags) double
+// loop; Fft correlates the zero-padded, demeaned series with itself through a real FFT in
+// O(n log n) for all lags at once. Auto takes the FFT once n·(maxLag + 1) reaches
+// kFftWorkThreshold and there are at least kFftMinLags lags — below that the loop is cheaper.
+//
+// Tolerance: the two agree to within 1e-10·gamma(0) at every lag (gamma(0) being the lag-0 sum
+// of squared deviations), i.e. acf values agree to about 1e-10 absolute.
+enum class CorrelationMethod { Auto, Direct, Fft };
+
+inline constexpr std::size_t kFftWorkThreshold = std::size_t{1} << 20;
+inline constexpr std::size_t kFftMinLags = 32;
+
+constexpr std::string_view toString(CorrelationMethod method) {
+    switch (method) {
+        case CorrelationMethod::Auto: return "Auto";
+        case CorrelationMethod::Direct: return "Direct";
+        case CorrelationMethod::Fft: return "Fft";
+    }
+    return "<unknown CorrelationMethod>";
+}
+
 double autocorrelationAt(Samples x, std::size_t lag);
-std::vector<double> acf(Samples x, std::size_t maxLag);
+std::vector<double> acf(Samples x, std::size_t maxLag, CorrelationMethod method = CorrelationMethod::Auto);
+// Partial autocorrelations at lags 0..maxLag (lag 0 is 1), from durbinLevinson below.
 std::vector<double> pacf(Samples x, std::size_t maxLag);
-std::vector<double> autocovariances(Samples x, std::size_t maxLag);
+// Unnormalised lag sums: gamma[k] = sum_i (x[i] - mean)(x[i + k] - mean), k = 0..maxLag.
+std::vector<double> autocovariances(Samples x, std::size_t maxLag, CorrelationMethod method = CorrelationMethod::Auto);
+// Appends the lags gamma does not hold yet, up to maxLag (clamped to n - 1), leaving the ones it
+// has untouched — gamma must be a prefix of autocovariances(x, ...) for the same x.
+void extendAutocovariances(Samples x, std::vector<double>& gamma, std::size_t maxLag,
+                           CorrelationMethod method = CorrelationMethod::Auto);
+
+// Everything the Durbin-Levinson recursion produces on its way to order maxLag, so order
+// selection can compare every AR(k), k <= maxLag, from one O(maxLag^2) pass instead of one fit
+// per candidate.
+//   partialAutocorrelations[k]: the lag-k partial autocorrelation, phi_kk (index 0 holds 1).
+//   innovationVariances[k]: one-step prediction error variance of the best linear AR(k)
+//     predictor, in the units of gamma (index 0 is gamma[0] itself). Non-increasing in k.
+//   coefficients(k): that predictor's phi_1..phi_k, phi_j multiplying x[t - j].
+// Once a predictor is exact (the variance reaches 0) every higher order adds nothing: their
+// partial autocorrelations and new coefficients are 0.
+struct DurbinLevinson {
+    std::vector<double> partialAutocorrelations;
+    std::vector<double> innovationVariances;
+    // Order k's coefficients sit at [k(k-1)/2, k(k+1)/2).
+    std::vector<double> coefficientTriangle;
+
+    std::size_t maxOrder() const { return innovationVariances.empty() ? 0 : innovationVariances.size() - 1; }
+    // Throws InvalidArgument when order > maxOrder().
+    std::span<const double> coefficients(std::size_t order) const;
+};
+
+// Runs the recursion over autocovariances gamma[0..maxLag] (maxLag is clamped to
+// gamma.size() - 1); any common scale works, the variances come back in it.
+DurbinLevinson durbinLevinson(Samples gamma, std::size_t maxLag);
 
 Eigen::MatrixXd toeplitzFromSamples(Samples x, std::size_t maxLag);
 Eigen::MatrixXd toeplitzFromAutocovariances(Samples gamma, std::size_t maxLag);
@@ -52,19 +119,51 @@ struct HypothesisTestResult {
     double p_value;
 };
 
+// jarqueBera: normality, from the sample skewness and kurtosis; chi-squared with 2 dof. Missing
+//   samples are skipped like the moment functions skip them.
+// adf: augmented Dickey-Fuller unit-root test with a constant, dy_t = a + b y_{t-1} +
+//   sum_i c_i dy_{t-i}; the statistic is the t-ratio of b and the p-value MacKinnon's (1994)
+//   approximation. A small p-value rejects the unit root, i.e. the series looks stationary.
+// breuschPagan: heteroskedasticity in time. The series is detrended on [1, t], the squared
+//   residuals are regressed on [1, t], and n R^2 (Koenker's form) is chi-squared with 1 dof.
+// breuschGodfrey: serial correlation of the demeaned series up to `lags`; (n - lags) R^2 of the
+//   auxiliary regression on the lagged residuals is chi-squared with `lags` dof.
+//
+// The regression tests need a gap-free sample and throw InvalidArgument on a missing or
+// non-finite value, or when the sample is too short for the regression. Without `lags` the
+// order follows Schwert's rule, 12 (n / 100)^(1/4), capped so the regression stays determined.
+// A constant sample has no defined statistic: both fields come back NaN rather than throwing,
+// so one flat series does not abort a batch.
 HypothesisTestResult jarqueBera(stats::Samples x);
-HypothesisTestResult adf(stats::Samples x);
+HypothesisTestResult adf(stats::Samples x, std::optional<std::size_t> lags = std::nullopt);
 HypothesisTestResult breuschPagan(stats::Samples x);
-HypothesisTestResult breuschGodfrey(stats::Samples x);
+HypothesisTestResult breuschGodfrey(stats::Samples x, std::optional<std::size_t> lags = std::nullopt);
+
+// Batch screening: one result per series (or panel column), in input order, the series run in
+// parallel. Every input is validated before any work starts, so a bad series throws with its id
+// instead of half a batch coming back. breuschPagan shares its design across the batch: one QR
+// of [1, t] per distinct length solves every series of that length at once. The view overloads
+// honour each view's validity (jarqueBera skips missing lanes; the regression tests reject them).
+std::vector<HypothesisTestResult> jarqueBera(std::span<const TimeSeriesView> views);
+std::vector<HypothesisTestResult> jarqueBera(const TimeSeriesPanel& panel);
+std::vector<HypothesisTestResult> adf(std::span<const TimeSeriesView> views,
+                                      std::optional<std::size_t> lags = std::nullopt);
+std::vector<HypothesisTestResult> adf(const TimeSeriesPanel& panel, std::optional<std::size_t> lags = std::nullopt);
+std::vector<HypothesisTestResult> breuschPagan(std::span<const TimeSeriesView> views);
+std::vector<HypothesisTestResult> breuschPagan(const TimeSeriesPanel& panel);
+std::vector<HypothesisTestResult> breuschGodfrey(std::span<const TimeSeriesView> views,
+                                                 std::optional<std::size_t> lags = std::nullopt);
+std::vector<HypothesisTestResult> breuschGodfrey(const TimeSeriesPanel& panel,
+                                                 std::optional<std::size_t> lags = std::nullopt);
 
 double PvalueFromTStatistic(double tStat);
 }  // namespace ts::analysis::hypothesisTesting
 
 template <>
-struct std::formatter<ts::analysis::stats::VarianceType> : std::formatter<std::string_view> {
-    auto format(ts::analysis::stats::VarianceType type, std::format_context& ctx) const
+struct std::formatter<ts::analysis::stats::CorrelationMethod> : std::formatter<std::string_view> {
+    auto format(ts::analysis::stats::CorrelationMethod method, std::format_context& ctx) const
         -> std::format_context::iterator {
-        return std::formatter<std::string_view>::format(ts::analysis::stats::toString(type), ctx);
+        return std::formatter<std::string_view>::format(ts::analysis::stats::toString(method), ctx);
     }
 };
 
@@ -0,0 +1,86 @@
+// Copyright 2026 JBBLET
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ts::analysis::stats {
+
+// A mergeable quantile sketch (Dunning's merging t-digest, k1 scale function).
+//
+// Samples are summarised by weighted centroids whose size the scale function caps: small near
+// the tails, larger in the middle. Memory is bounded by the compression δ alone — at most about
+// δ centroids plus an add() buffer of kBufferFactor·δ values, whatever the sample count — so
+// 10M Monte Carlo terminals fit in a few tens of KB instead of 80 MB and never need sorting.
+//
+// Error (δ = 200, checked in the unit tests on 10^6 normal and lognormal samples, single and
+// merged sketches): the true rank of a returned quantile is within 1e-3 of q, and within 2e-4
+// once q <= 0.001 or q >= 0.999 — the scale function spends its centroids on the tails. cdf()
+// has the same bound in the other direction. min and max are exact, and samples whose centroid
+// never merged with another come back exactly. Larger δ buys accuracy linearly in memory.
+//
+// Sketches built on different threads fold together with merge() in O(δ log δ). The result
+// depends (slightly) on the merge order, so fold partials in a fixed order when runs must be
+// reproducible. Non-finite values are skipped, like the moment functions skip them.
+class TDigest {
+ public:
+    static constexpr double kDefaultCompression = 200.0;
+    static constexpr std::size_t kBufferFactor = 5;
+
+    struct Centroid {
+        double mean;
+        double weight;
+    };
+
+    // Throws InvalidArgument when compression is below 10 (too few centroids to mean anything).
+    explicit TDigest(double compression = kDefaultCompression);
+
+    void add(double x);
+    void add(std::span<const double> x);
+    void merge(const TDigest& other);
+    // Folds the buffer into the centroids; queries do this on a copy when needed, so calling it
+    // is only worth it before a burst of queries on one sketch.
+    void compress();
+
+    // Accessors
+    double compression() const { return compression_; }
+    std::size_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    // Centroids after folding in the buffer, ordered by mean.
+    std::vector<Centroid> centroids() const;
+
+    // Same convention as quantileSorted (linear interpolation between order statistics, q = 0
+    // is the minimum, q = 1 the maximum). Throws InvalidArgument when empty or q is outside [0, 1].
+    double quantile(double q) const;
+    // Estimated fraction of samples <= x; 0 when empty.
+    double cdf(double x) const;
+
+    std::string toString() const;
+
+ private:
+    double compression_;
+    std::vector<Centroid> centroids_;  // compressed, ordered by mean
+    std::vector<double> buffer_;
+    std::size_t count_ = 0;
+    double min_ = std::numeric_limits<double>::infinity();
+    double max_ = -std::numeric_limits<double>::infinity();
+
+    std::vector<Centroid> merged_() const;
+    static std::vector<Centroid> cluster_(std::vector<Centroid> items, double compression);
+};
+
+}  // namespace ts::analysis::stats
+
+template <>
+struct std::formatter<ts::analysis::stats::TDigest> : std::formatter<std::string_view> {
+    auto format(const ts::analysis::stats::TDigest& digest, std::format_context& ctx) const
+        -> std::format_context::iterator {
+        return std::formatter<std::string_view>::format(digest.toString(), ctx);
+    }
+};
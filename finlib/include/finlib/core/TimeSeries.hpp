@@ -3,21 +3,27 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <execution>
 #include <format>
 #include <iostream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "finlib/common/Execution.hpp"
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/Format.hpp"
+#include "finlib/core/ValidityBitmap.hpp"
+#include "finlib/core/ValueBuffer.hpp"
 
 namespace ts {
 class TimeSeriesView;
+namespace expr {
+struct Access;
+}
 
 class TimeSeries : public std::enable_shared_from_this<TimeSeries> {
  public:
@@ -26,21 +32,27 @@ class TimeSeries : public std::enable_shared_from_this<TimeSeries> {
     TimeSeries(std::string id, Timestamps ts, std::vector<double> vals);
     TimeSeries(std::string id, TimestampsPtr ts, std::vector<double> vals);
     TimeSeries(std::string id, TimestampsPtr sharedTimestamps, size_t tsOffset, std::vector<double> vals);
+    // Adopts an existing buffer, e.g. a std::pmr::vector allocated from a RequestArena.
+    TimeSeries(std::string id, TimestampsPtr sharedTimestamps, size_t tsOffset, ValueBuffer vals);
 
+    // O(1): the copy shares the value buffer until one side mutates it (see ValueBuffer).
     TimeSeries(const TimeSeries& other)
         : id_(other.id_),
           timestamps_(other.timestamps_),
           tsOffset_(other.tsOffset_),
           values_(other.values_),
+          validity_(other.validity_),
           isSynthetic_(other.isSynthetic_) {}
 
     static TimeSeries synthetic(std::string id, TimestampsPtr ts, std::vector<double> vals);
+    static TimeSeries synthetic(std::string id, TimestampsPtr ts, ValueBuffer vals);
 
     friend void swap(TimeSeries& first, TimeSeries& second) noexcept {
         std::swap(first.id_, second.id_);
         std::swap(first.timestamps_, second.timestamps_);
         std::swap(first.tsOffset_, second.tsOffset_);
         std::swap(first.values_, second.values_);
+        std::swap(first.validity_, second.validity_);
         std::swap(first.isSynthetic_, second.isSynthetic_);
     }
 
@@ -54,22 +66,44 @@ class TimeSeries : public std::enable_shared_from_this<TimeSeries> {
           timestamps_(std::move(other.timestamps_)),
           tsOffset_(other.tsOffset_),
           values_(std::move(other.values_)),
+          validity_(std::move(other.validity_)),
           isSynthetic_(other.isSynthetic_) {}
     ~TimeSeries() = default;
 
     // Accessors
     size_t size() const { return values_.size(); }
-    std::string getId() const { return id_; }
-    const std::vector<double>& getValues() const { return values_; }
+    const std::string& getId() const { return id_; }
+    std::span<const double> getValues() const { return values_.get(); }
+    // True when both series read the same value buffer, i.e. neither has written since one
+    // was copied from the other.
+    bool sharesValuesWith(const TimeSeries& other) const { return values_.sharesWith(other.values_); }
+    // Keeps getValues().data() valid after this series mutates or is assigned (see ValueBuffer::storage).
+    std::shared_ptr<const void> getValueStorage() const { return values_.storage(); }
     bool isSynthetic() const { return isSynthetic_; }
 
+    // Validity
+    // Missing points are flagged in an optional bitmap next to the values rather than removed.
+    // Without one every lane is valid; hasValidity() means at least one lane is missing.
+    bool hasValidity() const { return validity_ != nullptr; }
+    ValidityMask validity() const { return validity_ ? validity_->mask() : ValidityMask(); }
+    const std::shared_ptr<const ValidityBitmap>& getSharedValidity() const { return validity_; }
+    bool isValid(size_t i) const { return !validity_ || validity_->isValid(i); }
+    size_t validCount() const { return validity_ ? validity_->countValid() : size(); }
+    // One bit per value, set = present. Throws InvalidArgument on a size mismatch; an all-valid
+    // bitmap is dropped rather than stored.
+    TimeSeries& setValidity(ValidityBitmap bitmap);
+    // Flags every NaN lane as missing, in place: neither the values nor the grid are copied.
+    TimeSeries& markMissing();
+    // Dense copy holding only the valid lanes. Without a bitmap this is the O(1) shared copy.
+    TimeSeries dropInvalid() const;
+
     // TimeStamps Accessors
     size_t lowerBound(Timestamp ts) const;
     size_t upperBound(Timestamp ts) const;
-    // Returns the value at exactly ts, or nullopt if no such timestamp exists.
+    // Returns the value at exactly ts, or nullopt if no such timestamp exists (or it is missing).
     std::optional<double> exactValue(Timestamp ts) const;
-    // Returns the value at the latest timestamp <= ts (look-back only, no look-ahead).
-    // Throws if the series is empty or ts is before the first point.
+    // Returns the value at the latest valid timestamp <= ts (look-back only, no look-ahead).
+    // Throws if the series is empty or ts is before the first valid point.
     double latestValue(Timestamp ts) const;
     size_t tsOffset() const { return tsOffset_; }
     const TimestampsPtr& getSharedTimestamps() const { return timestamps_; }
@@ -117,32 +151,37 @@ class TimeSeries : public std::enable_shared_from_this<TimeSeries> {
 
     template <typename Func>
     TimeSeries apply(Func func) const& {
-        std::vector<double> new_vals(values_.size());
-        if (values_.size() < 20000) {
-            std::transform(values_.begin(), values_.end(), new_vals.begin(), func);
+        const auto values = values_.get();
+        auto new_vals = ValueBuffer::allocate(values.size());
+        if (values.size() < 20000) {
+            std::transform(values.begin(), values.end(), new_vals.begin(), func);
         } else {
-            std::transform(std::execution::par, values_.begin(), values_.end(), new_vals.begin(), func);
+            std::transform(kParallelPolicy, values.begin(), values.end(), new_vals.begin(), func);
         }
         // Share the parent's TimestampPtr and preserve tsOffset_ — zero timestamp allocation.
-        return TimeSeries("Transformed " + id_, timestamps_, tsOffset_, std::move(new_vals));
+        TimeSeries result("Transformed " + id_, timestamps_, tsOffset_, ValueBuffer(std::move(new_vals)));
+        result.validity_ = validity_;
+        return result;
     }
 
     template <typename Func>
     TimeSeries apply(Func func) && {
-        if (values_.size() < 20000) {
-            std::transform(values_.begin(), values_.end(), values_.begin(), func);
+        const auto values = values_.mutate();  // clones only if a copy still shares the buffer
+        if (values.size() < 20000) {
+            std::transform(values.begin(), values.end(), values.begin(), func);
         } else {
-            std::transform(std::execution::par, values_.begin(), values_.end(), values_.begin(), func);
+            std::transform(kParallelPolicy, values.begin(), values.end(), values.begin(), func);
         }
         return std::move(*this);
     }
 
     template <typename Func>
     TimeSeries& applyInPlace(Func func) {
-        if (values_.size() < 20000) {
-            std::transform(values_.begin(), values_.end(), values_.begin(), func);
+        const auto values = values_.mutate();  // clones only if a copy still shares the buffer
+        if (values.size() < 20000) {
+            std::transform(values.begin(), values.end(), values.begin(), func);
         } else {
-            std::transform(std::execution::par, values_.begin(), values_.end(), values_.begin(), func);
+            std::transform(kParallelPolicy, values.begin(), values.end(), values.begin(), func);
         }
         return *this;
     }
@@ -151,10 +190,18 @@ class TimeSeries : public std::enable_shared_from_this<TimeSeries> {
     std::string id_;
     TimestampsPtr timestamps_;
     size_t tsOffset_ = 0;
-    std::vector<double> values_;
+    ValueBuffer values_;
+    std::shared_ptr<const ValidityBitmap> validity_;  // null = every lane valid
     bool isSynthetic_ = false;
 
+    // Lazy expressions (TimeSeriesExpression.hpp) evaluate compound assignments in place.
+    friend struct expr::Access;
+
     void verifyAlignment_(const TimeSeries& other) const;
+    // Validity of an element-wise result of *this and other: valid only where both are.
+    std::shared_ptr<const ValidityBitmap> combinedValidity_(const TimeSeries& other) const;
+    // Same id, grid, offset, validity and synthetic flag as *this, carrying the given values.
+    TimeSeries withValues_(ValueBuffer vals) const;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const TimeSeries& obj) {
@@ -0,0 +1,396 @@
+// "Copyright (c) 2026 JBBLET All Rights Reserved."
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <format>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "finlib/common/Error.hpp"
+#include "finlib/common/FinlibTypes.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+#include "finlib/core/ValidityBitmap.hpp"
+#include "finlib/core/ValueBuffer.hpp"
+
+// Lazy element-wise arithmetic over TimeSeries / TimeSeriesView.
+//
+// The eager operators on TimeSeries copy the left operand and then walk the grid once per
+// operator, so `price * fx + cash * fxCash` allocates three temporaries and reads the grid four
+// times. Wrapping one operand in ts::lazy() switches the whole expression to nodes that only
+// record what to compute; the work happens once, when the expression is converted to a
+// TimeSeries or folded into one with a compound assignment:
+//
+//     TimeSeries nav = ts::lazy(price) * fx + ts::lazy(cash) * fxCash;   // one allocation, one pass
+//     total += ts::lazy(segment) * mask;                                 // no allocation at all
+//
+// Alignment is checked once per evaluation, against the first series operand, with the same
+// rules and messages as TimeSeries::verifyAlignment_. Series divisors follow operator/= (x / 0
+// yields 0); scalar divisors of 0 throw when the node is built.
+//
+// Nodes hold references to their operands, so an expression must be consumed within the full
+// expression that builds it. Do not store one in an `auto` variable past the statement.
+namespace ts {
+namespace expr {
+
+// Tag base: anything deriving from it is a lazy node the operators below accept.
+struct NodeBase {};
+
+template <typename T>
+concept Node = std::derived_from<std::remove_cvref_t<T>, NodeBase>;
+
+template <typename T>
+concept Operand = Node<T> || std::same_as<std::remove_cvref_t<T>, TimeSeries> ||
+                  std::same_as<std::remove_cvref_t<T>, TimeSeriesView> || std::is_arithmetic_v<std::remove_cvref_t<T>>;
+
+// Write access to the value buffer of a TimeSeries for in-place evaluation. Kept out of the
+// public TimeSeries API on purpose: only the evaluator may scribble over a series' values.
+struct Access {
+    static std::span<double> values(TimeSeries& series) { return series.values_.mutate(); }
+};
+
+// ---------------------------------------------------------------------------
+// Leaves
+// ---------------------------------------------------------------------------
+
+class SeriesLeaf : public NodeBase {
+ public:
+    explicit SeriesLeaf(const TimeSeries& series) : series_(&series), data_(series.getValues().data()) {}
+
+    double at(size_t i) const { return data_[i]; }
+    size_t size() const { return series_->size(); }
+    std::span<const double> values() const { return {data_, series_->size()}; }
+    const TimestampGrid* grid() const { return series_->getSharedTimestamps().get(); }
+    size_t gridOffset() const { return series_->tsOffset(); }
+    ValidityMask validity() const { return series_->validity(); }
+    std::string id() const { return series_->getId(); }
+    std::string identity() const { return std::format("{:s}", *series_); }
+
+    TimeSeries materialise(std::string id, ValueBuffer vals) const {
+        return TimeSeries(std::move(id), series_->getSharedTimestamps(), series_->tsOffset(), std::move(vals));
+    }
+
+    template <typename F>
+    void forEachLeaf(F&& f) const {
+        f(*this);
+    }
+
+ private:
+    const TimeSeries* series_;
+    const double* data_;
+};
+
+class ViewLeaf : public NodeBase {
+ public:
+    explicit ViewLeaf(const TimeSeriesView& view) : view_(&view), data_(view.begin()) {}
+
+    double at(size_t i) const { return data_[i]; }
+    size_t size() const { return view_->size(); }
+    std::span<const double> values() const { return {data_, view_->size()}; }
+    const TimestampGrid* grid() const { return view_->getSharedTimestamps().get(); }
+    size_t gridOffset() const { return view_->tsOffset(); }
+    ValidityMask validity() const { return view_->validity(); }
+    std::string id() const { return view_->getTimeSeriesId(); }
+    std::string identity() const { return std::format("{:s}", *view_); }
+
+    TimeSeries materialise(std::string id, ValueBuffer vals) const {
+        return TimeSeries(std::move(id), view_->getSharedTimestamps(), view_->tsOffset(), std::move(vals));
+    }
+
+    template <typename F>
+    void forEachLeaf(F&& f) const {
+        f(*this);
+    }
+
+ private:
+    const TimeSeriesView* view_;
+    const double* data_;
+};
+
+class ScalarLeaf : public NodeBase {
+ public:
+    explicit ScalarLeaf(double value) : value_(value) {}
+
+    double at(size_t) const { return value_; }
+    double value() const { return value_; }
+
+    template <typename F>
+    void forEachLeaf(F&&) const {}
+
+ private:
+    double value_;
+};
+
+// ---------------------------------------------------------------------------
+// Operations
+// ---------------------------------------------------------------------------
+
+struct Add {
+    static double apply(double a, double b) { return a + b; }
+};
+struct Sub {
+    static double apply(double a, double b) { return a - b; }
+};
+struct Mul {
+    static double apply(double a, double b) { return a * b; }
+};
+// Same rule as TimeSeries::operator/=: a zero in the divisor series yields 0, not inf.
+struct Div {
+    static double apply(double a, double b) { return b == 0.0 ? 0.0 : a / b; }
+};
+
+template <typename L, typename R, typename Op>
+class BinaryNode : public NodeBase {
+ public:
+    BinaryNode(L lhs, R rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {}
+
+    double at(size_t i) const { return Op::apply(lhs_.at(i), rhs_.at(i)); }
+
+    template <typename F>
+    void forEachLeaf(F&& f) const {
+        lhs_.forEachLeaf(f);
+        rhs_.forEachLeaf(f);
+    }
+
+    // Evaluates into a fresh TimeSeries on the grid of the first series operand. An empty id
+    // keeps that operand's id, like the eager operators do for their left-hand side.
+    TimeSeries evaluate(std::string id = {}) const;
+    operator TimeSeries() const { return evaluate(); }  // NOLINT(google-explicit-constructor)
+
+ private:
+    L lhs_;
+    R rhs_;
+};
+
+template <typename E>
+class NegateNode : public NodeBase {
+ public:
+    explicit NegateNode(E inner) : inner_(std::move(inner)) {}
+
+    double at(size_t i) const { return -inner_.at(i); }
+
+    template <typename F>
+    void forEachLeaf(F&& f) const {
+        inner_.forEachLeaf(f);
+    }
+
+    TimeSeries evaluate(std::string id = {}) const;
+    operator TimeSeries() const { return evaluate(); }  // NOLINT(google-explicit-constructor)
+
+ private:
+    E inner_;
+};
+
+// ---------------------------------------------------------------------------
+// Operand lifting
+// ---------------------------------------------------------------------------
+
+template <Node N>
+const N& lift(const N& node) {
+    return node;
+}
+inline SeriesLeaf lift(const TimeSeries& series) { return SeriesLeaf(series); }
+inline ViewLeaf lift(const TimeSeriesView& view) { return ViewLeaf(view); }
+template <typename T>
+    requires std::is_arithmetic_v<T>
+ScalarLeaf lift(T value) {
+    return ScalarLeaf(static_cast<double>(value));
+}
+
+template <typename T>
+using Lifted = std::remove_cvref_t<decltype(lift(std::declval<const T&>()))>;
+
+// ---------------------------------------------------------------------------
+// Evaluation
+// ---------------------------------------------------------------------------
+
+namespace detail {
+
+// The grid every series operand must sit on, taken from the first one found. The identity
+// string is only rendered when a check fails; formatting it up front would cost an allocation
+// per evaluation on the happy path.
+struct Anchor {
+    const TimestampGrid* grid = nullptr;
+    size_t offset = 0;
+    size_t size = 0;
+    const NodeBase* leaf = nullptr;
+    std::string (*identity)(const NodeBase*) = nullptr;
+};
+
+template <typename Leaf>
+std::string identityOf(const NodeBase* leaf) {
+    return static_cast<const Leaf*>(leaf)->identity();
+}
+
+template <typename Leaf>
+void checkLeafAgainst(Anchor& anchor, const Leaf& leaf) {
+    if (anchor.leaf == nullptr) {
+        anchor = {leaf.grid(), leaf.gridOffset(), leaf.size(), &leaf, &identityOf<Leaf>};
+        return;
+    }
+    // Fast path: the same rows of the same grid.
+    if (leaf.grid() == anchor.grid && leaf.gridOffset() == anchor.offset && leaf.size() == anchor.size) return;
+    if (leaf.size() != anchor.size) {
+        throw InvalidArgument("TimeSeries size mismatch: {} vs {}", anchor.identity(anchor.leaf), leaf.identity());
+    }
+    // Compared on the grids, so two regular grids never get materialised for the check.
+    if (anchor.size != 0 && !anchor.grid->matches(anchor.offset, *leaf.grid(), leaf.gridOffset(), anchor.size)) {
+        throw InvalidArgument(
+            "TimeSeries timestamps do not match: {} vs {}", anchor.identity(anchor.leaf), leaf.identity());
+    }
+}
+
+// The once-per-expression replacement for the per-operator verifyAlignment_ calls.
+template <typename E>
+void verifyAlignment(Anchor& anchor, const E& expression) {
+    expression.forEachLeaf([&](const auto& leaf) {
+        if constexpr (!std::same_as<std::remove_cvref_t<decltype(leaf)>, ScalarLeaf>) checkLeafAgainst(anchor, leaf);
+    });
+}
+
+// Hands the first series/view operand to f, so the result can be materialised on its grid.
+// Expressions made only of scalars cannot be built through the public operators.
+template <typename E, typename F>
+void withFirstLeaf(const E& expression, F&& f) {
+    bool done = false;
+    expression.forEachLeaf([&](const auto& leaf) {
+        if constexpr (!std::same_as<std::remove_cvref_t<decltype(leaf)>, ScalarLeaf>) {
+            if (!done) {
+                done = true;
+                f(leaf);
+            }
+        }
+    });
+}
+
+// Lane-wise AND of every operand's validity, starting from `seed`; nullopt while no operand has
+// a missing lane, so the common case never allocates a bitmap.
+template <typename E>
+std::optional<ValidityBitmap> combinedValidity(const E& expression, size_t n, ValidityMask seed = {}) {
+    std::optional<ValidityBitmap> combined;
+    if (!seed.allValid()) combined = ValidityBitmap::fromMask(seed, n);
+    expression.forEachLeaf([&](const auto& leaf) {
+        if constexpr (!std::same_as<std::remove_cvref_t<decltype(leaf)>, ScalarLeaf>) {
+            const ValidityMask mask = leaf.validity();
+            if (mask.allValid()) return;
+            combined = combined ? ValidityBitmap::combine(combined->mask(), mask, n) : ValidityBitmap::fromMask(mask, n);
+        }
+    });
+    return combined;
+}
+
+template <typename E>
+TimeSeries evaluate(const E& expression, std::string id) {
+    Anchor anchor;
+    verifyAlignment(anchor, expression);
+    TimeSeries result;
+    withFirstLeaf(expression, [&](const auto& anchorLeaf) {
+        const size_t n = anchorLeaf.size();
+        auto out = ValueBuffer::allocate(n);
+        for (size_t i = 0; i < n; ++i) out[i] = expression.at(i);
+        result = anchorLeaf.materialise(id.empty() ? anchorLeaf.id() : std::move(id), ValueBuffer(std::move(out)));
+        if (auto validity = combinedValidity(expression, n)) result.setValidity(std::move(*validity));
+    });
+    return result;
+}
+
+template <typename Op, typename E>
+TimeSeries& compoundAssign(TimeSeries& target, const E& expression) {
+    Anchor anchor;
+    const SeriesLeaf targetLeaf(target);
+    checkLeafAgainst(anchor, targetLeaf);
+    verifyAlignment(anchor, expression);
+    // In place is safe even when an operand is the target itself: alignment pins every operand
+    // to the target's rows, and a lag cannot move a full-length view, so lane i is read before
+    // it is written and never after. If the target's buffer is still shared, Access::values
+    // clones it first; a leaf that captured the old pointer then reads the same numbers from
+    // the copy that kept it.
+    auto validity = combinedValidity(expression, target.size(), target.validity());
+    const auto values = Access::values(target);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = Op::apply(values[i], expression.at(i));
+    if (validity) target.setValidity(std::move(*validity));
+    return target;
+}
+
+}  // namespace detail
+
+template <typename L, typename R, typename Op>
+TimeSeries BinaryNode<L, R, Op>::evaluate(std::string id) const {
+    return detail::evaluate(*this, std::move(id));
+}
+
+template <typename E>
+TimeSeries NegateNode<E>::evaluate(std::string id) const {
+    return detail::evaluate(*this, std::move(id));
+}
+
+// ---------------------------------------------------------------------------
+// Operators — only enabled when at least one side is already a node, so plain
+// TimeSeries arithmetic keeps its eager member operators.
+// ---------------------------------------------------------------------------
+
+template <Operand A, Operand B>
+    requires(Node<A> || Node<B>)
+auto operator+(const A& a, const B& b) {
+    return BinaryNode<Lifted<A>, Lifted<B>, Add>(lift(a), lift(b));
+}
+
+template <Operand A, Operand B>
+    requires(Node<A> || Node<B>)
+auto operator-(const A& a, const B& b) {
+    return BinaryNode<Lifted<A>, Lifted<B>, Sub>(lift(a), lift(b));
+}
+
+template <Operand A, Operand B>
+    requires(Node<A> || Node<B>)
+auto operator*(const A& a, const B& b) {
+    return BinaryNode<Lifted<A>, Lifted<B>, Mul>(lift(a), lift(b));
+}
+
+template <Operand A, Operand B>
+    requires(Node<A> || Node<B>)
+auto operator/(const A& a, const B& b) {
+    if constexpr (std::is_arithmetic_v<B>) {
+        ensure(b != 0, "Division by 0 of lazy TimeSeries expression");
+    }
+    return BinaryNode<Lifted<A>, Lifted<B>, Div>(lift(a), lift(b));
+}
+
+template <Node E>
+auto operator-(const E& e) {
+    return NegateNode<std::remove_cvref_t<E>>(e);
+}
+
+template <Node E>
+TimeSeries& operator+=(TimeSeries& target, const E& e) {
+    return detail::compoundAssign<Add>(target, e);
+}
+
+template <Node E>
+TimeSeries& operator-=(TimeSeries& target, const E& e) {
+    return detail::compoundAssign<Sub>(target, e);
+}
+
+template <Node E>
+TimeSeries& operator*=(TimeSeries& target, const E& e) {
+    return detail::compoundAssign<Mul>(target, e);
+}
+
+template <Node E>
+TimeSeries& operator/=(TimeSeries& target, const E& e) {
+    return detail::compoundAssign<Div>(target, e);
+}
+
+}  // namespace expr
+
+// Entry points: wrap one operand and every operator touching it becomes lazy.
+inline expr::SeriesLeaf lazy(const TimeSeries& series) { return expr::SeriesLeaf(series); }
+inline expr::ViewLeaf lazy(const TimeSeriesView& view) { return expr::ViewLeaf(view); }
+
+}  // namespace ts
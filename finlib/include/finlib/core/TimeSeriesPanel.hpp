@@ -0,0 +1,108 @@
+// "Copyright (c) 2026 JBBLET All Rights Reserved."
+#pragma once
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "finlib/common/FinlibTypes.hpp"
+#include "finlib/common/Format.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+
+namespace ts {
+
+// N series on one shared grid, stored as a single column-major block (rows = timestamps,
+// columns = series). The layout is exactly Eigen's default, so asEigenMatrix() is a Map and
+// not a copy, and column j is one contiguous run — which is what lets columnView() hand out a
+// TimeSeriesView without copying anything.
+//
+// The grid follows the TimeSeries convention: a shared TimestampsPtr plus an offset, so a
+// panel built from series that already share a grid shares it too.
+class TimeSeriesPanel : public std::enable_shared_from_this<TimeSeriesPanel> {
+ public:
+    // Constructor
+    TimeSeriesPanel() = default;
+    // Zero-filled block of timestamps->size() rows, one column per id.
+    TimeSeriesPanel(TimestampsPtr timestamps, std::vector<std::string> columnIds);
+    // `columnMajor` holds rows * columnIds.size() values, column after column.
+    TimeSeriesPanel(TimestampsPtr timestamps, std::vector<std::string> columnIds, std::vector<double> columnMajor);
+    TimeSeriesPanel(TimestampsPtr timestamps, size_t tsOffset, size_t rows, std::vector<std::string> columnIds,
+                    std::vector<double> columnMajor);
+
+    // Packs aligned series into one block. Throws InvalidArgument unless every series sits on
+    // the same timestamps as the first (same rule as TimeSeries arithmetic). Column ids are the
+    // series ids.
+    static TimeSeriesPanel fromSeries(std::span<const TimeSeries> series);
+    static TimeSeriesPanel fromSeries(std::span<const TimeSeries* const> series);
+
+    // Accessors
+    size_t rows() const { return rows_; }
+    size_t cols() const { return columnIds_.size(); }
+    bool empty() const { return rows_ == 0 || columnIds_.empty(); }
+    const std::vector<std::string>& columnIds() const { return columnIds_; }
+    // Index of the column with that id; throws InvalidArgument when there is none.
+    size_t columnIndex(std::string_view id) const;
+
+    size_t tsOffset() const { return tsOffset_; }
+    const TimestampsPtr& getSharedTimestamps() const { return timestamps_; }
+    std::span<const Timestamp> getTimestamps() const;
+
+    double operator()(size_t row, size_t col) const { return values_[col * rows_ + row]; }
+    double& operator()(size_t row, size_t col) { return values_[col * rows_ + row]; }
+    std::span<const double> column(size_t col) const { return {values_.data() + col * rows_, rows_}; }
+    std::span<double> column(size_t col) { return {values_.data() + col * rows_, rows_}; }
+    std::span<const double> data() const { return values_; }
+
+    Eigen::Map<const Eigen::MatrixXd> asEigenMatrix() const {
+        return Eigen::Map<const Eigen::MatrixXd>(values_.data(), static_cast<Eigen::Index>(rows_),
+                                                 static_cast<Eigen::Index>(cols()));
+    }
+    Eigen::Map<Eigen::MatrixXd> asEigenMatrix() {
+        return Eigen::Map<Eigen::MatrixXd>(values_.data(), static_cast<Eigen::Index>(rows_),
+                                           static_cast<Eigen::Index>(cols()));
+    }
+
+    // Zero-copy: the view reads straight out of the block and keeps the panel alive. Like
+    // TimeSeries::view(), it needs the panel to be owned by a shared_ptr.
+    TimeSeriesView columnView(size_t col) const;
+    TimeSeriesView columnView(std::string_view id) const;
+    // Copies one column out into a standalone series on the panel's grid.
+    TimeSeries columnSeries(size_t col) const;
+
+    // Display
+    std::string toString(const fmt::FormatSpec& spec = {}) const;
+    void println(const fmt::FormatSpec& spec = {.mode = fmt::FormatMode::Repr}) const;
+    void head(std::size_t rows = 10) const;
+    void tail(std::size_t rows = 10) const;
+    void describe() const;
+
+ private:
+    TimestampsPtr timestamps_;
+    size_t tsOffset_ = 0;
+    size_t rows_ = 0;
+    std::vector<std::string> columnIds_;
+    std::vector<double> values_;  // column-major, rows_ * columnIds_.size()
+};
+
+inline std::ostream& operator<<(std::ostream& os, const TimeSeriesPanel& panel) {
+    return os << panel.toString({.mode = fmt::FormatMode::Repr});
+}
+}  // namespace ts
+
+template <>
+struct std::formatter<ts::TimeSeriesPanel, char> {
+    ts::fmt::FormatSpec spec;
+
+    constexpr auto parse(std::format_parse_context& ctx) { return ts::fmt::parseFormatSpec(ctx, spec); }
+
+    auto format(const ts::TimeSeriesPanel& panel, std::format_context& ctx) const -> std::format_context::iterator {
+        return std::format_to(ctx.out(), "{}", panel.toString(spec));
+    }
+};
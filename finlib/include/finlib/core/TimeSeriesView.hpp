@@ -6,8 +6,10 @@
 #include <cstddef>
 #include <format>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -28,41 +30,78 @@ struct RegularityCheck {
         : cachedTolerance(tolerance), isRegular(r), medianDeltaT(m), standardDeviationDeltaT(sd) {}
 };
 
+// The storage a view reads: `values` is row 0 of the owner's value block and row r sits at
+// (*timestamps)[tsOffset + r]. `owner` keeps whatever holds that block alive — a TimeSeries,
+// a TimeSeriesPanel column — so a view does not need to know which kind it is reading. `id` is
+// a copy of the owner's id taken at construction, shared between slices: the owner's own string
+// goes away when it is reassigned. When the owner can swap its value block out (a TimeSeries
+// mutating or being assigned), `storage` pins the block itself so `values` never dangles.
+// `validity` flags missing rows of the value block (null when every row is present).
+struct ViewBacking {
+    std::shared_ptr<const void> owner;
+    std::shared_ptr<const void> storage;
+    std::shared_ptr<const std::string> id;
+    const double* values = nullptr;
+    size_t size = 0;
+    TimestampsPtr timestamps;
+    size_t tsOffset = 0;
+    std::shared_ptr<const ValidityBitmap> validity;
+};
+
 class TimeSeriesView : public std::enable_shared_from_this<TimeSeriesView> {
  private:
-    std::shared_ptr<const TimeSeries> source_;
+    ViewBacking backing_;
     size_t begin_;
     size_t length_;
     int valueLag_;
 
     bool isAlignedWith(const TimeSeriesView& other) const;
     // Construct a TimeSeries from computed values, sharing the source's TimestampPtr at the correct offset.
-    TimeSeries materialise_(const std::string& id, std::vector<double> vals) const;
+    // Carries `validity` onto the result (nullopt = every lane valid).
+    TimeSeries materialise_(const std::string& id, std::pmr::vector<double> vals,
+                            std::optional<ValidityBitmap> validity = std::nullopt) const;
+    // Owning copy of this window's validity, and the AND with an aligned view's; nullopt when
+    // no lane can be missing.
+    std::optional<ValidityBitmap> ownValidity_() const;
+    std::optional<ValidityBitmap> combinedValidity_(const TimeSeriesView& other) const;
 
     mutable std::optional<RegularityCheck> cachedRegularityCheck_;
 
  public:
     TimeSeriesView(std::shared_ptr<const TimeSeries> src, size_t start, size_t len, int lag = 0);
-    TimeSeriesView() : source_(nullptr), begin_(0), length_(0), valueLag_(0) {}
+    TimeSeriesView(ViewBacking backing, size_t start, size_t len, int lag = 0);
+    TimeSeriesView() : begin_(0), length_(0), valueLag_(0) {}
     size_t size() const noexcept { return length_; }
     std::shared_ptr<const TimeSeriesView> getShared() const { return shared_from_this(); }
-    std::string getTimeSeriesId() const { return source_->getId(); }
+    std::string getTimeSeriesId() const { return backing_.id ? *backing_.id : std::string{}; }
 
     const double* begin() const noexcept;
     const double* end() const noexcept;
     double operator[](size_t i) const;
     Timestamp timestamp(size_t i) const;
 
+    // Grid accessors mirroring TimeSeries: the rows this view covers, and the shared vector plus
+    // offset a series built on those rows should point at (no timestamp copy).
+    std::span<const Timestamp> getTimestamps() const;
+    const TimestampsPtr& getSharedTimestamps() const { return backing_.timestamps; }
+    size_t tsOffset() const { return backing_.tsOffset + begin_; }
+
+    // Validity of the values this view reads (lag included): lane i describes (*this)[i]. An
+    // all-valid mask when the backing has no missing rows.
+    ValidityMask validity() const;
+    bool hasValidity() const { return backing_.validity != nullptr; }
+    size_t validCount() const { return hasValidity() ? validity().countValid() : length_; }
+
     // methods modifying the range
     TimeSeriesView slice(size_t subStart, size_t subLength) const {
-        return TimeSeriesView(source_, begin_ + subStart, subLength, valueLag_);
+        return TimeSeriesView(backing_, begin_ + subStart, subLength, valueLag_);
     }
     TimeSeriesView sliceIndex(size_t subStart, size_t subEnd) const {
-        return TimeSeriesView(source_, begin_ + subStart, subEnd - subStart + 1, valueLag_);
+        return TimeSeriesView(backing_, begin_ + subStart, subEnd - subStart + 1, valueLag_);
     }
 
     // methods modifying the lag
-    TimeSeriesView shift(int periods) const { return TimeSeriesView(source_, begin_, length_, valueLag_ + periods); }
+    TimeSeriesView shift(int periods) const { return TimeSeriesView(backing_, begin_, length_, valueLag_ + periods); }
 
     // Operation
     TimeSeries operator+(const double& scalar) const;
@@ -0,0 +1,72 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ts {
+
+// Non-owning window onto a validity bitmap: lane i is valid iff bit (offset + i) is set.
+// A default-constructed mask has no words and reads every lane as valid, which is what a series
+// without a bitmap hands out — callers test allValid() once and keep their dense loop.
+class ValidityMask {
+ public:
+    ValidityMask() = default;
+    ValidityMask(const uint64_t* words, size_t offset, size_t size) : words_(words), offset_(offset), size_(size) {}
+
+    bool allValid() const { return words_ == nullptr; }
+    // Lane count of the window; 0 for an all-valid mask, which has no extent of its own.
+    size_t size() const { return size_; }
+    bool isValid(size_t i) const {
+        if (!words_) return true;
+        const size_t bit = offset_ + i;
+        return ((words_[bit >> 6] >> (bit & 63)) & 1u) != 0;
+    }
+    // Lanes [64k, 64k + 64) of the window packed into one word (bit j = lane 64k + j), realigned
+    // when the window does not start on a word boundary. Lanes past size() read as invalid.
+    uint64_t word(size_t k) const;
+    size_t countValid() const;
+
+    ValidityMask subMask(size_t start, size_t len) const {
+        return words_ ? ValidityMask(words_, offset_ + start, len) : ValidityMask();
+    }
+
+ private:
+    const uint64_t* words_ = nullptr;
+    size_t offset_ = 0;
+    size_t size_ = 0;
+};
+
+// Arrow-style validity: one bit per value lane, set = the value is present. It sits beside a
+// series' values instead of replacing missing points with NaN-and-delete, so marking a gap
+// never reallocates the values or the grid. The payload of an invalid lane is unspecified
+// (loaders leave the NaN they were given) and every consumer that honours the bitmap ignores it.
+class ValidityBitmap {
+ public:
+    ValidityBitmap() = default;
+    explicit ValidityBitmap(size_t size, bool valid = true);
+
+    // Lanes holding NaN become invalid. Infinities are values, not gaps.
+    static ValidityBitmap fromValues(std::span<const double> values);
+    // Owning copy of a window (all-valid masks give an all-set bitmap of `size` lanes).
+    static ValidityBitmap fromMask(ValidityMask mask, size_t size);
+    // Lane-wise AND: a result lane is valid only where both operands are.
+    static ValidityBitmap combine(ValidityMask a, ValidityMask b, size_t size);
+
+    size_t size() const { return size_; }
+    bool isValid(size_t i) const { return ((words_[i >> 6] >> (i & 63)) & 1u) != 0; }
+    void set(size_t i, bool valid);
+    size_t countValid() const;
+    bool allValid() const { return countValid() == size_; }
+
+    ValidityMask mask() const { return {words_.data(), 0, size_}; }
+    ValidityMask mask(size_t start, size_t len) const { return {words_.data(), start, len}; }
+
+ private:
+    std::vector<uint64_t> words_;
+    size_t size_ = 0;
+};
+
+}  // namespace ts
@@ -0,0 +1,94 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "finlib/common/Memory.hpp"
+
+namespace ts {
+
+// Copy-on-write storage behind TimeSeries values.
+//
+// Copies share one reference-counted buffer, so copying a series (a cache hit, a by-value
+// return, a map insert) costs an atomic increment rather than a memcpy of every value. The
+// buffer is cloned the first time a holder asks for mutable access while someone else still
+// shares it; a sole owner mutates in place, exactly as a plain vector would.
+//
+// The buffer adopts either a std::vector (what callers and loaders hand in) or a
+// std::pmr::vector (what the library's own producers allocate from memory::currentResource()),
+// without copying either. For the pmr case the shared state is allocated from the same
+// resource, so a series built inside a RequestArena touches the global heap not at all.
+//
+// Thread-safety follows the usual value-type rule: concurrent reads of shared copies are fine,
+// mutating one ValueBuffer object while another thread copies *that same object* is a race.
+class ValueBuffer {
+ public:
+    ValueBuffer() = default;
+    explicit ValueBuffer(std::vector<double> values) {
+        adopt_(std::make_shared<std::vector<double>>(std::move(values)));
+    }
+    explicit ValueBuffer(std::pmr::vector<double> values) {
+        const std::pmr::polymorphic_allocator<std::byte> alloc = values.get_allocator();
+        adopt_(std::allocate_shared<std::pmr::vector<double>>(alloc, std::move(values)));
+    }
+
+    // n zero-initialised values on memory::currentResource(): what producers fill in before
+    // handing the vector to a ValueBuffer.
+    static std::pmr::vector<double> allocate(size_t n) {
+        return std::pmr::vector<double>(n, memory::currentResource());
+    }
+
+    ValueBuffer(const ValueBuffer&) = default;
+    ValueBuffer& operator=(const ValueBuffer&) = default;
+    // A moved-from buffer reads as empty, like a moved-from vector.
+    ValueBuffer(ValueBuffer&& other) noexcept
+        : owner_(std::move(other.owner_)),
+          data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+    ValueBuffer& operator=(ValueBuffer&& other) noexcept {
+        owner_ = std::move(other.owner_);
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        return *this;
+    }
+
+    // Read access never clones.
+    std::span<const double> get() const { return {data_, size_}; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    double operator[](size_t i) const { return data_[i]; }
+    std::span<const double> span() const { return get(); }
+
+    // Write access: clones first (onto memory::currentResource()) if the buffer is shared, so
+    // other holders keep what they saw. The length is fixed; only the values change.
+    std::span<double> mutate() {
+        if (owner_ && owner_.use_count() > 1) {
+            *this = ValueBuffer(std::pmr::vector<double>(data_, data_ + size_, memory::currentResource()));
+        }
+        return {data_, size_};
+    }
+
+    bool sharesWith(const ValueBuffer& other) const { return owner_ != nullptr && owner_ == other.owner_; }
+    // The reference-counted vector get() points into. Holding it keeps the values alive and,
+    // because it counts as a sharer, makes a later mutate() clone rather than write under the holder.
+    std::shared_ptr<const void> storage() const { return owner_; }
+
+ private:
+    std::shared_ptr<void> owner_;  // keeps whichever vector holds the values alive
+    double* data_ = nullptr;
+    size_t size_ = 0;
+
+    template <class Vector>
+    void adopt_(std::shared_ptr<Vector> vector) {
+        data_ = vector->data();
+        size_ = vector->size();
+        owner_ = std::move(vector);
+    }
+};
+
+}  // namespace ts
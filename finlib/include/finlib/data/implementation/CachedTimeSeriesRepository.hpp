@@ -2,6 +2,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -111,21 +112,23 @@ class CachedTimeSeriesRepository : public ITimeSeriesRepository {
     mutable std::unordered_map<SeriesKey, CoverageInfo> coverageCache_;
 
     static TimeSeries filterByRange_(const TimeSeries& full, Timestamp startMs, Timestamp endMs) {
-        const auto& timestamps = full.getTimestamps();
         const auto& values = full.getValues();
-
-        auto startIt = std::lower_bound(timestamps.begin(), timestamps.end(), startMs);
-        auto endIt = std::upper_bound(timestamps.begin(), timestamps.end(), endMs);
-
-        auto startIdx = static_cast<ptrdiff_t>(std::distance(timestamps.begin(), startIt));
-        auto endIdx = static_cast<ptrdiff_t>(std::distance(timestamps.begin(), endIt));
-
-        Timestamps filteredTs(timestamps.begin() + startIdx, timestamps.begin() + endIdx);
-        std::vector<double> filteredVals(values.begin() + startIdx, values.begin() + endIdx);
-
-        ensure(!filteredTs.empty(), "no data in {} for {:s}", (TimeRange{startMs, endMs}), full);
-
-        return TimeSeries(full.getId(), std::move(filteredTs), std::move(filteredVals));
+        // Grid lookups (arithmetic on a regular grid) and a slice that keeps sharing the cached
+        // series' grid at an offset — only the values are copied.
+        const size_t startIdx = full.lowerBound(startMs);
+        const size_t endIdx = full.upperBound(endMs);
+
+        ensure(startIdx < endIdx, "no data in {} for {:s}", (TimeRange{startMs, endMs}), full);
+        if (startIdx == 0 && endIdx == full.size()) return full;  // whole range: shares the value buffer too
+
+        std::vector<double> filteredVals(values.begin() + static_cast<ptrdiff_t>(startIdx),
+                                         values.begin() + static_cast<ptrdiff_t>(endIdx));
+        TimeSeries filtered(full.getId(), full.getSharedTimestamps(), full.tsOffset() + startIdx, std::move(filteredVals));
+        if (full.hasValidity()) {
+            const size_t len = endIdx - startIdx;
+            filtered.setValidity(ValidityBitmap::fromMask(full.validity().subMask(startIdx, len), len));
+        }
+        return filtered;
     }
 };
 }  // namespace ts
@@ -2,7 +2,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -12,6 +14,7 @@
 
 #include "finlib/common/Error.hpp"
 #include "finlib/common/FinlibTypes.hpp"
+#include "finlib/core/SegmentedTimeSeries.hpp"
 #include "finlib/core/TimeSeries.hpp"
 #include "finlib/data/CoverageInfo.hpp"
 #include "finlib/data/SeriesKey.hpp"
@@ -20,13 +23,18 @@
 namespace ts {
 // Minimal in-memory ITimeSeriesRepository. Stores whatever the service saves; coverage is computed
 // from the stored timestamps (the extent). Does not fetch on load misses.
+//
+// Merges that only add points past the stored end (a live feed, ModelSession's flushes) append
+// into a SegmentedTimeSeries next to the stored series, O(new points) however long it is; the
+// first read after such appends folds them into one flat series, so a burst of appends between
+// two reads costs one copy rather than one per append.
 class InMemoryTimeSeriesRepository : public ITimeSeriesRepository {
  public:
     TimeSeries load(const std::string& id, Timestamp startMs, Timestamp endMs,
                     std::optional<Timestamp> /*requestedFrequency*/ = std::nullopt) const override {
         auto it = std::find_if(data_.begin(), data_.end(), [&](const auto& kv) { return kv.first.SeriesId == id; });
         ensure(it != data_.end(), "InMemoryTimeSeriesRepository: no data for id {}", id);
-        return filter_(it->second, startMs, endMs);
+        return filter_(flat_(it->second), startMs, endMs);
     }
 
     LoaderCapabilities capabilities(const std::string& id) const override {
@@ -38,8 +46,10 @@ class InMemoryTimeSeriesRepository : public ITimeSeriesRepository {
 
     std::optional<CoverageInfo> coverage(const SeriesKey& key) const override {
         auto it = data_.find(key);
-        if (it == data_.end() || it->second.size() == 0) return std::nullopt;
-        const auto stamps = it->second.getTimestamps();
+        if (it == data_.end()) return std::nullopt;
+        const TimeSeries stored = flat_(it->second);
+        if (stored.size() == 0) return std::nullopt;
+        const auto stamps = stored.getTimestamps();
         return CoverageInfo{key, stamps.front(), stamps.back(), "computed", 0};
     }
 
@@ -54,30 +64,65 @@ class InMemoryTimeSeriesRepository : public ITimeSeriesRepository {
     TimeSeries load(const SeriesKey& key) const override {
         auto it = data_.find(key);
         ensure(it != data_.end(), "InMemoryTimeSeriesRepository: missing key {}", key.SeriesId);
-        return it->second;
+        return flat_(it->second);
     }
 
     TimeSeries load(const SeriesKey& key, Timestamp startMs, Timestamp endMs) const override {
-        return filter_(load(key), startMs, endMs);
+        auto it = data_.find(key);
+        ensure(it != data_.end(), "InMemoryTimeSeriesRepository: missing key {}", key.SeriesId);
+        return filter_(flat_(it->second), startMs, endMs);
     }
 
  private:
-    void doSave(const SeriesKey& key, const TimeSeries& ts) override { data_.insert_or_assign(key, ts); }
+    // `flat` is everything up to the last fold; `appended` holds the present points merged in
+    // past its end since then (created on the first such merge, so a series nobody appends to
+    // reserves no tail). Both are mutable so a const read can fold them.
+    struct Stored {
+        explicit Stored(TimeSeries series) : flat(std::move(series)) {}
+        mutable TimeSeries flat;
+        mutable std::optional<SegmentedTimeSeries> appended;
+
+        bool hasAppends() const { return appended && !appended->empty(); }
+    };
+
+    void doSave(const SeriesKey& key, const TimeSeries& ts) override { data_.insert_or_assign(key, Stored(ts)); }
 
     // Real union: combine existing + new points, dedupe by timestamp (new wins), keep sorted.
+    // Only present points take part, so a gap in newData never overwrites a stored value.
     void doMerge(const SeriesKey& key, const TimeSeries& newData) override {
         if (newData.size() == 0) return;
 
-        std::map<Timestamp, double> combined;
         auto it = data_.find(key);
+        // Live feeds mostly hand over points past the stored end: those go into the segments,
+        // without touching anything already stored.
         if (it != data_.end()) {
-            const auto stamps = it->second.getTimestamps();
-            const auto& vals = it->second.getValues();
-            for (size_t i = 0; i < it->second.size(); ++i) combined[stamps[i]] = vals[i];
+            const Stored& stored = it->second;
+            const std::lock_guard lock(foldMutex_);
+            if (stored.hasAppends() || stored.flat.size() != 0) {
+                const Timestamp storedEnd =
+                    stored.hasAppends() ? stored.appended->back() : stored.flat.getTimestamps().back();
+                if (newData.getTimestamps().front() > storedEnd) {
+                    if (!stored.appended) stored.appended.emplace(key.SeriesId);
+                    stored.appended->append(newData);
+                    return;
+                }
+            }
+        }
+
+        std::map<Timestamp, double> combined;
+        if (it != data_.end()) {
+            const TimeSeries stored = flat_(it->second);
+            const auto stamps = stored.getTimestamps();
+            const auto& vals = stored.getValues();
+            for (size_t i = 0; i < stored.size(); ++i) {
+                if (stored.isValid(i)) combined[stamps[i]] = vals[i];
+            }
         }
         const auto newStamps = newData.getTimestamps();
         const auto& newVals = newData.getValues();
-        for (size_t i = 0; i < newData.size(); ++i) combined[newStamps[i]] = newVals[i];
+        for (size_t i = 0; i < newData.size(); ++i) {
+            if (newData.isValid(i)) combined[newStamps[i]] = newVals[i];
+        }
 
         Timestamps mergedTs;
         std::vector<double> mergedVals;
@@ -87,24 +132,51 @@ class InMemoryTimeSeriesRepository : public ITimeSeriesRepository {
             mergedTs.push_back(t);
             mergedVals.push_back(v);
         }
-        data_.insert_or_assign(key, TimeSeries(key.SeriesId, std::move(mergedTs), std::move(mergedVals)));
+        data_.insert_or_assign(key, Stored(TimeSeries(key.SeriesId, std::move(mergedTs), std::move(mergedVals))));
     }
 
-    std::unordered_map<SeriesKey, TimeSeries> data_;
+    std::unordered_map<SeriesKey, Stored> data_;
+    // Serialises folding (and appending) so concurrent const reads stay safe.
+    mutable std::mutex foldMutex_;
+
+    // The stored series with any appended points folded in. The fold keeps the merge rules:
+    // only present points survive, in timestamp order (appends are all past the stored end).
+    TimeSeries flat_(const Stored& stored) const {
+        const std::lock_guard lock(foldMutex_);
+        if (!stored.hasAppends()) return stored.flat;
+        const TimeSeries base = stored.flat.dropInvalid();
+        const TimeSeries tail = stored.appended->compact();
+        const auto baseTs = base.getTimestamps();
+        const auto tailTs = tail.getTimestamps();
+        Timestamps mergedTs;
+        std::vector<double> mergedVals;
+        mergedTs.reserve(base.size() + tail.size());
+        mergedVals.reserve(base.size() + tail.size());
+        mergedTs.insert(mergedTs.end(), baseTs.begin(), baseTs.end());
+        mergedTs.insert(mergedTs.end(), tailTs.begin(), tailTs.end());
+        mergedVals.insert(mergedVals.end(), base.getValues().begin(), base.getValues().end());
+        mergedVals.insert(mergedVals.end(), tail.getValues().begin(), tail.getValues().end());
+        stored.flat = TimeSeries(stored.flat.getId(), std::move(mergedTs), std::move(mergedVals));
+        stored.appended.reset();
+        return stored.flat;
+    }
 
+    // Same slicing as CachedTimeSeriesRepository: grid lookups, a covering range hands back the
+    // stored series itself (an O(1) copy of its value buffer), a partial one shares the grid.
     static TimeSeries filter_(const TimeSeries& ts, Timestamp startMs, Timestamp endMs) {
-        const auto& timestamps = ts.getTimestamps();
+        const size_t startIdx = ts.lowerBound(startMs);
+        const size_t endIdx = ts.upperBound(endMs);
+        ensure(startIdx < endIdx, "InMemoryTimeSeriesRepository: empty range for {}", ts.getId());
+        if (startIdx == 0 && endIdx == ts.size()) return ts;
         const auto& values = ts.getValues();
-        Timestamps ots;
-        std::vector<double> ovs;
-        for (size_t i = 0; i < timestamps.size(); ++i) {
-            if (timestamps[i] >= startMs && timestamps[i] <= endMs) {
-                ots.push_back(timestamps[i]);
-                ovs.push_back(values[i]);
-            }
+        std::vector<double> ovs(values.begin() + static_cast<ptrdiff_t>(startIdx),
+                                values.begin() + static_cast<ptrdiff_t>(endIdx));
+        TimeSeries filtered(ts.getId(), ts.getSharedTimestamps(), ts.tsOffset() + startIdx, std::move(ovs));
+        if (ts.hasValidity()) {
+            const size_t len = endIdx - startIdx;
+            filtered.setValidity(ValidityBitmap::fromMask(ts.validity().subMask(startIdx, len), len));
         }
-        ensure(!ots.empty(), "InMemoryTimeSeriesRepository: empty range for {}", ts.getId());
-        return TimeSeries(ts.getId(), std::move(ots), std::move(ovs));
+        return filtered;
     }
 };
 }  // namespace ts
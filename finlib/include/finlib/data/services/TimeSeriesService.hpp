@@ -1,15 +1,20 @@
 // "Copyright (c) 2026 JBBLET All Rights Reserved."
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/core/Resampling.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/SeriesKey.hpp"
 #include "finlib/data/TimeRange.hpp"
 #include "finlib/data/implementation/CachedTimeSeriesRepository.hpp"
@@ -29,6 +34,18 @@ class TimeSeriesService {
                          InterpolationStrategy strategy = InterpolationStrategy::Nearest);
     TimeSeries getFilled(const std::string& id, Timestamp startMs, Timestamp endMs, Timestamp freqMs,
                          InterpolationStrategy strategy = InterpolationStrategy::Nearest);
+    // getFilled for every id at once, as one panel with a column per id (named by it), through
+    // resampleMany: buckets with the same timestamps walk the grid once between them.
+    TimeSeriesPanel getFilledMany(const std::vector<std::string>& ids, TimestampsPtr grid,
+                                  InterpolationStrategy strategy = InterpolationStrategy::Nearest);
+
+    // Downsampling: each grid bucket aggregated from the finest cached bucket strictly finer than
+    // the grid (see ts::aggregate for the bucket rules), so daily bars come out of minute data
+    // without the caller pulling the minutes. A bucket as coarse as the grid holds one point per
+    // bar and cannot give its open, high or low, so it is never used. Vwap needs a volume series
+    // and is not served here.
+    TimeSeries getAggregated(const std::string& id, TimestampsPtr grid, Aggregation aggregation = Aggregation::Close);
+    TimeSeriesPanel getAggregated(const std::string& id, TimestampsPtr grid, std::span<const Aggregation> columns);
 
     // ---- Spot ----
     double getSinglePoint(const std::string& id, Timestamp ts);
@@ -44,12 +61,47 @@ class TimeSeriesService {
     std::shared_ptr<CachedTimeSeriesRepository> cache_;
     std::shared_ptr<ITimeSeriesLoader> provider_;
 
+    // What a plan is keyed on, in O(1): the target grid by identity (resample_ interns it) and the
+    // source's shape, its first and last timestamps, length and present count. Buckets of one
+    // exchange share a shape without sharing a grid object. Equal keys are only a hint;
+    // appliesTo() confirms before a plan is replayed.
+    struct PlanKey {
+        const TimestampGrid* target;
+        InterpolationStrategy strategy;
+        Timestamp sourceFront;
+        Timestamp sourceBack;
+        size_t size;
+        size_t validCount;
+        bool operator==(const PlanKey&) const = default;
+    };
+
+    // Recently used interpolation plans, newest first. Every series filled onto one grid from
+    // buckets with the same timestamps (assets of one exchange, a session's sub-series) replays
+    // the first one's plan instead of walking again. A plan costs a walk plus a few words per
+    // target row, so one is only built the second time its key comes up: a one-off fill just
+    // walks. Bounded by InterpolationPlan::bytes(), the grids each plan pins included, since one
+    // plan over a long grid outweighs many short ones.
+    static constexpr size_t kPlanCacheBytes = size_t{64} << 20;
+    static constexpr size_t kSeenKeys = 64;
+    std::mutex planMutex_;
+    std::deque<std::shared_ptr<const InterpolationPlan>> plans_;
+    size_t planBytes_ = 0;
+    std::deque<PlanKey> seenOnce_;  // walked without a plan, newest first
+
     TimeSeries loadBucket_(const std::string& id, Timestamp startMs, Timestamp endMs, Timestamp coarsestMs,
                            bool finestFirst);
 
     std::optional<SeriesKey> selectBucket_(const std::string& id, Timestamp startMs, Timestamp endMs,
                                            Timestamp coarsestMs, bool finestFirst) const;
 
+    // The source aggregate() reads for `grid`: every point from its first bucket to its last, out
+    // of the finest cached bucket strictly finer than the grid.
+    TimeSeries aggregationSource_(const std::string& id, const TimestampGrid& grid);
+
+    // resample(bucket, grid, strategy) through a cached or freshly built plan (Stochastic walks, and
+    // evenly spaced grids need no plan; see resamplesArithmetically).
+    TimeSeries resample_(const TimeSeries& bucket, TimestampsPtr grid, InterpolationStrategy strategy);
+
     double singlePoint_(const std::string& id, Timestamp ts, bool requireExact);
 
     void fetchAndMergeGaps_(const SeriesKey& key, const std::vector<TimeRange>& gaps);
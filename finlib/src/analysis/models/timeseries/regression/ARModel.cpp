@@ -90,8 +90,8 @@ PredictionDistribution ARModel::predictDistribution(const Eigen::VectorXd& windo
 }
 
 void ARModel::yuleWalkerSolver_() {
-    std::vector<double> gamma = trainAnalysis->autocovariances(q_);
     Eigen::MatrixXd R = trainAnalysis->toeplitz(q_);
+    const auto gamma = trainAnalysis->autocovariances(q_);  // already cached by toeplitz()
     Eigen::VectorXd r(q_);
     for (int i = 0; i < q_; ++i) {
         r(i) = gamma[i + 1];
@@ -108,24 +108,9 @@ void ARModel::leastSquareSolver_(const Eigen::MatrixXd& X, const Eigen::VectorXd
 }
 
 void ARModel::levinsonDurbinSolver_() {
-    std::vector<double> gamma = trainAnalysis->autocovariances(q_);
-    Eigen::VectorXd phi(q_);
-    Eigen::VectorXd phiPrevious(q_);
-
-    double sigma = gamma[0];
-    for (int k = 0; k < q_; ++k) {
-        double sum = 0.0;
-        for (int j = 0; j < k; ++j) {
-            sum += phiPrevious[j] * gamma[k - j];
-        }
-        double lambda = (gamma[k + 1] - sum) / sigma;
-        phi[k] = lambda;
-        for (int j = 0; j < k; ++j) {
-            phi[j] = phiPrevious[j] - lambda * phiPrevious[k - j - 1];
-        }
-        sigma *= (1.0 - lambda * lambda);
-        phiPrevious = phi;
-    }
+    const auto recursion = trainAnalysis->durbinLevinson(q_);
+    const auto coefficients = recursion.coefficients(q_);
+    Eigen::VectorXd phi = Eigen::Map<const Eigen::VectorXd>(coefficients.data(), static_cast<Eigen::Index>(q_));
     intercept_ = (1 - std::accumulate(phi.begin(), phi.end(), 0.0)) * trainAnalysis->mean();
     phi_ = phi;
 }
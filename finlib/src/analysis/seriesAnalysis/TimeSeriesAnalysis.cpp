@@ -10,42 +10,35 @@
 #include <print>
 #include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "finlib/common/Error.hpp"
 #include "finlib/common/Format.hpp"
 #include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TDigest.hpp"
+#include "finlib/core/ValidityBitmap.hpp"
 
 namespace ts::analysis {
 
-double TimeSeriesAnalysis::mean() const {
-    if (!cachedMean_) {
-        cachedMean_ = stats::mean(view_);
-    }
-    return cachedMean_.value();
+const stats::Moments& TimeSeriesAnalysis::moments() const {
+    if (!cachedMoments_) cachedMoments_ = stats::moments(view_, view_.validity());
+    return *cachedMoments_;
 }
 
-std::optional<double> TimeSeriesAnalysis::variance(stats::VarianceType type) const {
-    std::optional<double>* cache = nullptr;
-    if (type == stats::VarianceType::Sample) {
-        cache = &cachedVarianceSample_;
-    } else if (type == stats::VarianceType::Population) {
-        cache = &cachedVariancePopulation_;
-    } else {
-        throw InvalidArgument("Invalid Variance type");
-    }
+double TimeSeriesAnalysis::mean() const { return moments().mean; }
 
-    if (!*cache) {
-        try {
-            double v = ts::analysis::stats::varianceFast(view_, type);
-            if (!std::isfinite(v)) return std::nullopt;
-            *cache = v;
-        } catch (const std::exception&) {
-            // Too few observations to define the variance.
-            return std::nullopt;
-        }
+std::optional<double> TimeSeriesAnalysis::variance(stats::VarianceType type) const {
+    ensure<InvalidArgument>(type == stats::VarianceType::Sample || type == stats::VarianceType::Population,
+                            "Invalid Variance type");
+    try {
+        double v = moments().variance(type);
+        if (!std::isfinite(v)) return std::nullopt;
+        return v;
+    } catch (const std::exception&) {
+        // Too few observations to define the variance.
+        return std::nullopt;
     }
-    return *cache;
 }
 
 std::optional<double> TimeSeriesAnalysis::standardDeviation() const {
@@ -57,67 +50,112 @@ std::optional<double> TimeSeriesAnalysis::standardDeviation() const {
 }
 
 std::optional<double> TimeSeriesAnalysis::skewness() const {
-    if (!cachedSkewness_) {
-        try {
-            double v = ts::analysis::stats::skewness(view_);
-            if (!std::isfinite(v)) return std::nullopt;
-            cachedSkewness_ = v;
-        } catch (const std::exception&) {
-            return std::nullopt;
-        }
-    }
-    return cachedSkewness_;
+    double v = moments().skewness();
+    if (!std::isfinite(v)) return std::nullopt;
+    return v;
 }
 
 std::optional<double> TimeSeriesAnalysis::kurtosis() const {
-    if (!cachedKurtosis_) {
-        try {
-            double v = ts::analysis::stats::kurtosis(view_);
-            if (!std::isfinite(v)) return std::nullopt;
-            cachedKurtosis_ = v;
-        } catch (const std::exception&) {
-            // Fewer than four observations — kurtosis is undefined.
-            return std::nullopt;
+    try {
+        double v = moments().kurtosis();
+        if (!std::isfinite(v)) return std::nullopt;
+        return v;
+    } catch (const std::exception&) {
+        // Fewer than four observations — kurtosis is undefined.
+        return std::nullopt;
+    }
+}
+
+const stats::TDigest& TimeSeriesAnalysis::quantileSketch() const {
+    if (!cachedSketch_) {
+        stats::TDigest sketch;
+        const ValidityMask valid = view_.validity();
+        if (valid.allValid()) {
+            sketch.add(view_);
+        } else {
+            for (size_t i = 0; i < view_.size(); ++i) {
+                if (valid.isValid(i)) sketch.add(view_[i]);
+            }
         }
+        sketch.compress();
+        cachedSketch_ = std::move(sketch);
     }
-    return cachedKurtosis_;
+    return *cachedSketch_;
 }
 
+double TimeSeriesAnalysis::quantile(double q) const { return quantileSketch().quantile(q); }
+
+double TimeSeriesAnalysis::cdf(double x) const { return quantileSketch().cdf(x); }
+
 double TimeSeriesAnalysis::autocorrelation(std::size_t lag) const {
-    if (cachedACF_ && cachedACF_.value().size() > lag) {
-        return cachedACF_.value()[lag];
-    } else {
-        acf(lag);
-        return cachedACF_.value()[lag];
-    }
+    const auto coefficients = acf_(lag);
+    ensure<InvalidArgument>(lag < coefficients.size(), "autocorrelation: lag {} needs more than {} points", lag, size());
+    return coefficients[lag];
 }
 
-const std::vector<double>& TimeSeriesAnalysis::acf(std::size_t maxLag) const {
-    if (!cachedACF_ || cachedACF_.value().empty() || (cachedACF_.value().size() - 1) < maxLag) {
-        // TODO(JB) Add Optimization of just adding the new ones rather that recalculating everything
-        cachedACF_ = stats::acf(view_, maxLag);
-    }
-    return cachedACF_.value();
+std::vector<double> TimeSeriesAnalysis::acf(std::size_t maxLag) const {
+    const auto values = acf_(maxLag);
+    return {values.begin(), values.end()};
+}
+
+std::vector<double> TimeSeriesAnalysis::autocovariances(size_t maxLag) const {
+    const auto values = autocovariances_(maxLag);
+    return {values.begin(), values.end()};
 }
 
-const std::vector<double>& TimeSeriesAnalysis::autocovariances(size_t maxLag) const {
-    if (!cachedAutocovariances_ || cachedAutocovariances_.value().empty() ||
-        (cachedAutocovariances_.value().size() - 1) < maxLag) {
-        cachedAutocovariances_ = ts::analysis::stats::autocovariances(view_, maxLag);
+std::span<const double> TimeSeriesAnalysis::acf_(std::size_t maxLag) const {
+    if (cachedACF_.size() <= maxLag) {
+        // Normalised off the autocovariance cache, so both grow together and only new lags
+        // cost anything.
+        const auto gamma = autocovariances_(maxLag);
+        cachedACF_.reserve(gamma.size());
+        for (size_t lag = cachedACF_.size(); lag < gamma.size(); ++lag) {
+            cachedACF_.push_back(gamma[0] == 0.0 ? 0.0 : gamma[lag] / gamma[0]);
+        }
     }
-    return cachedAutocovariances_.value();
+    return std::span<const double>(cachedACF_).first(std::min(cachedACF_.size(), maxLag + 1));
+}
+
+std::span<const double> TimeSeriesAnalysis::autocovariances_(size_t maxLag) const {
+    if (cachedAutocovariances_.size() <= maxLag) stats::extendAutocovariances(view_, cachedAutocovariances_, maxLag);
+    return std::span<const double>(cachedAutocovariances_).first(std::min(cachedAutocovariances_.size(), maxLag + 1));
+}
+
+stats::DurbinLevinson TimeSeriesAnalysis::durbinLevinson(size_t maxLag) const {
+    stats::DurbinLevinson result = stats::durbinLevinson(autocovariances_(maxLag), maxLag);
+    // The cache holds lag sums; dividing by n gives the usual biased autocovariance scale.
+    const auto n = static_cast<double>(size());
+    for (double& variance : result.innovationVariances) variance /= n;
+    return result;
+}
+
+std::vector<double> TimeSeriesAnalysis::pacf(size_t maxLag) const {
+    return stats::durbinLevinson(autocovariances_(maxLag), maxLag).partialAutocorrelations;
 }
 
 Eigen::MatrixXd TimeSeriesAnalysis::toeplitz(size_t maxLag) {
-    if (!cachedToeplitz_ || (cachedToeplitz_.value().rows() - 1) < maxLag) {
-        if (!cachedAutocovariances_ || cachedAutocovariances_.value().empty() ||
-            (cachedAutocovariances_.value().size() - 1) < maxLag) {
-            cachedAutocovariances_ = ts::analysis::stats::autocovariances(view_, maxLag);
+    const auto cached = static_cast<size_t>(cachedToeplitz_.rows());
+    if (cached < maxLag) {
+        const auto gamma = autocovariances_(maxLag);
+        ensure(gamma.size() >= maxLag,
+               "autocovariances size {} is smaller than the toeplitz matrix requires ({})",
+               gamma.size(),
+               maxLag);
+        // Keep the cached top-left block and fill in only the new rows and columns.
+        const auto dim = static_cast<Eigen::Index>(maxLag);
+        cachedToeplitz_.conservativeResize(dim, dim);
+        for (size_t j = cached; j < maxLag; ++j) {
+            for (size_t i = 0; i <= j; ++i) {
+                const double value = gamma[j - i];
+                cachedToeplitz_(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(j)) = value;
+                cachedToeplitz_(static_cast<Eigen::Index>(j), static_cast<Eigen::Index>(i)) = value;
+            }
         }
-        cachedToeplitz_ = ts::analysis::stats::toeplitzFromAutocovariances(cachedAutocovariances_.value(), maxLag);
     }
-    return cachedToeplitz_.value();
+    const auto dim = static_cast<Eigen::Index>(maxLag);
+    return cachedToeplitz_.topLeftCorner(dim, dim);
 }
+
 double TimeSeriesAnalysis::zScore(double value) const {
     double mu = mean();
     auto sigma = standardDeviation();
@@ -156,20 +194,17 @@ std::string TimeSeriesAnalysis::toString(const fmt::FormatSpec& spec) const {
     auto squared = [&](const std::optional<double>& v) { return fmt::naOr(v, spec.precision); };
     auto shape = [&](const std::optional<double>& v) { return fmt::naOr(v, spec.precision >= 0 ? spec.precision : 4); };
 
-    // Non-finite entries are excluded from the extrema for the same reason the stats
-    // functions skip them: one NaN would otherwise decide the whole comparison.
+    // The extrema come out of the same pass as the moments, which skips what the stats
+    // functions skip (missing lanes, or non-finite values without a bitmap): one NaN would
+    // otherwise decide the whole comparison.
+    const stats::Moments& m = moments();
     std::optional<double> minimum;
     std::optional<double> maximum;
-    size_t nonFinite = 0;
-    for (double v : samples) {
-        if (!std::isfinite(v)) {
-            ++nonFinite;
-            continue;
-        }
-        minimum = minimum ? std::min(*minimum, v) : v;
-        maximum = maximum ? std::max(*maximum, v) : v;
+    if (m.count != 0) {
+        minimum = m.min;
+        maximum = m.max;
     }
-    if (nonFinite != 0) table.addRow({"non-finite", std::format("{}", nonFinite)});
+    if (m.count != n) table.addRow({view_.hasValidity() ? "missing" : "non-finite", std::format("{}", n - m.count)});
 
     table.addRow({"mean", value(mean())});
     // standardDeviation() is derived from the population variance — labelled as it is computed.
@@ -203,16 +238,11 @@ void TimeSeriesAnalysis::describe(size_t autocorrelationLags) const {
 }
 
 void TimeSeriesAnalysis::invalidateCache() {
-    cachedMean_.reset();
-    cachedVarianceSample_.reset();
-    cachedVariancePopulation_.reset();
-    cachedKurtosis_.reset();
-    cachedSkewness_.reset();
-    cachedToeplitz_.reset();
-    if (cachedACF_) cachedACF_.value().clear();
-    cachedACF_.reset();
-    if (cachedAutocovariances_) cachedAutocovariances_.value().clear();
-    cachedAutocovariances_.reset();
+    cachedMoments_.reset();
+    cachedSketch_.reset();
+    cachedToeplitz_.resize(0, 0);
+    cachedACF_.clear();
+    cachedAutocovariances_.clear();
 }
 
 }  // namespace ts::analysis
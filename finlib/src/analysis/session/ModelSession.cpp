@@ -3,6 +3,7 @@
 #include "finlib/analysis/session/ModelSession.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <format>
@@ -17,6 +18,7 @@
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/Format.hpp"
 #include "finlib/common/Log.hpp"
+#include "finlib/core/SegmentedTimeSeries.hpp"
 #include "finlib/core/TimeSeries.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
 #include "finlib/data/SeriesKey.hpp"
@@ -54,13 +56,24 @@ void ModelSession::observe(double value, Timestamp timestamp) {
         logging::warn("Timestamp generated does not match any timestamp at which the actual value was received");
     }
     entry.actualValue = value;
-    writeBuffer_.push_back(std::pair<Timestamp, double>(timestamp, value));
+    // The buffer only takes increasing timestamps; a repeated or earlier one closes the batch
+    // and starts the next, where the repository's merge lets the newer value win.
+    if (!writeBuffer_.empty() && timestamp <= writeBuffer_.back()) {
+        sealedBatches_.push_back(
+            std::exchange(writeBuffer_, SegmentedTimeSeries(model_->getViewTimeSeriesId(), writeBufferCapacity_ + 1)));
+        flush_();
+    }
+    writeBuffer_.append(timestamp, value);
     if (writeBuffer_.size() > writeBufferCapacity_) flush_();
     double error = value - entry.predictedValue;
 
     runningSumSquaredError_ += error * error;
     runningSumAbsoluteError_ += std::abs(error);
     ++observationCount_;
+    if (observedEwma_) {
+        observedEwma_->push(value);
+        errorEwma_->push(error);
+    }
 
     // TODO(JBBLET) Change this to not use a copy of the window_ go from O(windowSize_) to O(1) using head pointers;
     window_.head(windowSize_ - 1) = window_.tail(windowSize_ - 1).eval();
@@ -109,6 +122,12 @@ bool ModelSession::shouldRefit(double mseTreshold) const {
     return (rollingMSE(errorTrackingWindowSize_) > mseTreshold);
 }
 
+void ModelSession::trackEwma(analysis::stats::EwmaParameters params) {
+    observedEwma_.emplace(params);
+    params.demean = false;
+    errorEwma_.emplace(params);
+}
+
 void ModelSession::refit(const TimeSeriesView& newData) {
     flush_();
     model_ = model_->refitted(newData);
@@ -141,7 +160,9 @@ std::string ModelSession::toString(const fmt::FormatSpec& spec) const {
     table.addRow({"predictions tracked", std::format("{}", predictionContainer_.size())});
     table.addRow({"matched to actuals", std::format("{}", matched)});
     table.addRow({"awaiting actuals", std::format("{}", outstanding)});
-    table.addRow({"unflushed writes", std::format("{}/{}", writeBuffer_.size(), writeBufferCapacity_)});
+    size_t unflushed = writeBuffer_.size();
+    for (const SegmentedTimeSeries& batch : sealedBatches_) unflushed += batch.size();
+    table.addRow({"unflushed writes", std::format("{}/{}", unflushed, writeBufferCapacity_)});
     table.addRule();
 
     // Lifetime figures divide the running sums; the rolling pair only looks at the tracking
@@ -156,6 +177,17 @@ std::string ModelSession::toString(const fmt::FormatSpec& spec) const {
                   matched == 0 ? "N/A" : fmt::formatDouble(rollingMSE(errorTrackingWindowSize_), spec.precision)});
     table.addRow({std::format("MAE (last {})", errorTrackingWindowSize_),
                   matched == 0 ? "N/A" : fmt::formatDouble(rollingMAE(errorTrackingWindowSize_), spec.precision)});
+    if (errorEwma_) {
+        const double halfLife = errorEwma_->parameters().halfLife();
+        const auto ewmaCell = [&](double v) {
+            return std::isnan(v) ? std::string("N/A") : fmt::formatDouble(v, spec.precision);
+        };
+        table.addRow({std::format("MSE (EWMA, half-life {})", fmt::formatDouble(halfLife, 1)),
+                      ewmaCell(errorEwma_->variance())});
+        // Of the observed levels, not of their returns: the session never differences them.
+        table.addRow({std::format("observed std (EWMA, half-life {})", fmt::formatDouble(halfLife, 1)),
+                      ewmaCell(observedEwma_->standardDeviation())});
+    }
 
     out += table.render();
     return out;
@@ -164,26 +196,23 @@ std::string ModelSession::toString(const fmt::FormatSpec& spec) const {
 void ModelSession::println(const fmt::FormatSpec& spec) const { std::println("{}", toString(spec)); }
 
 void ModelSession::flush_() {
-    if (writeBuffer_.empty()) return;
-
-    Timestamps timestamps;
-    std::vector<double> values;
-    timestamps.reserve(writeBuffer_.size());
-    values.reserve(writeBuffer_.size());
-    for (const auto& [ts, val] : writeBuffer_) {
-        timestamps.push_back(ts);
-        values.push_back(val);
-    }
+    if (sealedBatches_.empty() && writeBuffer_.empty()) return;
 
     SeriesKey key{model_->getViewTimeSeriesId(), deltaT_};
-    TimeSeries ts(key.SeriesId, std::move(timestamps), std::move(values));
-
-    try {
-        context_.saver_->merge(key, ts);
-    } catch (...) {
-        logging::error("Could not Save to the repository");
-        return;
+    // Stops at the first failure: whatever is left stays buffered, in order, for the next flush.
+    const auto save = [&](const SegmentedTimeSeries& batch) {
+        try {
+            context_.saver_->merge(key, batch.compact());
+            return true;
+        } catch (...) {
+            logging::error("Could not Save to the repository");
+            return false;
+        }
+    };
+    for (; !sealedBatches_.empty(); sealedBatches_.pop_front()) {
+        if (!save(sealedBatches_.front())) return;
     }
-    writeBuffer_.clear();
+    if (writeBuffer_.empty() || !save(writeBuffer_)) return;
+    writeBuffer_ = SegmentedTimeSeries(key.SeriesId, writeBufferCapacity_ + 1);
 }
 }  // namespace ts
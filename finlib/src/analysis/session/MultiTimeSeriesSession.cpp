@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <format>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -16,6 +17,7 @@
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/Format.hpp"
 #include "finlib/common/Log.hpp"
+#include "finlib/common/Memory.hpp"
 #include "finlib/core/TimeSeries.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
 
@@ -76,6 +78,13 @@ void MultiTimeSeriesSession::setFrequency(Timestamp freqMs) {
     invalidateAll_();
 }
 
+void MultiTimeSeriesSession::setMemoryResource(std::pmr::memory_resource* resource) {
+    logging::debug("setMemoryResource");
+    for (auto& [name, session] : sessions_) session->setMemoryResource(resource);
+    resource_ = resource;
+    invalidateAll_();
+}
+
 // ---------------------------------------------------------------------------
 // Sub-session access
 // ---------------------------------------------------------------------------
@@ -218,8 +227,11 @@ std::unordered_map<std::string, std::shared_ptr<const TimeSeries>> MultiTimeSeri
 
 void MultiTimeSeriesSession::buildCross_(const std::string& name) const {
     logging::debug("buildCross_ '{}'", name);
+    const memory::ScopedResource scope(resource_ != nullptr ? resource_ : memory::currentResource());
     auto aligned = buildAligned_(name);
-    crossCaches_[name] = std::make_shared<const TimeSeries>(crossTransforms_.at(name).crossTransform(aligned));
+    crossCaches_[name] = std::allocate_shared<TimeSeries>(
+        std::pmr::polymorphic_allocator<TimeSeries>(memory::currentResource()),
+        crossTransforms_.at(name).crossTransform(aligned));
 }
 
 void MultiTimeSeriesSession::invalidateAll_() {
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -15,6 +16,7 @@
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/Format.hpp"
 #include "finlib/common/Log.hpp"
+#include "finlib/common/Memory.hpp"
 #include "finlib/core/TimeSeries.hpp"
 #include "finlib/data/TimeRange.hpp"
 
@@ -45,10 +47,10 @@ TimeSeriesSession::TimeSeriesSession(std::shared_ptr<TimeSeriesService> service,
 
 TimeSeriesSession::TimeSeriesSession(std::shared_ptr<const TimeSeries> precomputed)
     : service_{nullptr}, source_{std::move(precomputed)}, seriesId_{source_->getId()} {
-    const auto ts = source_->getTimestamps();
-    ensure<InvalidArgument>(!ts.empty(), "Cannot create TimeSeriesSession from empty TimeSeries");
-    startMs_ = ts.front();
-    endMs_ = ts.back();
+    ensure<InvalidArgument>(source_->size() != 0, "Cannot create TimeSeriesSession from empty TimeSeries");
+    const auto& grid = *source_->getSharedTimestamps();
+    startMs_ = grid[source_->tsOffset()];
+    endMs_ = grid[source_->tsOffset() + source_->size() - 1];
 }
 
 // ---------------------------------------------------------------------------
@@ -72,6 +74,15 @@ void TimeSeriesSession::setFrequency(Timestamp newFrequencyMs) {
     invalidateAllCache_();
 }
 
+void TimeSeriesSession::setMemoryResource(std::pmr::memory_resource* resource) {
+    if (resource == resource_) return;
+    logging::debug("setMemoryResource");
+    // The source was loaded outside any request and survives the swap; only what was built on
+    // the old resource goes.
+    resource_ = resource;
+    invalidateAllCache_();
+}
+
 void TimeSeriesSession::addTransform(std::string name, DerivedTransform transform) {
     logging::debug("addTransform '{}' (source → derived)", name);
     transforms_[name] =
@@ -223,8 +234,9 @@ void TimeSeriesSession::extendRange_(Timestamp newStartMs, Timestamp newEndMs) {
     } else {
         // Grid-built session with no fixed frequency: refetch native data, capping the bucket
         // resolution at the current source's spacing.
-        const auto sp = source_->getTimestamps();
-        Timestamp freq = (sp.size() >= 2) ? (sp[1] - sp[0]) : 86'400'000LL;
+        const auto& grid = *source_->getSharedTimestamps();
+        const size_t first = source_->tsOffset();
+        Timestamp freq = (source_->size() >= 2) ? (grid[first + 1] - grid[first]) : 86'400'000LL;
         if (freq <= 0) freq = 86'400'000LL;
         source_ = std::make_shared<const TimeSeries>(service_->getRaw(seriesId_, newStartMs, newEndMs, freq));
     }
@@ -257,6 +269,7 @@ void TimeSeriesSession::invalidateAllCache_() {
 
 void TimeSeriesSession::buildDerived_(const std::string& name) const {
     logging::debug("buildDerived_ '{}'", name);
+    const memory::ScopedResource scope(resource_ != nullptr ? resource_ : memory::currentResource());
     const SeriesNode& leaf = transforms_.at(name);
     std::unordered_map<std::string, std::shared_ptr<const TimeSeries>> inputMap;
     inputMap.reserve(leaf.inputs.size());
@@ -273,7 +286,8 @@ void TimeSeriesSession::buildDerived_(const std::string& name) const {
             inputMap.emplace(dep, derivedCaches_.at(dep));
         }
     }
-    derivedCaches_[name] = std::make_shared<const TimeSeries>(leaf.transform(std::move(inputMap)));
+    derivedCaches_[name] = std::allocate_shared<TimeSeries>(
+        std::pmr::polymorphic_allocator<TimeSeries>(memory::currentResource()), leaf.transform(std::move(inputMap)));
 }
 
 }  // namespace ts::analysis
@@ -5,9 +5,11 @@
 #include <matplot/matplot.h>
 
 #include <algorithm>
+#include <cmath>
 #include <format>
 #include <iterator>
 #include <print>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,7 +17,9 @@
 #include "finlib/common/Error.hpp"
 #include "finlib/common/Format.hpp"
 #include "finlib/common/Log.hpp"
+#include "finlib/core/Moments.hpp"
 #include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TDigest.hpp"
 #include "matplot/axes_objects/histogram.h"
 #include "matplot/freestanding/axes_functions.h"
 
@@ -27,54 +31,78 @@ Distribution::Distribution(std::string id, std::vector<double> v) : id_{std::mov
     if (!std::is_sorted(sorted_.begin(), sorted_.end())) std::sort(sorted_.begin(), sorted_.end());
 }
 
+Distribution::Distribution(std::string id, stats::TDigest sketch, stats::Moments moments)
+    : id_{std::move(id)}, sketch_{std::move(sketch)}, moments_{moments} {
+    ensure<InvalidArgument>(moments_.count == sketch_->count(),
+                            "Distribution '{}': moments cover {} samples, the sketch {}",
+                            id_,
+                            moments_.count,
+                            sketch_->count());
+}
+
 double Distribution::quantile(double q) const {
-    ensure(!sorted_.empty(), "Quantile of an empty distribution");
+    ensure(!empty(), "Quantile of an empty distribution");
     ensure(q >= 0.0 && q <= 1.0, "Quantile value {} invalid", q);
+    if (sketch_) return sketch_->quantile(q);
     return stats::quantileSorted(sorted_, q);
 }
 
-double Distribution::mean() const { return stats::mean(sorted_); }
+double Distribution::mean() const { return sketch_ ? moments_.mean : stats::mean(sorted_); }
 
-double Distribution::stddev() const { return stats::standardDeviation(sorted_, stats::VarianceType::Sample); }
+double Distribution::stddev() const {
+    if (sketch_) return std::sqrt(moments_.variance(stats::VarianceType::Sample));
+    return stats::standardDeviation(sorted_, stats::VarianceType::Sample);
+}
 
 double Distribution::min() const {
-    ensure(!sorted_.empty(), "Minimum of an empty distribution");
-    return sorted_.front();
+    ensure(!empty(), "Minimum of an empty distribution");
+    return sketch_ ? sketch_->min() : sorted_.front();
 }
 
 double Distribution::max() const {
-    ensure(!sorted_.empty(), "Maximum of an empty distribution");
-    return sorted_.back();
+    ensure(!empty(), "Maximum of an empty distribution");
+    return sketch_ ? sketch_->max() : sorted_.back();
 }
 
 double Distribution::cdf(double x) const {
+    if (sketch_) return sketch_->cdf(x);
     if (sorted_.empty()) return 0.0;
     const auto it = std::upper_bound(sorted_.begin(), sorted_.end(), x);
     return static_cast<double>(std::distance(sorted_.begin(), it)) / static_cast<double>(sorted_.size());
 }
 
 void Distribution::plot() const {
+    // A sketch has no samples to bin; equally spaced quantiles carry the same shape.
+    std::vector<double> sketchQuantiles;
+    if (sketch_ && !sketch_->empty()) {
+        constexpr std::size_t kPoints = 1000;
+        sketchQuantiles.reserve(kPoints);
+        for (std::size_t k = 0; k < kPoints; ++k) {
+            sketchQuantiles.push_back(sketch_->quantile((static_cast<double>(k) + 0.5) / kPoints));
+        }
+    }
+    const std::vector<double>& points = sketch_ ? sketchQuantiles : sorted_;
     auto f = matplot::figure(true);
     auto a = matplot::histogram::binning_algorithm::automatic;
     logging::info("Distribution Plot {}", id_);
     matplot::subplot(2, 1, 1);
-    auto h = matplot::hist(sorted_, a, matplot::histogram::normalization::count);
+    auto h = matplot::hist(points, a, matplot::histogram::normalization::count);
     f->draw();
     matplot::title("Histogram of {} Distribution", id_);
     matplot::subplot(2, 1, 2);
-    auto cdfPlot = matplot::hist(sorted_, a, matplot::histogram::normalization::cdf);
+    auto cdfPlot = matplot::hist(points, a, matplot::histogram::normalization::cdf);
     matplot::title("Cumulative Distribution Function (CDF) of {}", id_);
     f->draw();
     matplot::show();
 }
 
 std::string Distribution::toString(const fmt::FormatSpec& spec) const {
-    std::string identity = std::format("Distribution '{}' [n={}", id_, sorted_.size());
-    if (!sorted_.empty()) {
-        identity += std::format(", {} .. {}",
-                                fmt::formatDouble(sorted_.front(), spec.precision),
-                                fmt::formatDouble(sorted_.back(), spec.precision));
+    std::string identity = std::format("Distribution '{}' [n={}", id_, size());
+    if (!empty()) {
+        identity += std::format(
+            ", {} .. {}", fmt::formatDouble(min(), spec.precision), fmt::formatDouble(max(), spec.precision));
     }
+    if (sketch_) identity += std::format(", sketched: {} centroids", sketch_->centroids().size());
     identity += ']';
 
     switch (spec.mode) {
@@ -84,8 +112,10 @@ std::string Distribution::toString(const fmt::FormatSpec& spec) const {
         case fmt::FormatMode::Tail:
         case fmt::FormatMode::Repr:
             // Sorted samples have no index of their own worth showing, so the row listing
-            // reuses the series renderer with no timestamps.
-            return fmt::renderSeries(identity, {}, sorted_, spec);
+            // reuses the series renderer with no timestamps. A sketch has no rows to list and
+            // falls through to the summary table.
+            if (!sketch_) return fmt::renderSeries(identity, {}, sorted_, spec);
+            break;
         default:
             break;
     }
@@ -94,19 +124,21 @@ std::string Distribution::toString(const fmt::FormatSpec& spec) const {
     out += '\n';
 
     fmt::Table table({"statistic", "value"}, {fmt::Table::Align::Left, fmt::Table::Align::Right});
-    table.addRow({"count", std::format("{}", sorted_.size())});
-    if (sorted_.empty()) {
+    table.addRow({"count", std::format("{}", size())});
+    if (empty()) {
         out += table.render();
         return out;
     }
 
     // The old fixed .2f rendered a whole drawdown distribution as zeros — the scale here
-    // has to come from the samples.
-    const auto value = fmt::columnFormat(sorted_, spec.precision);
+    // has to come from the samples (or, sketched, from the quantiles that stand in for them).
+    std::vector<double> sketchQuartiles;
+    if (sketch_) sketchQuartiles = {min(), quantile(0.25), quantile(0.5), quantile(0.75), max()};
+    const auto value = fmt::columnFormat(sketch_ ? std::span<const double>(sketchQuartiles) : samples(), spec.precision);
 
     table.addRow({"mean", value(mean())});
     // stddev() is the sample estimate, which throws on a single observation.
-    if (sorted_.size() < 2) {
+    if (size() < 2) {
         table.addRow({"std", "N/A"});
         table.addRow({"variance", "N/A"});
     } else {
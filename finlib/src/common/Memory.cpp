@@ -0,0 +1,47 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#include "finlib/common/Memory.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace ts::memory {
+namespace {
+// nullptr = nothing installed, so the process default is read at call time rather than frozen
+// when the thread starts.
+thread_local std::pmr::memory_resource* tCurrent = nullptr;
+}  // namespace
+
+std::pmr::memory_resource* currentResource() noexcept {
+    return tCurrent != nullptr ? tCurrent : std::pmr::get_default_resource();
+}
+
+// ---------------------------------------------------------------------------
+// ScopedResource
+// ---------------------------------------------------------------------------
+ScopedResource::ScopedResource(std::pmr::memory_resource* resource) noexcept : previous_(tCurrent) {
+    tCurrent = resource;
+}
+
+ScopedResource::~ScopedResource() { tCurrent = previous_; }
+
+// ---------------------------------------------------------------------------
+// RequestArena
+// ---------------------------------------------------------------------------
+RequestArena::RequestArena(size_t initialSize, std::pmr::memory_resource* upstream) : arena_(initialSize, upstream) {}
+
+void RequestArena::release() {
+    arena_.release();
+    bytesAllocated_ = 0;
+}
+
+void* RequestArena::do_allocate(size_t bytes, size_t alignment) {
+    void* p = arena_.allocate(bytes, alignment);
+    bytesAllocated_ += bytes;
+    return p;
+}
+
+void RequestArena::do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/) {}
+
+bool RequestArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept { return this == &other; }
+
+}  // namespace ts::memory
@@ -0,0 +1,180 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#include "finlib/common/TimestampGrid.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "finlib/common/Error.hpp"
+#include "finlib/common/FinlibTypes.hpp"
+
+namespace ts {
+namespace {
+// splitmix64 finaliser: every input bit reaches every output bit.
+constexpr uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Point-by-point, deliberately bypassing the fingerprint shortcut in matches().
+bool samePoints(const TimestampGrid& a, const TimestampGrid& b) {
+    if (a.size() != b.size()) return false;
+    if (a.isRegular() && b.isRegular()) return a.empty() || (a.front() == b.front() && a.step() == b.step());
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// constructor
+// ---------------------------------------------------------------------------
+TimestampGrid::TimestampGrid(Timestamps timestamps) : points_(std::move(timestamps)) {}
+
+TimestampGrid::TimestampGrid(Timestamp start, Timestamp step, size_t count)
+    : regular_(true), start_(start), step_(step), count_(count) {
+    ensure<InvalidArgument>(step_ > 0, "TimestampGrid: regular step must be positive, got {}", step_);
+}
+
+// ---------------------------------------------------------------------------
+// Search
+// ---------------------------------------------------------------------------
+size_t TimestampGrid::lowerBound(Timestamp ts, size_t first, size_t last) const {
+    last = std::min(last, size());
+    first = std::min(first, last);
+    if (!regular_) {
+        const auto it = std::lower_bound(points_.begin() + first, points_.begin() + last, ts);
+        return static_cast<size_t>(std::distance(points_.begin(), it));
+    }
+    // The difference goes through uint64_t: ts - start_ does not fit in int64 when the caller
+    // passes an open bound such as INT64_MAX against a negative start.
+    size_t idx = 0;
+    if (ts > start_) {
+        const uint64_t diff = static_cast<uint64_t>(ts) - static_cast<uint64_t>(start_);
+        const uint64_t steps = static_cast<uint64_t>(step_);
+        const uint64_t ceil = diff / steps + (diff % steps != 0 ? 1 : 0);
+        idx = static_cast<size_t>(std::min<uint64_t>(ceil, count_));
+    }
+    return std::clamp(idx, first, last);
+}
+
+size_t TimestampGrid::upperBound(Timestamp ts, size_t first, size_t last) const {
+    last = std::min(last, size());
+    first = std::min(first, last);
+    if (!regular_) {
+        const auto it = std::upper_bound(points_.begin() + first, points_.begin() + last, ts);
+        return static_cast<size_t>(std::distance(points_.begin(), it));
+    }
+    size_t idx = 0;
+    if (ts >= start_) {
+        const uint64_t diff = static_cast<uint64_t>(ts) - static_cast<uint64_t>(start_);
+        idx = static_cast<size_t>(std::min<uint64_t>(diff / static_cast<uint64_t>(step_) + 1, count_));
+    }
+    return std::clamp(idx, first, last);
+}
+
+bool TimestampGrid::matches(size_t offset, const TimestampGrid& other, size_t otherOffset, size_t n) const {
+    if (n == 0) return true;
+    if (offset + n > size() || otherOffset + n > other.size()) return false;
+    if (this == &other && offset == otherOffset) return true;
+    if (regular_ && other.regular_) {
+        return (*this)[offset] == other[otherOffset] && (n == 1 || step_ == other.step_);
+    }
+    // Whole grid against whole grid — what two resampled series on equal-content grids compare.
+    // The cheap end points first, then the cached fingerprints, which reject different grids in
+    // O(1) after one hashing pass each. Agreeing fingerprints are only a strong hint, so equality
+    // is still confirmed point by point below; intern() spares equal grids even that.
+    if (offset == 0 && otherOffset == 0 && n == size() && n == other.size()) {
+        if (front() != other.front() || back() != other.back() || fingerprint() != other.fingerprint()) return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if ((*this)[offset + i] != other[otherOffset + i]) return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Fingerprint & interning
+// ---------------------------------------------------------------------------
+uint64_t TimestampGrid::fingerprint() const {
+    std::call_once(fingerprintOnce_, [this] {
+        // Indexed, so a regular grid hashes the same points as its explicit twin without being
+        // materialised.
+        uint64_t hash = mix(static_cast<uint64_t>(size()));
+        for (size_t i = 0; i < size(); ++i) hash = mix(hash ^ static_cast<uint64_t>((*this)[i]));
+        fingerprint_ = hash;
+        if (regular_ || size() < 2) return;
+        // Spacing rides along: an evenly spaced explicit grid resamples as cheaply as a regular one.
+        const Timestamp gap = points_[1] - points_[0];
+        bool uniform = gap > 0;
+        for (size_t i = 2; uniform && i < size(); ++i) uniform = points_[i] - points_[i - 1] == gap;
+        uniformStep_ = uniform ? gap : 0;
+    });
+    return fingerprint_;
+}
+
+Timestamp TimestampGrid::uniformStep() const {
+    if (regular_) return step_;
+    fingerprint();
+    return uniformStep_;
+}
+
+TimestampsPtr TimestampGrid::intern(TimestampsPtr grid) {
+    if (!grid) return grid;
+    // A regular grid is keyed on its three numbers, so interning one stays O(1); an explicit grid
+    // on its fingerprint, hashed outside the lock. The two kinds never share a key by design —
+    // an explicit grid that happens to be evenly spaced stays a distinct (still equal) object.
+    const uint64_t key = grid->regular_ ? mix(mix(mix(static_cast<uint64_t>(grid->start_)) ^
+                                                  static_cast<uint64_t>(grid->step_)) ^
+                                              static_cast<uint64_t>(grid->count_))
+                                        : grid->fingerprint();
+
+    static std::mutex mutex;
+    static std::unordered_multimap<uint64_t, std::weak_ptr<const TimestampGrid>> table;
+
+    const std::lock_guard lock(mutex);
+    const auto [first, last] = table.equal_range(key);
+    for (auto it = first; it != last;) {
+        auto candidate = it->second.lock();
+        if (!candidate) {
+            it = table.erase(it);
+            continue;
+        }
+        // Interning is where a fingerprint collision would do lasting harm, so the content is
+        // compared in full here, once, instead of on every later alignment check.
+        if (samePoints(*candidate, *grid)) return candidate;
+        ++it;
+    }
+    // Expired entries under other keys are swept whenever the table has doubled since the last
+    // sweep, keeping it proportional to the grids actually alive.
+    static size_t sweepAt = 64;
+    if (table.size() >= sweepAt) {
+        std::erase_if(table, [](const auto& entry) { return entry.second.expired(); });
+        sweepAt = std::max<size_t>(64, 2 * table.size());
+    }
+    table.emplace(key, grid);
+    return grid;
+}
+
+// ---------------------------------------------------------------------------
+// Private Helpers
+// ---------------------------------------------------------------------------
+const Timestamps& TimestampGrid::materialised_() const {
+    if (!regular_) return points_;
+    std::call_once(materialiseOnce_, [this] {
+        points_.resize(count_);
+        for (size_t i = 0; i < count_; ++i) points_[i] = start_ + static_cast<Timestamp>(i) * step_;
+        materialisedFlag_.store(true, std::memory_order_release);
+    });
+    return points_;
+}
+
+}  // namespace ts
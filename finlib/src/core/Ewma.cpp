@@ -0,0 +1,248 @@
+// Copyright 2026 JBBLET
+#include "finlib/core/Ewma.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "finlib/common/Error.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+
+namespace ts::analysis::stats {
+
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// The moment functions' rule: without a mask the finite samples count, with one the mask decides.
+bool present(Samples x, ValidityMask valid, size_t i) {
+    return valid.allValid() ? std::isfinite(x[i]) : valid.isValid(i);
+}
+
+void ensureMaskFits(Samples x, ValidityMask valid) {
+    if (valid.allValid()) return;
+    ensure<InvalidArgument>(valid.size() == x.size(), "validity mask has {} lanes for {} samples", valid.size(), x.size());
+}
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// EwmaParameters
+// ---------------------------------------------------------------------------
+EwmaParameters EwmaParameters::fromHalfLife(double halfLife, bool biasCorrected, bool demean) {
+    ensure<InvalidArgument>(halfLife > 0.0 && std::isfinite(halfLife), "EWMA half-life must be positive, got {}", halfLife);
+    return {std::pow(0.5, 1.0 / halfLife), biasCorrected, demean};
+}
+
+void EwmaParameters::validate() const {
+    ensure<InvalidArgument>(decay > 0.0 && decay < 1.0, "EWMA decay must lie in (0, 1), got {}", decay);
+}
+
+// ---------------------------------------------------------------------------
+// EwmaCovariance
+// ---------------------------------------------------------------------------
+EwmaCovariance::EwmaCovariance(size_t dimension, EwmaParameters params)
+    : params_(params),
+      mean_(Eigen::VectorXd::Constant(static_cast<Eigen::Index>(dimension), kNaN)),
+      delta_(Eigen::VectorXd::Zero(static_cast<Eigen::Index>(dimension))),
+      m2_(Eigen::MatrixXd::Zero(static_cast<Eigen::Index>(dimension), static_cast<Eigen::Index>(dimension))) {
+    params_.validate();
+}
+
+void EwmaCovariance::push(std::span<const double> row) {
+    ensure<InvalidArgument>(
+        row.size() == dimension(), "EwmaCovariance: row has {} values for {} series", row.size(), dimension());
+    if (!std::all_of(row.begin(), row.end(), [](double v) { return std::isfinite(v); })) {
+        skip();
+        return;
+    }
+    const Eigen::Map<const Eigen::VectorXd> x(row.data(), static_cast<Eigen::Index>(row.size()));
+    age_();
+    weight_ += 1.0;
+    weight2_ += 1.0;
+    if (count_++ == 0) {
+        // The first sample is the mean and has no deviation; starting from it also clears the
+        // NaN the mean reads as until now.
+        mean_ = x;
+        if (!params_.demean) m2_.selfadjointView<Eigen::Lower>().rankUpdate(x, 1.0);
+        return;
+    }
+    delta_.noalias() = x - mean_;
+    mean_.noalias() += delta_ / weight_;
+    // delta · (x - new mean)ᵀ = (1 - 1/W) · delta · deltaᵀ: symmetric, so one triangle is enough.
+    if (params_.demean) {
+        m2_.selfadjointView<Eigen::Lower>().rankUpdate(delta_, 1.0 - 1.0 / weight_);
+    } else {
+        m2_.selfadjointView<Eigen::Lower>().rankUpdate(x, 1.0);
+    }
+}
+
+void EwmaCovariance::skip() { age_(); }
+
+Eigen::MatrixXd EwmaCovariance::covariance() const {
+    Eigen::MatrixXd out = m2_.selfadjointView<Eigen::Lower>();
+    return out * scale_();
+}
+
+double EwmaCovariance::covariance(size_t i, size_t j) const {
+    const auto [row, col] = std::minmax(i, j);
+    return m2_(static_cast<Eigen::Index>(col), static_cast<Eigen::Index>(row)) * scale_();
+}
+
+Eigen::MatrixXd EwmaCovariance::correlation() const {
+    const auto k = static_cast<size_t>(mean_.size());
+    Eigen::MatrixXd out(mean_.size(), mean_.size());
+    for (size_t j = 0; j < k; ++j) {
+        for (size_t i = j; i < k; ++i) {
+            out(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(j)) = correlation(i, j);
+            out(static_cast<Eigen::Index>(j), static_cast<Eigen::Index>(i)) =
+                out(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(j));
+        }
+    }
+    return out;
+}
+
+double EwmaCovariance::correlation(size_t i, size_t j) const {
+    // The scale cancels, so the raw sums are used; it only decides whether anything is defined.
+    if (std::isnan(scale_())) return kNaN;
+    const double vi = m2_(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(i));
+    const double vj = m2_(static_cast<Eigen::Index>(j), static_cast<Eigen::Index>(j));
+    if (!(vi > 0.0 && vj > 0.0)) return kNaN;
+    const auto [row, col] = std::minmax(i, j);
+    return m2_(static_cast<Eigen::Index>(col), static_cast<Eigen::Index>(row)) / std::sqrt(vi * vj);
+}
+
+void EwmaCovariance::age_() {
+    weight_ *= params_.decay;
+    weight2_ *= params_.decay * params_.decay;
+    m2_.triangularView<Eigen::Lower>() *= params_.decay;
+}
+
+double EwmaCovariance::scale_() const {
+    if (count_ == 0) return kNaN;
+    if (!params_.demean || !params_.biasCorrected) return 1.0 / weight_;
+    const double denominator = weight_ * weight_ - weight2_;
+    return denominator > 0.0 ? weight_ / denominator : kNaN;
+}
+
+// ---------------------------------------------------------------------------
+// Batch kernels
+// ---------------------------------------------------------------------------
+std::vector<double> ewma(Samples x, EwmaParameters params, EwmaStatistic stat) {
+    return ewma(x, ValidityMask(), params, stat);
+}
+
+std::vector<double> ewma(Samples x, ValidityMask valid, EwmaParameters params, EwmaStatistic stat) {
+    ensureMaskFits(x, valid);
+    EwmaMoments state(params);
+    std::vector<double> out(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (present(x, valid, i)) {
+            state.push(x[i]);
+        } else {
+            state.skip();
+        }
+        switch (stat) {
+            case EwmaStatistic::Mean: out[i] = state.mean(); break;
+            case EwmaStatistic::Variance: out[i] = state.variance(); break;
+            case EwmaStatistic::StandardDeviation: out[i] = state.standardDeviation(); break;
+        }
+    }
+    return out;
+}
+
+namespace {
+template <typename Read>
+std::vector<double> pairwise(
+    Samples x, ValidityMask validX, Samples y, ValidityMask validY, EwmaParameters params, Read read) {
+    ensure<InvalidArgument>(x.size() == y.size(), "EWMA covariance of {} and {} samples", x.size(), y.size());
+    ensureMaskFits(x, validX);
+    ensureMaskFits(y, validY);
+    EwmaCovariance state(2, params);
+    std::vector<double> out(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (present(x, validX, i) && present(y, validY, i)) {
+            const std::array<double, 2> row{x[i], y[i]};
+            state.push(row);
+        } else {
+            state.skip();
+        }
+        out[i] = read(state);
+    }
+    return out;
+}
+}  // namespace
+
+std::vector<double> ewmaCovariance(Samples x, Samples y, EwmaParameters params) {
+    return ewmaCovariance(x, ValidityMask(), y, ValidityMask(), params);
+}
+
+std::vector<double> ewmaCovariance(
+    Samples x, ValidityMask validX, Samples y, ValidityMask validY, EwmaParameters params) {
+    return pairwise(x, validX, y, validY, params, [](const EwmaCovariance& s) { return s.covariance(0, 1); });
+}
+
+std::vector<double> ewmaCorrelation(Samples x, Samples y, EwmaParameters params) {
+    return ewmaCorrelation(x, ValidityMask(), y, ValidityMask(), params);
+}
+
+std::vector<double> ewmaCorrelation(
+    Samples x, ValidityMask validX, Samples y, ValidityMask validY, EwmaParameters params) {
+    return pairwise(x, validX, y, validY, params, [](const EwmaCovariance& s) { return s.correlation(0, 1); });
+}
+
+EwmaCovariance ewmaCovariance(std::span<const TimeSeriesView> views, EwmaParameters params) {
+    EwmaCovariance state(views.size(), params);
+    if (views.empty()) return state;
+    const TimeSeriesView& first = views.front();
+    const size_t rows = first.size();
+    std::vector<ValidityMask> masks;
+    masks.reserve(views.size());
+    for (const TimeSeriesView& view : views) {
+        ensure<InvalidArgument>(view.size() == rows,
+                                "ewmaCovariance: views must be aligned, '{}' has {} rows, expected {}",
+                                view.getTimeSeriesId(),
+                                view.size(),
+                                rows);
+        // Same length is not enough: row i must be the same instant in every column.
+        ensure<InvalidArgument>(
+            rows == 0 || view.getSharedTimestamps()->matches(
+                             view.tsOffset(), *first.getSharedTimestamps(), first.tsOffset(), rows),
+            "ewmaCovariance: views must be aligned, '{}' is not on the grid of '{}'",
+            view.getTimeSeriesId(),
+            first.getTimeSeriesId());
+        masks.push_back(view.validity());
+    }
+
+    std::vector<double> row(views.size());
+    for (size_t i = 0; i < rows; ++i) {
+        bool complete = true;
+        for (size_t j = 0; j < views.size() && complete; ++j) {
+            row[j] = views[j][i];
+            complete = masks[j].isValid(i);
+        }
+        if (complete) {
+            state.push(row);
+        } else {
+            state.skip();
+        }
+    }
+    return state;
+}
+
+EwmaCovariance ewmaCovariance(const TimeSeriesPanel& panel, EwmaParameters params) {
+    EwmaCovariance state(panel.cols(), params);
+    // The block is column-major, so each row is gathered into one reused buffer.
+    std::vector<double> row(panel.cols());
+    for (size_t i = 0; i < panel.rows(); ++i) {
+        for (size_t j = 0; j < panel.cols(); ++j) row[j] = panel(i, j);
+        state.push(row);
+    }
+    return state;
+}
+
+}  // namespace ts::analysis::stats
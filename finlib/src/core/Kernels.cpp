@@ -0,0 +1,275 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#include "finlib/core/Kernels.hpp"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "finlib/common/Error.hpp"
+
+// GCC/Clang on x86 can compile AVX2/AVX-512 bodies next to baseline code through target
+// attributes and pick between them at run time. Anything else gets the scalar table only.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define FINLIB_KERNELS_X86 1
+#include <immintrin.h>
+#define FINLIB_TARGET_AVX2 __attribute__((target("avx2")))
+#define FINLIB_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define FINLIB_KERNELS_X86 0
+#endif
+
+namespace ts::kernels {
+namespace {
+
+// ---------------------------------------------------------------------------
+// Scalar bodies — the fallback table and the tails of every vector loop
+// ---------------------------------------------------------------------------
+
+struct AddOp {
+    static double apply(double a, double b) { return a + b; }
+};
+struct SubOp {
+    static double apply(double a, double b) { return a - b; }
+};
+struct MulOp {
+    static double apply(double a, double b) { return a * b; }
+};
+struct DivOp {
+    static double apply(double a, double b) { return a / b; }
+};
+struct MaskedDivOp {
+    static double apply(double a, double b) { return b == 0.0 ? 0.0 : a / b; }
+};
+
+template <typename Op>
+inline void binaryTail(const double* a, const double* b, double* out, size_t i, size_t n) {
+    for (; i < n; ++i) out[i] = Op::apply(a[i], b[i]);
+}
+
+template <typename Op>
+inline void scalarTail(const double* a, double s, double* out, size_t i, size_t n) {
+    for (; i < n; ++i) out[i] = Op::apply(a[i], s);
+}
+
+template <typename Op>
+void binaryScalarIsa(const double* a, const double* b, double* out, size_t n) {
+    binaryTail<Op>(a, b, out, 0, n);
+}
+
+template <typename Op>
+void scalarScalarIsa(const double* a, double s, double* out, size_t n) {
+    scalarTail<Op>(a, s, out, 0, n);
+}
+
+constexpr KernelTable kScalarTable{Isa::Scalar,
+                                   &binaryScalarIsa<AddOp>,
+                                   &binaryScalarIsa<SubOp>,
+                                   &binaryScalarIsa<MulOp>,
+                                   &binaryScalarIsa<MaskedDivOp>,
+                                   &scalarScalarIsa<AddOp>,
+                                   &scalarScalarIsa<SubOp>,
+                                   &scalarScalarIsa<MulOp>,
+                                   &scalarScalarIsa<DivOp>};
+
+#if FINLIB_KERNELS_X86
+
+// One macro per shape keeps the four ISAs textually identical apart from the intrinsics;
+// the bodies cannot be templates because the target attribute has to sit on the function
+// that calls the intrinsics.
+#define FINLIB_BINARY_KERNEL(NAME, ATTR, WIDTH, LOAD, STORE, VOP, TAILOP)                  \
+    ATTR void NAME(const double* a, const double* b, double* out, size_t n) {               \
+        size_t i = 0;                                                                       \
+        for (; i + (WIDTH) <= n; i += (WIDTH)) STORE(out + i, VOP(LOAD(a + i), LOAD(b + i))); \
+        binaryTail<TAILOP>(a, b, out, i, n);                                                \
+    }
+
+#define FINLIB_SCALAR_KERNEL(NAME, ATTR, WIDTH, LOAD, STORE, SET1, VOP, TAILOP)         \
+    ATTR void NAME(const double* a, double s, double* out, size_t n) {                   \
+        const auto broadcast = SET1(s);                                                  \
+        size_t i = 0;                                                                    \
+        for (; i + (WIDTH) <= n; i += (WIDTH)) STORE(out + i, VOP(LOAD(a + i), broadcast)); \
+        scalarTail<TAILOP>(a, s, out, i, n);                                             \
+    }
+
+// SSE2 is part of the x86-64 baseline, so these need no target attribute.
+inline __m128d maskedDivSse2(__m128d x, __m128d y) {
+    const __m128d zero = _mm_cmpeq_pd(y, _mm_setzero_pd());
+    return _mm_andnot_pd(zero, _mm_div_pd(x, y));
+}
+
+#define FINLIB_NO_ATTR
+FINLIB_BINARY_KERNEL(addSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_add_pd, AddOp)
+FINLIB_BINARY_KERNEL(subSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_sub_pd, SubOp)
+FINLIB_BINARY_KERNEL(mulSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_mul_pd, MulOp)
+FINLIB_BINARY_KERNEL(divSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, maskedDivSse2, MaskedDivOp)
+FINLIB_SCALAR_KERNEL(addScalarSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_add_pd, AddOp)
+FINLIB_SCALAR_KERNEL(subScalarSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_sub_pd, SubOp)
+FINLIB_SCALAR_KERNEL(mulScalarSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_mul_pd, MulOp)
+FINLIB_SCALAR_KERNEL(divScalarSse2, FINLIB_NO_ATTR, 2, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_div_pd, DivOp)
+
+FINLIB_TARGET_AVX2 inline __m256d maskedDivAvx2(__m256d x, __m256d y) {
+    const __m256d zero = _mm256_cmp_pd(y, _mm256_setzero_pd(), _CMP_EQ_OQ);
+    return _mm256_andnot_pd(zero, _mm256_div_pd(x, y));
+}
+
+FINLIB_BINARY_KERNEL(addAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, AddOp)
+FINLIB_BINARY_KERNEL(subAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_sub_pd, SubOp)
+FINLIB_BINARY_KERNEL(mulAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_mul_pd, MulOp)
+FINLIB_BINARY_KERNEL(divAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, maskedDivAvx2, MaskedDivOp)
+FINLIB_SCALAR_KERNEL(
+    addScalarAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_add_pd, AddOp)
+FINLIB_SCALAR_KERNEL(
+    subScalarAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_sub_pd, SubOp)
+FINLIB_SCALAR_KERNEL(
+    mulScalarAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_mul_pd, MulOp)
+FINLIB_SCALAR_KERNEL(
+    divScalarAvx2, FINLIB_TARGET_AVX2, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_div_pd, DivOp)
+
+// NEQ_UQ is true for NaN divisors too, so a / NaN stays NaN exactly as in the scalar rule.
+FINLIB_TARGET_AVX512 inline __m512d maskedDivAvx512(__m512d x, __m512d y) {
+    return _mm512_maskz_div_pd(_mm512_cmp_pd_mask(y, _mm512_setzero_pd(), _CMP_NEQ_UQ), x, y);
+}
+
+FINLIB_BINARY_KERNEL(addAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, AddOp)
+FINLIB_BINARY_KERNEL(subAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_sub_pd, SubOp)
+FINLIB_BINARY_KERNEL(mulAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_mul_pd, MulOp)
+FINLIB_BINARY_KERNEL(
+    divAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, maskedDivAvx512, MaskedDivOp)
+FINLIB_SCALAR_KERNEL(
+    addScalarAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_add_pd, AddOp)
+FINLIB_SCALAR_KERNEL(
+    subScalarAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_sub_pd, SubOp)
+FINLIB_SCALAR_KERNEL(
+    mulScalarAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_mul_pd, MulOp)
+FINLIB_SCALAR_KERNEL(
+    divScalarAvx512, FINLIB_TARGET_AVX512, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_div_pd, DivOp)
+
+#undef FINLIB_NO_ATTR
+#undef FINLIB_SCALAR_KERNEL
+#undef FINLIB_BINARY_KERNEL
+
+constexpr KernelTable kSse2Table{Isa::SSE2,
+                                 &addSse2,
+                                 &subSse2,
+                                 &mulSse2,
+                                 &divSse2,
+                                 &addScalarSse2,
+                                 &subScalarSse2,
+                                 &mulScalarSse2,
+                                 &divScalarSse2};
+
+constexpr KernelTable kAvx2Table{Isa::AVX2,
+                                 &addAvx2,
+                                 &subAvx2,
+                                 &mulAvx2,
+                                 &divAvx2,
+                                 &addScalarAvx2,
+                                 &subScalarAvx2,
+                                 &mulScalarAvx2,
+                                 &divScalarAvx2};
+
+constexpr KernelTable kAvx512Table{Isa::AVX512,
+                                   &addAvx512,
+                                   &subAvx512,
+                                   &mulAvx512,
+                                   &divAvx512,
+                                   &addScalarAvx512,
+                                   &subScalarAvx512,
+                                   &mulScalarAvx512,
+                                   &divScalarAvx512};
+
+#endif  // FINLIB_KERNELS_X86
+
+bool isSupported(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar:
+            return true;
+#if FINLIB_KERNELS_X86
+        case Isa::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case Isa::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case Isa::AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+void checkSizes(size_t a, size_t b, size_t out) {
+    ensure<InvalidArgument>(a == b && a == out, "kernels: operand sizes differ ({}, {}, out {})", a, b, out);
+}
+
+}  // namespace
+
+Isa detectedIsa() {
+    for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::SSE2}) {
+        if (isSupported(isa)) return isa;
+    }
+    return Isa::Scalar;
+}
+
+std::vector<Isa> supportedIsas() {
+    std::vector<Isa> out;
+    for (Isa isa : {Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (isSupported(isa)) out.push_back(isa);
+    }
+    return out;
+}
+
+const KernelTable& table(Isa isa) {
+    ensure<InvalidArgument>(isSupported(isa), "kernels: {} is not available on this machine", toString(isa));
+    switch (isa) {
+#if FINLIB_KERNELS_X86
+        case Isa::SSE2:
+            return kSse2Table;
+        case Isa::AVX2:
+            return kAvx2Table;
+        case Isa::AVX512:
+            return kAvx512Table;
+#endif
+        default:
+            return kScalarTable;
+    }
+}
+
+const KernelTable& active() {
+    static const KernelTable& resolved = table(detectedIsa());
+    return resolved;
+}
+
+void add(std::span<const double> a, std::span<const double> b, std::span<double> out) {
+    checkSizes(a.size(), b.size(), out.size());
+    active().add(a.data(), b.data(), out.data(), out.size());
+}
+void sub(std::span<const double> a, std::span<const double> b, std::span<double> out) {
+    checkSizes(a.size(), b.size(), out.size());
+    active().sub(a.data(), b.data(), out.data(), out.size());
+}
+void mul(std::span<const double> a, std::span<const double> b, std::span<double> out) {
+    checkSizes(a.size(), b.size(), out.size());
+    active().mul(a.data(), b.data(), out.data(), out.size());
+}
+void div(std::span<const double> a, std::span<const double> b, std::span<double> out) {
+    checkSizes(a.size(), b.size(), out.size());
+    active().div(a.data(), b.data(), out.data(), out.size());
+}
+void add(std::span<const double> a, double scalar, std::span<double> out) {
+    checkSizes(a.size(), out.size(), out.size());
+    active().addScalar(a.data(), scalar, out.data(), out.size());
+}
+void sub(std::span<const double> a, double scalar, std::span<double> out) {
+    checkSizes(a.size(), out.size(), out.size());
+    active().subScalar(a.data(), scalar, out.data(), out.size());
+}
+void mul(std::span<const double> a, double scalar, std::span<double> out) {
+    checkSizes(a.size(), out.size(), out.size());
+    active().mulScalar(a.data(), scalar, out.data(), out.size());
+}
+void div(std::span<const double> a, double scalar, std::span<double> out) {
+    checkSizes(a.size(), out.size(), out.size());
+    active().divScalar(a.data(), scalar, out.data(), out.size());
+}
+
+}  // namespace ts::kernels
@@ -2,22 +2,29 @@
 #include "finlib/core/Resampling.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
-#include <future>
-#include <iterator>
+#include <cstdint>
+#include <format>
 #include <limits>
 #include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <optional>
 #include <random>
+#include <span>
 #include <stdexcept>
-#include <thread>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "finlib/common/Error.hpp"
+#include "finlib/common/Execution.hpp"
 #include "finlib/common/FinlibTypes.hpp"
+#include "finlib/common/Memory.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 
 namespace ts {
 namespace {
@@ -39,119 +46,315 @@ double bridgeNoiseAt(Timestamp target, Timestamp t1, Timestamp t2, double varian
     return noise() * std::sqrt(varianceRate * bridgeTicks);
 }
 
-double applyStrategy(InterpolationStrategy strategy, BridgeNoise* noise, double varianceRate, Timestamp target,
-                     Timestamp t1, double v1, Timestamp t2, double v2) {
-    const double fraction = static_cast<double>(target - t1) / static_cast<double>(t2 - t1);
-    const double linearVal = v1 + fraction * (v2 - v1);
-    switch (strategy) {
-        case InterpolationStrategy::Linear:
-            return linearVal;
-        case InterpolationStrategy::Stochastic:
+// The value between two present points. One instantiation per strategy, so the strategy is
+// picked once per resample instead of once per target row. Exact never interpolates.
+template <InterpolationStrategy S>
+double interpolate(BridgeNoise* noise, double varianceRate, Timestamp target, Timestamp t1, double v1, Timestamp t2,
+                   double v2) {
+    if constexpr (S == InterpolationStrategy::Nearest) {
+        return (target - t1 < t2 - target) ? v1 : v2;
+    } else if constexpr (S == InterpolationStrategy::Latest || S == InterpolationStrategy::Exact) {
+        return v1;
+    } else {
+        const double fraction = static_cast<double>(target - t1) / static_cast<double>(t2 - t1);
+        const double linearVal = v1 + fraction * (v2 - v1);
+        if constexpr (S == InterpolationStrategy::Stochastic) {
             return noise ? linearVal + bridgeNoiseAt(target, t1, t2, varianceRate, *noise) : linearVal;
-        case InterpolationStrategy::Nearest:
-            return (target - t1 < t2 - target) ? v1 : v2;
-        case InterpolationStrategy::Latest:
-            return v1;
-        case InterpolationStrategy::Exact:
-            return v1;  // handled before this call
+        } else {
+            return linearVal;
+        }
     }
-    return v1;
 }
 
-std::vector<double> partialWalk(const TimeSeries& src, const Timestamps& target, std::size_t startIndex,
-                                std::size_t endIndex, InterpolationStrategy strategy, BridgeNoise* noise,
-                                double varianceRate) {
-    const std::size_t chunkLength = endIndex - startIndex;
-    std::vector<double> newValues(chunkLength);
+// Where one target row falls in the source. Between the present lanes `lower` < `upper`, or on
+// a single lane (lower == upper): before the first / past the last present point, or — for
+// Exact — the lane the walk stands on, which is a hit only when `found`.
+struct Bracket {
+    std::size_t lower;
+    std::size_t upper;
+    bool found = true;
+};
 
-    // Use the span view so tsOffset_ is applied — the shared TimestampsPtr can be longer than
-    // values() when the series came from a slice or an arithmetic operator.
-    const auto span = src.getTimestamps();
-    const auto& values = src.getValues();
-    const std::size_t originalSize = values.size();
+// Walks target rows [startIndex, startIndex + count) against the source, calling
+// visit(row, targetTimestamp, bracket) for each. Shared by the direct resample and by
+// InterpolationPlan, so a plan replays exactly the walk it records. Exact is a template flag so
+// the other strategies' loop carries no test for it.
+template <bool Exact, typename Visit>
+void walk(const TimeSeries& src, const TimestampGrid& target, std::size_t startIndex, std::size_t count,
+          Visit&& visit) {
+    // Index the source grid through tsOffset_ — the shared TimestampsPtr can be longer than
+    // values() when the series came from a slice or an arithmetic operator. Indexing rather
+    // than taking getTimestamps() keeps a regular source grid implicit.
+    const TimestampGrid& grid = *src.getSharedTimestamps();
+    const std::size_t offset = src.tsOffset();
+    const auto srcTs = [&](std::size_t i) { return grid[offset + i]; };
 
-    auto it = std::lower_bound(span.begin(), span.end(), target[startIndex]);
-    std::size_t dataIndex = static_cast<std::size_t>(std::distance(span.begin(), it));
+    // Missing source lanes are stepped over, never interpolated from: the walk moves between
+    // valid lanes only, [first, last] being the valid extent. With no bitmap this is the plain
+    // dataIndex / dataIndex + 1 walk.
+    const auto valid = [&](std::size_t i) { return src.isValid(i); };
+    std::size_t first = 0;
+    while (!valid(first)) ++first;
+    std::size_t last = src.size() - 1;
+    while (!valid(last)) --last;
+    const auto nextValid = [&](std::size_t i) {
+        do ++i;
+        while (!valid(i));
+        return i;
+    };
+
+    std::size_t dataIndex = src.lowerBound(target[startIndex]);
     if (dataIndex > 0) --dataIndex;
+    while (dataIndex > first && !valid(dataIndex)) --dataIndex;
+    dataIndex = std::clamp(dataIndex, first, last);
+    std::size_t next = dataIndex < last ? nextValid(dataIndex) : last;
 
-    for (std::size_t i = 0; i < chunkLength; ++i) {
+    for (std::size_t i = 0; i < count; ++i) {
         const Timestamp currentTarget = target[startIndex + i];
-        while (dataIndex < originalSize - 1 && span[dataIndex + 1] <= currentTarget) ++dataIndex;
+        while (dataIndex < last && srcTs(next) <= currentTarget) {
+            dataIndex = next;
+            next = dataIndex < last ? nextValid(dataIndex) : last;
+        }
 
-        if (strategy == InterpolationStrategy::Exact) {
-            newValues[i] =
-                (span[dataIndex] == currentTarget) ? values[dataIndex] : std::numeric_limits<double>::quiet_NaN();
-            continue;
+        if constexpr (Exact) {
+            visit(i, currentTarget, Bracket{dataIndex, dataIndex, srcTs(dataIndex) == currentTarget});
+        } else if (currentTarget <= srcTs(first)) {
+            visit(i, currentTarget, Bracket{first, first});
+        } else if (dataIndex >= last) {
+            visit(i, currentTarget, Bracket{last, last});
+        } else {
+            visit(i, currentTarget, Bracket{dataIndex, next});
         }
-        if (currentTarget <= span[0]) {
-            newValues[i] = values[0];
-        } else if (dataIndex >= originalSize - 1) {
-            newValues[i] = values.back();
+    }
+}
+
+// Fills target rows [startIndex, startIndex + newValues.size()). Chunks write straight into their
+// slice of the result, so a resample allocates one buffer however many chunks run.
+template <InterpolationStrategy S>
+void partialWalk(const TimeSeries& src, const TimestampGrid& target, std::size_t startIndex,
+                 std::span<double> newValues, BridgeNoise* noise, double varianceRate) {
+    const TimestampGrid& grid = *src.getSharedTimestamps();
+    const std::size_t offset = src.tsOffset();
+    const auto& values = src.getValues();
+    walk<S == InterpolationStrategy::Exact>(
+        src, target, startIndex, newValues.size(), [&](std::size_t i, Timestamp t, Bracket b) {
+            if (!b.found) {
+                newValues[i] = std::numeric_limits<double>::quiet_NaN();
+            } else if (b.lower == b.upper) {
+                newValues[i] = values[b.lower];
+            } else {
+                newValues[i] = interpolate<S>(noise,
+                                              varianceRate,
+                                              t,
+                                              grid[offset + b.lower],
+                                              values[b.lower],
+                                              grid[offset + b.upper],
+                                              values[b.upper]);
+            }
+        });
+}
+
+// Both grids evenly spaced and every source lane present (resamplesArithmetically): where a
+// target row falls is arithmetic, so there is nothing to walk. The values match partialWalk's bit
+// for bit (same end rules, same fraction and lerp); only the bookkeeping differs.
+template <InterpolationStrategy S>
+void regularChunk(const TimeSeries& src, const TimestampGrid& target, std::size_t startIndex,
+                  std::span<double> newValues, BridgeNoise* /*noise*/, double /*varianceRate*/) {
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    constexpr bool exact = S == InterpolationStrategy::Exact;
+    const auto values = src.getValues();
+    const std::size_t last = values.size() - 1;
+    const Timestamp s0 = (*src.getSharedTimestamps())[src.tsOffset()];
+    const Timestamp ss = src.getSharedTimestamps()->uniformStep();
+    const Timestamp sLast = s0 + static_cast<Timestamp>(last) * ss;
+    const Timestamp t0 = target[startIndex];
+    const Timestamp ts = target.uniformStep();
+    const std::size_t n = newValues.size();
+    double* out = newValues.data();
+
+    // Rows [0, lead) sit on or before the first source point, rows [tail, n) on or after the last,
+    // and the interior rows in between fall strictly inside the source.
+    const std::size_t lead = s0 < t0 ? 0 : std::min(n, static_cast<std::size_t>((s0 - t0) / ts) + 1);
+    const std::size_t tail =
+        std::max(lead, sLast <= t0 ? 0 : std::min(n, static_cast<std::size_t>((sLast - t0 + ts - 1) / ts)));
+    const auto rowTs = [&](std::size_t i) { return t0 + static_cast<Timestamp>(i) * ts; };
+    for (std::size_t i = 0; i < lead; ++i) out[i] = !exact || rowTs(i) == s0 ? values[0] : kNaN;
+    for (std::size_t i = tail; i < n; ++i) out[i] = !exact || rowTs(i) == sLast ? values[last] : kNaN;
+    if (lead == tail) return;
+
+    // (lo, rem): the source interval a row falls in and how far into it. One division for the
+    // first interior row, then each row steps by the target step's quotient and remainder.
+    std::size_t lo = static_cast<std::size_t>((rowTs(lead) - s0) / ss);
+    Timestamp rem = (rowTs(lead) - s0) % ss;
+    const std::size_t q = static_cast<std::size_t>(ts / ss);
+    const Timestamp r = ts % ss;
+    const double* v = values.data();
+    const auto fraction = [ss](Timestamp offset) { return static_cast<double>(offset) / static_cast<double>(ss); };
+
+    if constexpr (S == InterpolationStrategy::Linear) {
+        if (ss % ts == 0) {
+            // Integer upsampling ratio (daily to hourly): the rows inside every source interval
+            // take the same ss / ts fractions, so they are tabulated once and each interval is a
+            // straight lerp run over a contiguous slice of the output.
+            const std::size_t period = static_cast<std::size_t>(ss / ts);
+            const Timestamp phase = rem % ts;
+            std::vector<double> weights(period);
+            for (std::size_t k = 0; k < period; ++k) weights[k] = fraction(phase + static_cast<Timestamp>(k) * ts);
+            std::size_t k = static_cast<std::size_t>(rem / ts);
+            for (std::size_t i = lead; i < tail; ++lo, k = 0) {
+                const std::size_t run = std::min(period - k, tail - i);
+                const double v1 = v[lo];
+                const double dv = v[lo + 1] - v1;
+                const double* w = weights.data() + k;
+                double* o = out + i;
+                for (std::size_t j = 0; j < run; ++j) o[j] = v1 + w[j] * dv;
+                i += run;
+            }
+            return;
+        }
+    }
+    for (std::size_t i = lead; i < tail; ++i) {
+        if constexpr (S == InterpolationStrategy::Linear) {
+            out[i] = v[lo] + fraction(rem) * (v[lo + 1] - v[lo]);
+        } else if constexpr (S == InterpolationStrategy::Nearest) {
+            out[i] = rem < ss - rem ? v[lo] : v[lo + 1];
+        } else if constexpr (S == InterpolationStrategy::Latest) {
+            out[i] = v[lo];
         } else {
-            newValues[i] = applyStrategy(strategy,
-                                         noise,
-                                         varianceRate,
-                                         currentTarget,
-                                         span[dataIndex],
-                                         values[dataIndex],
-                                         span[dataIndex + 1],
-                                         values[dataIndex + 1]);
+            out[i] = rem == 0 ? v[lo] : kNaN;
+        }
+        lo += q;
+        rem += r;
+        if (rem >= ss) {
+            rem -= ss;
+            ++lo;
         }
     }
-    return newValues;
 }
 
-std::vector<double> resampleValues(const TimeSeries& src, const Timestamps& target, InterpolationStrategy strategy,
-                                   const StochasticParams& params) {
-    ensure<InvalidArgument>(std::is_sorted(target.begin(), target.end()),
+using ChunkWalk = void (*)(const TimeSeries&, const TimestampGrid&, std::size_t, std::span<double>, BridgeNoise*,
+                           double);
+
+constexpr ChunkWalk chunkWalkFor(InterpolationStrategy strategy, bool regular) {
+    switch (strategy) {
+        case InterpolationStrategy::Linear:
+            return regular ? &regularChunk<InterpolationStrategy::Linear> : &partialWalk<InterpolationStrategy::Linear>;
+        case InterpolationStrategy::Stochastic: return &partialWalk<InterpolationStrategy::Stochastic>;
+        case InterpolationStrategy::Nearest:
+            return regular ? &regularChunk<InterpolationStrategy::Nearest>
+                           : &partialWalk<InterpolationStrategy::Nearest>;
+        case InterpolationStrategy::Exact:
+            return regular ? &regularChunk<InterpolationStrategy::Exact> : &partialWalk<InterpolationStrategy::Exact>;
+        case InterpolationStrategy::Latest:
+            return regular ? &regularChunk<InterpolationStrategy::Latest> : &partialWalk<InterpolationStrategy::Latest>;
+    }
+    return &partialWalk<InterpolationStrategy::Linear>;
+}
+
+// Resampling needs a sorted target and at least one present source point, plan or no plan.
+void ensureSortedTarget(const TimestampGrid& target) {
+    // A regular grid is sorted by construction; checking it would only materialise it. Every
+    // target read below goes through operator[], so it stays implicit for the whole walk.
+    ensure<InvalidArgument>(target.isRegular() || std::is_sorted(target.begin(), target.end()),
                             "target_timestamps must be sorted for resampling.");
-    ensure(!src.getValues().empty(), "resample: cannot resample from empty series '{}'", src.getId());
+}
+
+void ensureNotEmpty(const TimeSeries& src) {
+    ensure(src.validCount() != 0, "resample: cannot resample from empty series '{}'", src.getId());
+}
+
+void ensureResamplable(const TimeSeries& src, const TimestampGrid& target) {
+    ensureSortedTarget(target);
+    ensureNotEmpty(src);
+}
+
+bool sameValidity(const std::shared_ptr<const ValidityBitmap>& a, const std::shared_ptr<const ValidityBitmap>& b) {
+    if (a == b) return true;
+    if (!a || !b || a->size() != b->size()) return false;
+    for (std::size_t i = 0; i < a->size(); ++i) {
+        if (a->isValid(i) != b->isValid(i)) return false;
+    }
+    return true;
+}
+
+// Whether `src` has the given timestamps and gaps, i.e. whether the walk over it is the same.
+bool sameSource(const TimestampGrid& grid, std::size_t offset, std::size_t size,
+                const std::shared_ptr<const ValidityBitmap>& validity, const TimeSeries& src) {
+    if (src.size() != size) return false;
+    const bool sameTimestamps = (src.getSharedTimestamps().get() == &grid && src.tsOffset() == offset) ||
+                                grid.matches(offset, *src.getSharedTimestamps(), src.tsOffset(), size);
+    return sameTimestamps && sameValidity(validity, src.getSharedValidity());
+}
 
+// Fills `out` (target.size() values) with the resampled source. The caller has checked the
+// target and the source (ensureResamplable).
+void resampleInto(const TimeSeries& src, const TimestampGrid& target, InterpolationStrategy strategy,
+                  const StochasticParams& params, std::span<double> out) {
     const std::size_t n = target.size();
-    if (n == 0) return {};
+    if (n == 0) return;
 
     const bool random = needsRandomness(strategy);
     double varianceRate = 0.0;
     if (random) varianceRate = params.varianceRate ? *params.varianceRate : varianceRatePerTick(src);
 
     const std::size_t chunks = (n + kChunkSize - 1) / kChunkSize;
-    std::vector<double> out(n);
+    const ChunkWalk chunkWalk = chunkWalkFor(strategy, resamplesArithmetically(src, target, strategy));
 
     auto runChunk = [&](std::size_t c) {
         const std::size_t start = c * kChunkSize;
         const std::size_t end = std::min(start + kChunkSize, n);
         std::optional<BridgeNoise> noise;
         if (random) noise.emplace(rngForStream(params.seed, RngDomain::Resampling, c));  // stream = chunk ordinal
-        auto part = partialWalk(src, target, start, end, strategy, noise ? &*noise : nullptr, varianceRate);
-        std::copy(part.begin(), part.end(), out.begin() + static_cast<std::ptrdiff_t>(start));
+        chunkWalk(src, target, start, out.subspan(start, end - start), noise ? &*noise : nullptr, varianceRate);
     };
 
     if (chunks == 1) {
         runChunk(0);
     } else {
-        const unsigned hw = std::thread::hardware_concurrency();
-        const std::size_t width = (hw == 0) ? 1 : hw;
-        for (std::size_t c0 = 0; c0 < chunks; c0 += width) {  // waves keep thread count bounded
-            std::vector<std::future<void>> futs;
-            for (std::size_t c = c0; c < std::min(c0 + width, chunks); ++c)
-                futs.push_back(std::async(std::launch::async, [&, c] { runChunk(c); }));
-            for (auto& f : futs) f.get();
-        }
+        // With FINLIB_PARALLEL, libstdc++ runs the parallel policy on oneTBB, whose worker
+        // threads persist across calls, so a long grid queues its chunks on them instead of
+        // spawning a thread per chunk.
+        // Each chunk seeds its noise from its ordinal, not from the thread that runs it, so the
+        // result does not depend on the schedule.
+        std::vector<std::size_t> ordinals(chunks);
+        std::iota(ordinals.begin(), ordinals.end(), std::size_t{0});
+        std::for_each(kParallelPolicy, ordinals.begin(), ordinals.end(), runChunk);
     }
+}
+
+std::pmr::vector<double> resampleValues(const TimeSeries& src, const TimestampGrid& target,
+                                        InterpolationStrategy strategy, const StochasticParams& params) {
+    ensureResamplable(src, target);
+    auto out = ValueBuffer::allocate(target.size());
+    resampleInto(src, target, strategy, params, out);
     return out;
 }
 }  // namespace
 
+bool resamplesArithmetically(const TimeSeries& src, const TimestampGrid& target, InterpolationStrategy strategy) {
+    return !needsRandomness(strategy) && !src.hasValidity() && src.size() >= 2 && target.uniformStep() != 0 &&
+           src.getSharedTimestamps()->uniformStep() != 0;
+}
+
 double varianceRatePerTick(const TimeSeries& src) {
+    // Increments between consecutive present points; a missing lane contributes nothing.
     const auto& values = src.getValues();
-    if (values.size() < 2) return 0.0;
+    std::optional<std::size_t> firstValid;
+    std::size_t previous = 0;
     double qv = 0.0;
-    for (std::size_t i = 1; i < values.size(); ++i) {
-        const double dv = values[i] - values[i - 1];
-        qv += dv * dv;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (!src.isValid(i)) continue;
+        if (firstValid) {
+            const double dv = values[i] - values[previous];
+            qv += dv * dv;
+        } else {
+            firstValid = i;
+        }
+        previous = i;
     }
-    const auto span = src.getTimestamps();
-    const double totalTicks = static_cast<double>(span.back() - span.front());
+    if (!firstValid || previous == *firstValid) return 0.0;
+    const TimestampGrid& grid = *src.getSharedTimestamps();
+    const double totalTicks = static_cast<double>(grid[src.tsOffset() + previous] - grid[src.tsOffset() + *firstValid]);
     return totalTicks > 0.0 ? qv / totalTicks : 0.0;
 }
 
@@ -159,11 +362,325 @@ TimeSeries resample(const TimeSeries& src, TimestampsPtr target, InterpolationSt
                     const StochasticParams& params) {
     ensure<InvalidArgument>(target != nullptr, "targetTimestamps pointer is null.");
     auto values = resampleValues(src, *target, strategy, params);  // must precede the move below
-    return TimeSeries::synthetic("Resampled " + src.getId(), std::move(target), std::move(values));
+    auto result = TimeSeries::synthetic("Resampled " + src.getId(), std::move(target), ValueBuffer(std::move(values)));
+    // Exact leaves a NaN wherever the source has no point; flag those rather than hand them on.
+    if (strategy == InterpolationStrategy::Exact) result.markMissing();
+    return result;
 }
 
 TimeSeries resample(const TimeSeries& src, const Timestamps& target, InterpolationStrategy strategy,
                     const StochasticParams& params) {
-    return resample(src, std::make_shared<const Timestamps>(target), strategy, params);
+    return resample(src, std::make_shared<const TimestampGrid>(target), strategy, params);
+}
+
+// ---------------------------------------------------------------------------
+// InterpolationPlan
+// ---------------------------------------------------------------------------
+InterpolationPlan::InterpolationPlan(const TimeSeries& src, TimestampsPtr target, InterpolationStrategy strategy)
+    : source_(src.getSharedTimestamps()),
+      sourceOffset_(src.tsOffset()),
+      sourceSize_(src.size()),
+      validity_(src.getSharedValidity()),
+      target_(std::move(target)),
+      strategy_(strategy) {
+    ensure<InvalidArgument>(target_ != nullptr, "InterpolationPlan: target timestamps pointer is null.");
+    ensure<InvalidArgument>(!needsRandomness(strategy_),
+                            "InterpolationPlan: {} draws fresh noise on every call and cannot be planned",
+                            strategy_);
+    ensureResamplable(src, *target_);
+
+    const std::size_t n = target_->size();
+    lower_.resize(n);
+    const bool linear = strategy_ == InterpolationStrategy::Linear;
+    if (linear) {
+        upper_.resize(n);
+        weight_.resize(n);
+    }
+    if (n == 0) return;
+
+    const TimestampGrid& grid = *source_;
+    const auto record = [&](std::size_t i, Timestamp t, Bracket b) {
+        if (!b.found) missing_.push_back(i);
+        lower_[i] = b.lower;
+        if (linear) upper_[i] = b.upper;  // weight_ stays 0 on a single lane
+        if (b.lower == b.upper) return;
+        // Same choices as interpolate(), made once here instead of on every replay.
+        const Timestamp t1 = grid[sourceOffset_ + b.lower];
+        const Timestamp t2 = grid[sourceOffset_ + b.upper];
+        if (linear) {
+            weight_[i] = static_cast<double>(t - t1) / static_cast<double>(t2 - t1);
+        } else if (strategy_ == InterpolationStrategy::Nearest && !(t - t1 < t2 - t)) {
+            lower_[i] = b.upper;
+        }
+    };
+    if (strategy_ == InterpolationStrategy::Exact) {
+        walk<true>(src, *target_, 0, n, record);
+    } else {
+        walk<false>(src, *target_, 0, n, record);
+    }
+}
+
+std::size_t InterpolationPlan::bytes() const {
+    const std::size_t tables = (lower_.capacity() + upper_.capacity() + missing_.capacity()) * sizeof(std::size_t) +
+                               weight_.capacity() * sizeof(double);
+    const std::size_t grids = (source_->size() + target_->size()) * sizeof(Timestamp);
+    const std::size_t bitmap = validity_ ? (validity_->size() + 63) / 64 * sizeof(std::uint64_t) : 0;
+    return tables + grids + bitmap;
+}
+
+bool InterpolationPlan::appliesTo(const TimeSeries& src) const {
+    return sameSource(*source_, sourceOffset_, sourceSize_, validity_, src);
+}
+
+std::pmr::vector<double> InterpolationPlan::apply(std::span<const double> values) const {
+    auto out = ValueBuffer::allocate(lower_.size());
+    apply(values, out);
+    return out;
+}
+
+void InterpolationPlan::apply(std::span<const double> values, std::span<double> out) const {
+    ensure<InvalidArgument>(values.size() == sourceSize_,
+                            "InterpolationPlan::apply: {} values for a plan over {} source points",
+                            values.size(),
+                            sourceSize_);
+    const std::size_t n = lower_.size();
+    ensure<InvalidArgument>(out.size() == n, "InterpolationPlan::apply: {} output slots for {} target rows",
+                            out.size(), n);
+    const double* v = values.data();
+    const std::size_t* lower = lower_.data();
+    double* o = out.data();
+    if (weight_.empty()) {
+        for (std::size_t i = 0; i < n; ++i) o[i] = v[lower[i]];
+    } else {
+        // The walk's v1 + fraction * (v2 - v1), term for term, so replaying is bit-identical to it.
+        const std::size_t* upper = upper_.data();
+        const double* weight = weight_.data();
+        for (std::size_t i = 0; i < n; ++i) {
+            const double v1 = v[lower[i]];
+            o[i] = v1 + weight[i] * (v[upper[i]] - v1);
+        }
+    }
+    for (const std::size_t i : missing_) o[i] = std::numeric_limits<double>::quiet_NaN();
+}
+
+TimeSeries resample(const TimeSeries& src, const InterpolationPlan& plan) {
+    ensure<InvalidArgument>(plan.appliesTo(src),
+                            "resample: the {} plan was built for other source timestamps or gaps than '{}' has",
+                            plan.strategy(),
+                            src.getId());
+    auto result = TimeSeries::synthetic(
+        "Resampled " + src.getId(), plan.target(), ValueBuffer(plan.apply(src.getValues())));
+    if (plan.strategy() == InterpolationStrategy::Exact) result.markMissing();
+    return result;
+}
+// ---------------------------------------------------------------------------
+// Batch
+// ---------------------------------------------------------------------------
+TimeSeriesPanel resampleMany(std::span<const TimeSeries* const> sources, TimestampsPtr target,
+                             InterpolationStrategy strategy, const StochasticParams& params,
+                             std::vector<std::string> columnIds) {
+    ensure<InvalidArgument>(target != nullptr, "resampleMany: target timestamps pointer is null.");
+    ensure<InvalidArgument>(columnIds.empty() || columnIds.size() == sources.size(),
+                            "resampleMany: {} column ids for {} sources", columnIds.size(), sources.size());
+    ensureSortedTarget(*target);
+    for (const TimeSeries* src : sources) {
+        ensure<InvalidArgument>(src != nullptr, "resampleMany: null source series.");
+        ensureNotEmpty(*src);
+    }
+    if (columnIds.empty()) {
+        columnIds.reserve(sources.size());
+        for (const TimeSeries* src : sources) columnIds.push_back(src->getId());
+    }
+
+    // Group the sources by timestamps and gaps: the first of a group with company is planned once
+    // and every member replays that plan. A source alone in its group, or any Stochastic one
+    // (whose noise a plan cannot hold), walks straight into its column, and a group on evenly
+    // spaced grids computes its rows arithmetically, which is cheaper than building a plan.
+    std::vector<std::size_t> groupOf(sources.size());
+    std::vector<std::size_t> leaders;
+    std::vector<std::size_t> groupSize;
+    for (std::size_t j = 0; j < sources.size(); ++j) {
+        const auto same = std::find_if(leaders.begin(), leaders.end(), [&](std::size_t leader) {
+            const TimeSeries& l = *sources[leader];
+            return sameSource(*l.getSharedTimestamps(), l.tsOffset(), l.size(), l.getSharedValidity(), *sources[j]);
+        });
+        groupOf[j] = static_cast<std::size_t>(same - leaders.begin());
+        if (same == leaders.end()) {
+            leaders.push_back(j);
+            groupSize.push_back(0);
+        }
+        ++groupSize[groupOf[j]];
+    }
+    std::vector<std::optional<InterpolationPlan>> plans(leaders.size());
+    if (!needsRandomness(strategy)) {
+        for (std::size_t g = 0; g < leaders.size(); ++g) {
+            const TimeSeries& leader = *sources[leaders[g]];
+            if (groupSize[g] > 1 && !resamplesArithmetically(leader, *target, strategy)) {
+                plans[g].emplace(leader, target, strategy);
+            }
+        }
+    }
+
+    TimeSeriesPanel panel(target, std::move(columnIds));
+    std::vector<std::size_t> columns(sources.size());
+    std::iota(columns.begin(), columns.end(), std::size_t{0});
+    std::for_each(kParallelPolicy, columns.begin(), columns.end(), [&](std::size_t j) {
+        if (const auto& plan = plans[groupOf[j]]) {
+            plan->apply(sources[j]->getValues(), panel.column(j));
+        } else if (needsRandomness(strategy)) {
+            // One seed for every column would bridge every series with the same noise.
+            StochasticParams column = params;
+            column.seed = rngForStream(params.seed, RngDomain::Resampling, j)();
+            resampleInto(*sources[j], *target, strategy, column, panel.column(j));
+        } else {
+            resampleInto(*sources[j], *target, strategy, params, panel.column(j));
+        }
+    });
+    return panel;
+}
+
+TimeSeriesPanel resampleMany(std::span<const TimeSeries> sources, TimestampsPtr target,
+                             InterpolationStrategy strategy, const StochasticParams& params,
+                             std::vector<std::string> columnIds) {
+    std::vector<const TimeSeries*> pointers;
+    pointers.reserve(sources.size());
+    for (const TimeSeries& src : sources) pointers.push_back(&src);
+    return resampleMany(pointers, std::move(target), strategy, params, std::move(columnIds));
+}
+// ---------------------------------------------------------------------------
+// Aggregation
+// ---------------------------------------------------------------------------
+namespace {
+// Everything any Aggregation needs from one bucket, gathered in the same pass.
+struct Bar {
+    double open = std::numeric_limits<double>::quiet_NaN();
+    double high = -std::numeric_limits<double>::infinity();
+    double low = std::numeric_limits<double>::infinity();
+    double close = std::numeric_limits<double>::quiet_NaN();
+    double sum = 0.0;
+    std::size_t count = 0;
+    double priceVolume = 0.0;
+    double volume = 0.0;
+
+    void add(double v) {
+        if (count++ == 0) open = v;
+        high = std::max(high, v);
+        low = std::min(low, v);
+        close = v;
+        sum += v;
+    }
+
+    double read(Aggregation aggregation, double last) const {
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+        switch (aggregation) {
+            case Aggregation::Open: return open;
+            case Aggregation::High: return count ? high : kNaN;
+            case Aggregation::Low: return count ? low : kNaN;
+            case Aggregation::Close: return close;
+            case Aggregation::Sum: return sum;
+            case Aggregation::Mean: return count ? sum / static_cast<double>(count) : kNaN;
+            case Aggregation::Count: return static_cast<double>(count);
+            case Aggregation::Last: return last;
+            case Aggregation::Vwap: return volume > 0.0 ? priceVolume / volume : kNaN;
+        }
+        return kNaN;
+    }
+};
+
+// Aggregates buckets [first, last) into their rows of `out`. Chunks start independently: each
+// finds its first source point by search and its carried Last by stepping back over gaps.
+void aggregateBuckets(const TimeSeries& src, const TimeSeries* volume, const TimestampGrid& target,
+                      std::span<const Aggregation> columns, std::size_t first, std::size_t last,
+                      TimeSeriesPanel& out) {
+    const TimestampGrid& grid = *src.getSharedTimestamps();
+    const std::size_t offset = src.tsOffset();
+    const auto values = src.getValues();
+    const auto volumes = volume ? volume->getValues() : std::span<const double>();
+    const std::size_t n = target.size();
+    // The last bucket is as long as the one before it; a one-point grid's has no end.
+    const auto bucketEnd = [&](std::size_t i) {
+        if (i + 1 < n) return target[i + 1];
+        return n > 1 ? target[i] + (target[i] - target[i - 1]) : std::numeric_limits<Timestamp>::max();
+    };
+
+    std::size_t k = src.lowerBound(target[first]);
+    double carried = std::numeric_limits<double>::quiet_NaN();
+    for (std::size_t back = k; back-- > 0;) {
+        if (src.isValid(back)) {
+            carried = values[back];
+            break;
+        }
+    }
+
+    for (std::size_t i = first; i < last; ++i) {
+        const Timestamp end = bucketEnd(i);
+        Bar bar;
+        for (; k < values.size() && grid[offset + k] < end; ++k) {
+            if (!src.isValid(k)) continue;
+            bar.add(values[k]);
+            carried = values[k];
+            if (volume && volume->isValid(k)) {
+                bar.priceVolume += values[k] * volumes[k];
+                bar.volume += volumes[k];
+            }
+        }
+        for (std::size_t c = 0; c < columns.size(); ++c) out(i, c) = bar.read(columns[c], carried);
+    }
+}
+}  // namespace
+
+TimeSeriesPanel aggregate(const TimeSeries& src, TimestampsPtr target, std::span<const Aggregation> columns,
+                          const TimeSeries* volume) {
+    ensure<InvalidArgument>(target != nullptr, "aggregate: target timestamps pointer is null.");
+    ensureSortedTarget(*target);
+    const bool needsVolume = std::find(columns.begin(), columns.end(), Aggregation::Vwap) != columns.end();
+    ensure<InvalidArgument>(!needsVolume || volume != nullptr, "aggregate: Vwap of '{}' needs a volume series",
+                            src.getId());
+    if (volume) {
+        ensure<InvalidArgument>(volume->size() == src.size() &&
+                                    src.getSharedTimestamps()->matches(src.tsOffset(),
+                                                                       *volume->getSharedTimestamps(),
+                                                                       volume->tsOffset(),
+                                                                       src.size()),
+                                "aggregate: volume '{}' is not aligned with '{}'",
+                                volume->getId(),
+                                src.getId());
+    }
+
+    std::vector<std::string> ids;
+    ids.reserve(columns.size());
+    for (const Aggregation aggregation : columns) ids.emplace_back(toString(aggregation));
+    TimeSeriesPanel panel(target, std::move(ids));
+    const std::size_t n = target->size();
+    if (n == 0 || columns.empty()) return panel;
+
+    // Chunks of whole buckets sized so that each covers about kChunkSize source points on
+    // average: a few daily bars over millions of ticks still split across the pool.
+    const std::size_t perChunk =
+        std::max<std::size_t>(1, n * kChunkSize / std::max<std::size_t>(src.size(), kChunkSize));
+    const std::size_t chunks = (n + perChunk - 1) / perChunk;
+    auto runChunk = [&](std::size_t c) {
+        aggregateBuckets(src, volume, *target, columns, c * perChunk, std::min(n, (c + 1) * perChunk), panel);
+    };
+    if (chunks == 1) {
+        runChunk(0);
+    } else {
+        std::vector<std::size_t> ordinals(chunks);
+        std::iota(ordinals.begin(), ordinals.end(), std::size_t{0});
+        std::for_each(kParallelPolicy, ordinals.begin(), ordinals.end(), runChunk);
+    }
+    return panel;
+}
+
+TimeSeries aggregate(const TimeSeries& src, TimestampsPtr target, Aggregation aggregation,
+                     const TimeSeries* volume) {
+    const std::array<Aggregation, 1> columns{aggregation};
+    const TimeSeriesPanel panel = aggregate(src, target, columns, volume);
+    const auto values = panel.column(0);
+    auto result = TimeSeries::synthetic(std::format("{} {}", aggregation, src.getId()),
+                                        std::move(target),
+                                        std::vector<double>(values.begin(), values.end()));
+    result.markMissing();
+    return result;
 }
 }  // namespace ts
@@ -0,0 +1,252 @@
+// Copyright 2026 JBBLET
+#include "finlib/core/RollingStats.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <set>
+#include <vector>
+
+#include "finlib/common/Error.hpp"
+
+namespace ts::analysis::stats {
+
+namespace {
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Below this fraction of the raw second moment, m2 is cancellation noise rather than spread: a
+// constant window must report a variance of exactly 0 (and a skewness of 0, like Moments).
+constexpr double kCancellation = 64.0 * std::numeric_limits<double>::epsilon();
+
+// The StatsCore rule for which samples count: without a mask, the finite ones; with a mask, the
+// mask alone.
+class Presence {
+ public:
+    Presence(Samples x, ValidityMask valid) : x_(x), valid_(valid) {
+        if (!valid_.allValid()) {
+            ensure<InvalidArgument>(
+                valid_.size() == x_.size(), "validity mask has {} lanes for {} samples", valid_.size(), x_.size());
+        }
+    }
+    bool operator()(size_t i) const { return valid_.allValid() ? std::isfinite(x_[i]) : valid_.isValid(i); }
+
+ private:
+    Samples x_;
+    ValidityMask valid_;
+};
+
+// Power sums of the window's valid samples around `shift`. Keeping the shift near the window
+// mean keeps s1 small, so m2 = s2 - s1²/n does not cancel catastrophically. An empty window
+// (a gap at least as long as the window) re-anchors the shift on the next sample it sees.
+struct ShiftedSums {
+    double shift = 0.0;
+    double s1 = 0.0;
+    double s2 = 0.0;
+    double s3 = 0.0;
+    size_t count = 0;
+
+    void add(double v) {
+        if (count == 0) *this = ShiftedSums{.shift = v};
+        const double d = v - shift;
+        s1 += d;
+        s2 += d * d;
+        s3 += d * d * d;
+        ++count;
+    }
+    void remove(double v) {
+        const double d = v - shift;
+        s1 -= d;
+        s2 -= d * d;
+        s3 -= d * d * d;
+        --count;
+    }
+
+    double mean() const { return shift + s1 / static_cast<double>(count); }
+    double m2() const {
+        const double m2 = s2 - s1 * s1 / static_cast<double>(count);
+        return m2 <= kCancellation * s2 ? 0.0 : m2;
+    }
+    double m3() const {
+        const auto n = static_cast<double>(count);
+        return s3 - 3.0 * s1 * s2 / n + 2.0 * s1 * s1 * s1 / (n * n);
+    }
+};
+
+// Two passes over [begin, end): the mean becomes the new shift, then the sums are taken around it.
+ShiftedSums rebuild(Samples x, const Presence& present, size_t begin, size_t end) {
+    ShiftedSums sums;
+    double total = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        if (!present(i)) continue;
+        total += x[i];
+        ++sums.count;
+    }
+    if (sums.count == 0) return sums;
+    sums.shift = total / static_cast<double>(sums.count);
+    sums.count = 0;
+    for (size_t i = begin; i < end; ++i) {
+        if (present(i)) sums.add(x[i]);
+    }
+    return sums;
+}
+
+double variance(const ShiftedSums& sums, VarianceType type) {
+    const size_t needed = type == VarianceType::Sample ? 2 : 1;
+    if (sums.count < needed) return kNaN;
+    return sums.m2() / static_cast<double>(type == VarianceType::Sample ? sums.count - 1 : sums.count);
+}
+
+double finish(const ShiftedSums& sums, RollingStatistic stat, VarianceType type, double current, bool currentPresent) {
+    if (sums.count == 0) return kNaN;
+    const auto n = static_cast<double>(sums.count);
+    switch (stat) {
+        case RollingStatistic::Sum: return n * sums.shift + sums.s1;
+        case RollingStatistic::Mean: return sums.mean();
+        case RollingStatistic::Variance: return variance(sums, type);
+        case RollingStatistic::StandardDeviation: return std::sqrt(variance(sums, type));
+        case RollingStatistic::Skewness: {
+            const double m2 = sums.m2();
+            if (m2 == 0.0) return 0.0;
+            return (sums.m3() / n) / std::pow(m2 / n, 1.5);
+        }
+        case RollingStatistic::ZScore: {
+            const double sd = std::sqrt(variance(sums, type));
+            if (!currentPresent || !(sd > 0.0)) return kNaN;
+            return (current - sums.mean()) / sd;
+        }
+        default: break;
+    }
+    throw InvalidArgument("rolling: {} is not a moment statistic", stat);
+}
+
+std::vector<double> rollingMoments(
+    Samples x, const Presence& present, size_t window, RollingStatistic stat, VarianceType type) {
+    std::vector<double> out(x.size(), kNaN);
+    ShiftedSums sums;
+    for (size_t i = window - 1; i < x.size(); ++i) {
+        const size_t begin = i + 1 - window;
+        // Re-centring every `window` steps is O(window) each time, so O(1) amortised per step.
+        if (begin % window == 0) {
+            sums = rebuild(x, present, begin, i + 1);
+        } else {
+            if (present(begin - 1)) sums.remove(x[begin - 1]);
+            if (present(i)) sums.add(x[i]);
+        }
+        out[i] = finish(sums, stat, type, x[i], present(i));
+    }
+    return out;
+}
+
+// Rows of the window that could still be its extreme, oldest first; `better(a, b)` says a beats b.
+template <typename Better>
+std::vector<double> rollingExtreme(Samples x, const Presence& present, size_t window, Better better) {
+    std::vector<double> out(x.size(), kNaN);
+    std::deque<size_t> candidates;
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (present(i)) {
+            while (!candidates.empty() && !better(x[candidates.back()], x[i])) candidates.pop_back();
+            candidates.push_back(i);
+        }
+        if (!candidates.empty() && candidates.front() + window <= i) candidates.pop_front();
+        if (i + 1 >= window && !candidates.empty()) out[i] = x[candidates.front()];
+    }
+    return out;
+}
+
+// The window's valid samples split at the target rank: lower_ holds the k + 1 smallest, upper_
+// the rest, so ranks k and k + 1 are the two ends facing each other. Nodes come from a pool, so
+// the steady state recycles them instead of calling the allocator every step.
+class SplitWindow {
+ public:
+    explicit SplitWindow(double q) : q_(q), lower_(&pool_), upper_(&pool_) {}
+
+    void insert(double v) {
+        if (!lower_.empty() && v <= *lower_.rbegin()) {
+            lower_.insert(v);
+        } else {
+            upper_.insert(v);
+        }
+    }
+    // Every element of lower_ is <= every element of upper_, so a value below lower_'s maximum
+    // can only be in lower_; at the maximum either side holds an equal copy.
+    void erase(double v) {
+        if (!lower_.empty() && v <= *lower_.rbegin()) {
+            lower_.erase(lower_.find(v));
+        } else {
+            upper_.erase(upper_.find(v));
+        }
+    }
+
+    size_t size() const { return lower_.size() + upper_.size(); }
+
+    double quantile() {
+        const double position = q_ * static_cast<double>(size() - 1);
+        const auto k = static_cast<size_t>(std::floor(position));
+        while (lower_.size() > k + 1) {
+            auto last = std::prev(lower_.end());
+            upper_.insert(*last);
+            lower_.erase(last);
+        }
+        while (lower_.size() < k + 1) {
+            lower_.insert(*upper_.begin());
+            upper_.erase(upper_.begin());
+        }
+        const double below = *lower_.rbegin();
+        const double weight = position - static_cast<double>(k);
+        if (weight == 0.0) return below;
+        return below * (1.0 - weight) + *upper_.begin() * weight;
+    }
+
+ private:
+    double q_;
+    std::pmr::unsynchronized_pool_resource pool_;
+    std::pmr::multiset<double> lower_;
+    std::pmr::multiset<double> upper_;
+};
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// Rolling statistics
+// ---------------------------------------------------------------------------
+std::vector<double> rolling(Samples x, size_t window, RollingStatistic stat, VarianceType type) {
+    return rolling(x, ValidityMask(), window, stat, type);
+}
+
+std::vector<double> rolling(Samples x, ValidityMask valid, size_t window, RollingStatistic stat, VarianceType type) {
+    ensure<InvalidArgument>(window > 0, "rolling: window must be at least 1");
+    const Presence present(x, valid);
+    switch (stat) {
+        case RollingStatistic::Min:
+            return rollingExtreme(x, present, window, [](double a, double b) { return a < b; });
+        case RollingStatistic::Max:
+            return rollingExtreme(x, present, window, [](double a, double b) { return a > b; });
+        case RollingStatistic::Median: return rollingQuantile(x, valid, window, 0.5);
+        default: return rollingMoments(x, present, window, stat, type);
+    }
+}
+
+std::vector<double> rollingQuantile(Samples x, size_t window, double q) {
+    return rollingQuantile(x, ValidityMask(), window, q);
+}
+
+std::vector<double> rollingQuantile(Samples x, ValidityMask valid, size_t window, double q) {
+    ensure<InvalidArgument>(window > 0, "rollingQuantile: window must be at least 1");
+    ensure<InvalidArgument>(q >= 0.0 && q <= 1.0, "rollingQuantile: q must lie in [0, 1], got {}", q);
+    const Presence present(x, valid);
+    // A NaN a mask calls valid would break the multisets' ordering, so it is skipped here too.
+    const auto counts = [&](size_t i) { return present(i) && !std::isnan(x[i]); };
+
+    std::vector<double> out(x.size(), kNaN);
+    SplitWindow split(q);
+    for (size_t i = 0; i < x.size(); ++i) {
+        if (i >= window && counts(i - window)) split.erase(x[i - window]);
+        if (counts(i)) split.insert(x[i]);
+        if (i + 1 >= window && split.size() != 0) out[i] = split.quantile();
+    }
+    return out;
+}
+
+}  // namespace ts::analysis::stats
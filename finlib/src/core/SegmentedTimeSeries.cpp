@@ -0,0 +1,168 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#include "finlib/core/SegmentedTimeSeries.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "finlib/common/Error.hpp"
+#include "finlib/common/FinlibTypes.hpp"
+#include "finlib/common/Format.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+
+namespace ts {
+
+// ---------------------------------------------------------------------------
+// constructor
+// ---------------------------------------------------------------------------
+SegmentedTimeSeries::SegmentedTimeSeries(std::string id, size_t blockSize) : id_(std::move(id)), blockSize_(blockSize) {
+    ensure<InvalidArgument>(blockSize_ > 0, "SegmentedTimeSeries '{}': blockSize must be positive", id_);
+    tailTimestamps_.reserve(blockSize_);
+    tailValues_.reserve(blockSize_);
+}
+
+// ---------------------------------------------------------------------------
+// Append
+// ---------------------------------------------------------------------------
+void SegmentedTimeSeries::append(Timestamp ts, double value) {
+    if (!empty()) {
+        ensure<InvalidArgument>(ts > back(),
+                                "SegmentedTimeSeries '{}': appended timestamp {} is not after the last one ({})",
+                                id_,
+                                ts,
+                                back());
+    }
+    tailTimestamps_.push_back(ts);
+    tailValues_.push_back(value);
+    if (tailValues_.size() == blockSize_) sealTail_();
+}
+
+size_t SegmentedTimeSeries::append(const TimeSeries& series) {
+    if (series.size() == 0) return 0;
+    const auto& values = series.getValues();
+    const TimestampGrid& grid = *series.getSharedTimestamps();
+    const size_t first = empty() ? 0 : series.upperBound(back());
+    size_t appended = 0;
+    for (size_t i = first; i < values.size(); ++i) {
+        if (!series.isValid(i)) continue;
+        append(grid[series.tsOffset() + i], values[i]);
+        ++appended;
+    }
+    return appended;
+}
+
+// ---------------------------------------------------------------------------
+// Accessors
+// ---------------------------------------------------------------------------
+double SegmentedTimeSeries::operator[](size_t i) const {
+    if (i < sealedCount()) return blocks_[i / blockSize_]->getValues()[i % blockSize_];
+    return tailValues_[i - sealedCount()];
+}
+
+Timestamp SegmentedTimeSeries::timestamp(size_t i) const {
+    if (i < sealedCount()) return (*blocks_[i / blockSize_]->getSharedTimestamps())[i % blockSize_];
+    return tailTimestamps_[i - sealedCount()];
+}
+
+Timestamp SegmentedTimeSeries::back() const {
+    ensure(!empty(), "SegmentedTimeSeries '{}': back() of an empty series", id_);
+    return timestamp(size() - 1);
+}
+
+// ---------------------------------------------------------------------------
+// Transformation Method
+// ---------------------------------------------------------------------------
+const std::shared_ptr<const TimeSeries>& SegmentedTimeSeries::block(size_t k) const {
+    ensure<InvalidArgument>(
+        k < blocks_.size(), "SegmentedTimeSeries '{}': block {} out of range ({} sealed)", id_, k, blocks_.size());
+    return blocks_[k];
+}
+
+TimeSeriesView SegmentedTimeSeries::blockView(size_t k) const { return block(k)->view(); }
+
+TimeSeriesView SegmentedTimeSeries::view(size_t start, size_t len) const {
+    ensure<InvalidArgument>(start + len <= size(),
+                            "SegmentedTimeSeries '{}': rows [{}, {}) exceed size {}",
+                            id_,
+                            start,
+                            start + len,
+                            size());
+    if (len > 0 && start + len <= sealedCount() && start / blockSize_ == (start + len - 1) / blockSize_) {
+        return blocks_[start / blockSize_]->slice(start % blockSize_, len);
+    }
+    Timestamps timestamps;
+    std::vector<double> values;
+    copyRange_(start, len, timestamps, values);
+    auto owned = std::make_shared<const TimeSeries>(id_, std::move(timestamps), std::move(values));
+    return owned->view();
+}
+
+TimeSeries SegmentedTimeSeries::compact() const {
+    Timestamps timestamps;
+    std::vector<double> values;
+    copyRange_(0, size(), timestamps, values);
+    return TimeSeries(id_, std::move(timestamps), std::move(values));
+}
+
+// ---------------------------------------------------------------------------
+// Display
+// ---------------------------------------------------------------------------
+std::string SegmentedTimeSeries::toString(const fmt::FormatSpec& spec) const {
+    std::string identity = std::format("SegmentedTimeSeries '{}' [", id_);
+    if (empty()) {
+        identity += "empty";
+    } else {
+        identity += std::format("n={}, {} .. {}", size(), fmt::AsDate{timestamp(0)}, fmt::AsDate{back()});
+    }
+    identity += std::format(", {} block(s) of {} + {} in tail]", blocks_.size(), blockSize_, tailValues_.size());
+
+    if (spec.mode == fmt::FormatMode::Identity) return identity;
+    // The multi-line modes need contiguous rows; they are for the console, so a copy is fine.
+    const TimeSeries flat = compact();
+    if (spec.mode == fmt::FormatMode::Describe) return fmt::renderDescribe(identity, flat.getValues(), spec.precision);
+    return fmt::renderSeries(identity, flat.getTimestamps(), flat.getValues(), spec);
+}
+
+// ---------------------------------------------------------------------------
+// Private Helpers
+// ---------------------------------------------------------------------------
+void SegmentedTimeSeries::sealTail_() {
+    // The vectors move into the block, so sealing copies nothing; the next tail reserves afresh.
+    blocks_.push_back(std::make_shared<const TimeSeries>(id_, std::move(tailTimestamps_), std::move(tailValues_)));
+    tailTimestamps_ = Timestamps();
+    tailValues_ = std::vector<double>();
+    tailTimestamps_.reserve(blockSize_);
+    tailValues_.reserve(blockSize_);
+}
+
+void SegmentedTimeSeries::copyRange_(size_t start, size_t len, Timestamps& timestamps,
+                                     std::vector<double>& values) const {
+    timestamps.reserve(len);
+    values.reserve(len);
+    const size_t end = start + len;
+    size_t i = start;
+    while (i < std::min(end, sealedCount())) {
+        const TimeSeries& current = *blocks_[i / blockSize_];
+        const size_t from = i % blockSize_;
+        const size_t to = std::min(blockSize_, from + (end - i));
+        const TimestampGrid& grid = *current.getSharedTimestamps();
+        for (size_t r = from; r < to; ++r) timestamps.push_back(grid[r]);
+        values.insert(values.end(),
+                      current.getValues().begin() + static_cast<std::ptrdiff_t>(from),
+                      current.getValues().begin() + static_cast<std::ptrdiff_t>(to));
+        i += to - from;
+    }
+    if (i < end) {
+        const auto from = static_cast<std::ptrdiff_t>(i - sealedCount());
+        const auto to = static_cast<std::ptrdiff_t>(end - sealedCount());
+        timestamps.insert(timestamps.end(), tailTimestamps_.begin() + from, tailTimestamps_.begin() + to);
+        values.insert(values.end(), tailValues_.begin() + from, tailValues_.begin() + to);
+    }
+}
+
+}  // namespace ts
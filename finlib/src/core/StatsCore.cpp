@@ -4,47 +4,60 @@
 
 #include <Eigen/Dense>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <complex>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <numeric>
+#include <optional>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "Eigen/Core"
 #include "finlib/common/Error.hpp"
+#include "finlib/common/Execution.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
 using std::size_t;
 
 namespace ts::analysis::stats {
 
-double mean(Samples x) {
-    if (x.empty()) return 0.0;
-
-    size_t count{0};
-    double sum{0.0};
-    for (double v : x) {
-        if (std::isfinite(v)) {
-            sum += v;
-            ++count;
+namespace {
+// Calls f(v) for every sample that counts. An all-valid mask keeps the historical rule (skip
+// non-finite values); a real mask is trusted as is. Whole valid words run as a plain loop, the
+// others visit only their set bits.
+template <typename F>
+void forEachValid(Samples x, ValidityMask valid, F&& f) {
+    if (valid.allValid()) {
+        for (double v : x) {
+            if (std::isfinite(v)) f(v);
         }
+        return;
     }
-    if (count == 0) return 0.0;
-    return sum / static_cast<double>(count);
-}
-
-double varianceFast(Samples x, VarianceType type) {
-    // TODO(JBBLET) Look into the parallel algorithm to at least improve a bit;
-    if (x.empty()) return 0.0;
-    double M2{0.0}, mean{0.0};
-    size_t count{0};
-    for (double v : x) {
-        if (std::isfinite(v)) {
-            ++count;
-            double delta = v - mean;
-            mean += delta / static_cast<double>(count);
-            double delta2 = v - mean;
-            M2 += delta * delta2;
+    ensure<InvalidArgument>(valid.size() == x.size(), "validity mask has {} lanes for {} samples", valid.size(), x.size());
+    for (size_t base = 0, k = 0; base < x.size(); base += 64, ++k) {
+        uint64_t word = valid.word(k);
+        if (word == ~uint64_t{0}) {
+            for (size_t i = base; i < base + 64; ++i) f(x[i]);
+            continue;
+        }
+        while (word != 0) {
+            f(x[base + static_cast<size_t>(std::countr_zero(word))]);
+            word &= word - 1;
         }
     }
+}
+
+double finishVariance(double M2, size_t count, VarianceType type) {
     if (count == 0) return 0.0;
     if (type == VarianceType::Sample) {
         ensure<InvalidArgument>(count >= 2, "Sample variance of a single point is undefined");
@@ -56,80 +69,282 @@ double varianceFast(Samples x, VarianceType type) {
     throw InvalidArgument("Variance Type undefined: {}", type);
 }
 
-double varianceSlow(Samples x, VarianceType type) {
-    if (x.empty()) return 0.0;
+// Moments of one staged block: the mean and range first, then the power sums around the mean.
+// Both loops are branch-free over contiguous doubles, so the compiler vectorises them.
+Moments blockMoments(const double* values, size_t n) {
+    Moments block;
+    block.count = n;
+    double sum = 0.0;
+    double lo = values[0], hi = values[0];
+    for (size_t i = 0; i < n; ++i) {
+        sum += values[i];
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+    block.min = lo;
+    block.max = hi;
+    if (lo == hi) {
+        // A constant block. sum / n need not round back to the value (0.1 repeated does not),
+        // and the residue would leave m2 ~1e-34 where the degenerate-sample guards look for 0.
+        block.mean = lo;
+        return block;
+    }
+    block.mean = sum / static_cast<double>(n);
+    double m2 = 0.0, m3 = 0.0, m4 = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double d = values[i] - block.mean;
+        const double d2 = d * d;
+        m2 += d2;
+        m3 += d2 * d;
+        m4 += d2 * d2;
+    }
+    block.m2 = m2;
+    block.m3 = m3;
+    block.m4 = m4;
+    return block;
+}
 
-    double avg{mean(x)};
-    double M2{0.0};
-    size_t count{0};
+// moments() cuts the input into fixed index chunks of this many lanes (a multiple of the mask's
+// 64-lane words and of the staging block) and only goes parallel from kParallelMomentsThreshold
+// up, where the per-chunk work outweighs handing it to other threads.
+constexpr size_t kMomentChunk = 8192;
+constexpr size_t kParallelMomentsThreshold = 20000;
+
+// One chunk, sequentially: valid values are staged kBlock at a time and each block's moments are
+// folded into the running total.
+Moments chunkMoments(Samples x, ValidityMask valid) {
+    constexpr size_t kBlock = 256;
+    std::array<double, kBlock> staged;
+    size_t filled = 0;
+    Moments total;
+    forEachValid(x, valid, [&](double v) {
+        staged[filled++] = v;
+        if (filled == kBlock) {
+            total.merge(blockMoments(staged.data(), filled));
+            filled = 0;
+        }
+    });
+    if (filled != 0) total.merge(blockMoments(staged.data(), filled));
+    return total;
+}
+
+// Balanced pairwise fold split at the midpoint: the grouping is fixed by parts.size(), and merging
+// partials of similar size keeps the delta terms in Chan's update small.
+Moments reduceMoments(std::span<const Moments> parts) {
+    if (parts.size() == 1) return parts.front();
+    const size_t half = parts.size() / 2;
+    Moments left = reduceMoments(parts.first(half));
+    left.merge(reduceMoments(parts.subspan(half)));
+    return left;
+}
 
-    for (double v : x) {
-        if (std::isfinite(v)) {
-            M2 += (v - avg) * (v - avg);
-            ++count;
+// ---------------------------------------------------------------------------
+// FFT autocovariance
+// ---------------------------------------------------------------------------
+using Complex = std::complex<double>;
+
+// In-place iterative radix-2 FFT; a.size() must be a power of two. The inverse is unscaled.
+void fft(std::vector<Complex>& a, bool inverse) {
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; (j & bit) != 0; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const double angle = (inverse ? 2.0 : -2.0) * std::numbers::pi / static_cast<double>(len);
+        const size_t half = len / 2;
+        // Twiddles from the exact angle each time rather than by repeated multiplication, which
+        // would drift by ~len ulps across a stage.
+        std::vector<Complex> w(half);
+        for (size_t k = 0; k < half; ++k) w[k] = std::polar(1.0, angle * static_cast<double>(k));
+        for (size_t start = 0; start < n; start += len) {
+            for (size_t k = 0; k < half; ++k) {
+                const Complex u = a[start + k];
+                const Complex v = a[start + k + half] * w[k];
+                a[start + k] = u + v;
+                a[start + k + half] = u - v;
+            }
         }
     }
-    if (count == 0) return 0.0;
-    if (type == VarianceType::Sample) {
-        ensure<InvalidArgument>(count >= 2, "Sample variance of a single point is undefined");
-        return M2 / static_cast<double>(count - 1);
+}
+
+// gamma[k] = sum_i d[i] d[i + k] for k = 0..maxLag, where d = x - avg zero-padded to a power of two
+// N >= n + maxLag so the circular correlation never wraps into the lags asked for.
+//
+// A real signal of length N is packed into N/2 complex points (even samples real, odd samples
+// imaginary), so both transforms run at half length. The power spectrum |X|^2 is real and even,
+// and is unpacked back through the same split on the way in.
+std::vector<double> autocovariancesFft(Samples x, double avg, size_t maxLag) {
+    const size_t n = x.size();
+    const size_t N = std::max<size_t>(4, std::bit_ceil(n + maxLag));
+    const size_t M = N / 2;
+
+    std::vector<Complex> z(M);
+    for (size_t i = 0; i < n; ++i) {
+        const double d = x[i] - avg;
+        if (i % 2 == 0) {
+            z[i / 2].real(d);
+        } else {
+            z[i / 2].imag(d);
+        }
     }
-    if (type == VarianceType::Population) {
-        return M2 / static_cast<double>(count);
+    fft(z, false);
+
+    // Split Z into the spectra of the even and odd samples, recombine into X[k] (k = 0..M),
+    // take |X[k]|^2, and pack that (as a real even spectrum) straight back into Z for the inverse.
+    const double step = -2.0 * std::numbers::pi / static_cast<double>(N);
+    std::vector<double> power(M + 1);
+    for (size_t k = 0; k <= M; ++k) {
+        const Complex zk = z[k % M];
+        const Complex zc = std::conj(z[(M - k) % M]);
+        const Complex even = 0.5 * (zk + zc);
+        const Complex odd = Complex(0.0, -0.5) * (zk - zc);
+        power[k] = std::norm(even + std::polar(1.0, step * static_cast<double>(k)) * odd);
     }
-    throw InvalidArgument("Variance Type undefined: {}", type);
+    for (size_t k = 0; k < M; ++k) {
+        const double even = 0.5 * (power[k] + power[M - k]);
+        const Complex odd = 0.5 * (power[k] - power[M - k]) * std::polar(1.0, -step * static_cast<double>(k));
+        z[k] = even + Complex(0.0, 1.0) * odd;
+    }
+    fft(z, true);
+
+    std::vector<double> gamma(maxLag + 1);
+    const double scale = 1.0 / static_cast<double>(M);
+    for (size_t k = 0; k <= maxLag; ++k) gamma[k] = scale * (k % 2 == 0 ? z[k / 2].real() : z[k / 2].imag());
+    return gamma;
 }
 
-double standardDeviation(Samples x, VarianceType type) { return std::sqrt(varianceFast(x, type)); }
+// Appends gamma[firstLag..lastLag] one O(n) lag sum at a time.
+void appendLagSums(Samples x, double avg, size_t firstLag, size_t lastLag, std::vector<double>& gamma) {
+    const size_t n = x.size();
+    gamma.reserve(lastLag + 1);
+    for (size_t lag = firstLag; lag <= lastLag; ++lag) {
+        double value = 0.0;
+        for (size_t i = 0; i < n - lag; ++i) value += (x[i] - avg) * (x[i + lag] - avg);
+        gamma.push_back(value);
+    }
+}
 
-double skewness(Samples x) {
-    if (x.empty()) return 0.0;
+bool useFft(size_t n, size_t maxLag, CorrelationMethod method) {
+    switch (method) {
+        case CorrelationMethod::Direct: return false;
+        case CorrelationMethod::Fft: return true;
+        case CorrelationMethod::Auto: break;
+    }
+    return maxLag + 1 >= kFftMinLags && n * (maxLag + 1) >= kFftWorkThreshold;
+}
+}  // namespace
 
-    double avg = mean(x);
-    double sd = standardDeviation(x, VarianceType::Population);
-    if (sd == 0.0) return 0.0;  // degenerate sample: no shape to report
+// ---------------------------------------------------------------------------
+// Moments
+// ---------------------------------------------------------------------------
+double Moments::variance(VarianceType type) const { return finishVariance(m2, count, type); }
 
-    double M3 = 0.0;
-    size_t count{0};
-    for (double v : x) {
-        if (std::isfinite(v)) {
-            double z = (v - avg) / sd;
-            M3 += z * z * z;
-            ++count;
-        }
+double Moments::skewness() const {
+    if (count == 0 || m2 == 0.0) return 0.0;  // degenerate sample: no shape to report
+    const auto n = static_cast<double>(count);
+    return (m3 / n) / std::pow(m2 / n, 1.5);
+}
+
+double Moments::kurtosis() const {
+    if (count == 0 || m2 == 0.0) return 0.0;
+    ensure<InvalidArgument>(count >= 4, "Kurtosis undefined");
+    const auto n = static_cast<double>(count);
+    return n * m4 / (m2 * m2);
+}
+
+Moments moments(Samples x) { return moments(x, ValidityMask()); }
+
+Moments moments(Samples x, ValidityMask valid) {
+    if (!valid.allValid()) {
+        ensure<InvalidArgument>(
+            valid.size() == x.size(), "validity mask has {} lanes for {} samples", valid.size(), x.size());
+    }
+    const size_t chunks = (x.size() + kMomentChunk - 1) / kMomentChunk;
+    if (chunks <= 1) return chunkMoments(x, valid);
+
+    // The chunk boundaries and the reduction tree depend on x.size() alone, so running the chunks
+    // on one thread or many gives bit-identical results.
+    std::vector<Moments> parts(chunks);
+    std::vector<size_t> ordinals(chunks);
+    std::iota(ordinals.begin(), ordinals.end(), size_t{0});
+    auto runChunk = [&](size_t c) {
+        const size_t start = c * kMomentChunk;
+        const size_t len = std::min(kMomentChunk, x.size() - start);
+        parts[c] = chunkMoments(x.subspan(start, len), valid.subMask(start, len));
+    };
+    if (x.size() < kParallelMomentsThreshold) {
+        std::for_each(ordinals.begin(), ordinals.end(), runChunk);
+    } else {
+        std::for_each(kParallelPolicy, ordinals.begin(), ordinals.end(), runChunk);
     }
+    return reduceMoments(parts);
+}
+
+double mean(Samples x) { return mean(x, ValidityMask()); }
+
+double mean(Samples x, ValidityMask valid) {
+    if (x.empty()) return 0.0;
+
+    size_t count{0};
+    double sum{0.0};
+    forEachValid(x, valid, [&](double v) {
+        sum += v;
+        ++count;
+    });
     if (count == 0) return 0.0;
-    return M3 / static_cast<double>(count);
+    return sum / static_cast<double>(count);
 }
 
-namespace {
-double standardizedFourthMoment(Samples x) {
-    double avg = mean(x);
-    double sd = standardDeviation(x, VarianceType::Population);
-    if (sd == 0.0) return 0.0;
+double varianceFast(Samples x, VarianceType type) { return varianceFast(x, ValidityMask(), type); }
+
+double varianceFast(Samples x, ValidityMask valid, VarianceType type) {
+    if (x.empty()) return 0.0;
+    return moments(x, valid).variance(type);
+}
+
+double varianceSlow(Samples x, VarianceType type) { return varianceSlow(x, ValidityMask(), type); }
+
+double varianceSlow(Samples x, ValidityMask valid, VarianceType type) {
+    if (x.empty()) return 0.0;
 
-    double M4 = 0.0;
+    double avg{mean(x, valid)};
+    double M2{0.0};
     size_t count{0};
-    for (double v : x) {
-        if (std::isfinite(v)) {
-            double z2 = ((v - avg) / sd) * ((v - avg) / sd);
-            M4 += z2 * z2;
-            ++count;
-        }
-    }
-    ensure<InvalidArgument>(count >= 4, "Kurtosis undefined");
-    return M4 / static_cast<double>(count);
+    forEachValid(x, valid, [&](double v) {
+        M2 += (v - avg) * (v - avg);
+        ++count;
+    });
+    return finishVariance(M2, count, type);
 }
-}  // namespace
 
-double kurtosis(Samples x) {
+double standardDeviation(Samples x, VarianceType type) { return std::sqrt(varianceFast(x, type)); }
+
+double standardDeviation(Samples x, ValidityMask valid, VarianceType type) {
+    return std::sqrt(varianceFast(x, valid, type));
+}
+
+double skewness(Samples x) { return skewness(x, ValidityMask()); }
+
+double skewness(Samples x, ValidityMask valid) {
+    if (x.empty()) return 0.0;
+    return moments(x, valid).skewness();
+}
+
+double kurtosis(Samples x) { return kurtosis(x, ValidityMask()); }
+
+double kurtosis(Samples x, ValidityMask valid) {
     if (x.empty()) return 0.0;
-    return standardizedFourthMoment(x);
+    return moments(x, valid).kurtosis();
 }
 
-double excessKurtosis(Samples x) {
+double excessKurtosis(Samples x) { return excessKurtosis(x, ValidityMask()); }
+
+double excessKurtosis(Samples x, ValidityMask valid) {
     if (x.empty()) return 0.0;
-    return standardizedFourthMoment(x) - 3.0;
+    return moments(x, valid).excessKurtosis();
 }
 
 double quantileSorted(Samples sortedX, double q) {
@@ -159,44 +374,83 @@ double autocorrelationAt(Samples x, size_t lag) {
     return num / den;
 }
 
-std::vector<double> acf(Samples x, size_t maxLag) {
-    const size_t n = x.size();
-    if (n == 0) return {};
-    const size_t actualMaxLag = std::min(maxLag, n - 1);
-
-    double avg = mean(x);
+std::vector<double> acf(Samples x, size_t maxLag, CorrelationMethod method) {
+    auto gamma = autocovariances(x, maxLag, method);
+    if (gamma.empty()) return gamma;
+    const double denominator = gamma[0];
+    if (denominator == 0.0) return std::vector<double>(gamma.size(), 0.0);
+    for (double& g : gamma) g /= denominator;
+    return gamma;
+}
 
-    double denominator = 0.0;
-    for (double v : x) denominator += (v - avg) * (v - avg);
+std::vector<double> pacf(Samples x, size_t maxLag) {
+    return durbinLevinson(autocovariances(x, maxLag), maxLag).partialAutocorrelations;
+}
 
-    if (denominator == 0.0) return std::vector<double>(actualMaxLag + 1, 0.0);
+std::span<const double> DurbinLevinson::coefficients(size_t order) const {
+    ensure<InvalidArgument>(
+        order <= maxOrder(), "Durbin-Levinson: order {} requested, recursion ran to {}", order, maxOrder());
+    return std::span<const double>(coefficientTriangle).subspan(order * (order - 1) / 2, order);
+}
 
-    std::vector<double> acfCoeffs;
-    acfCoeffs.reserve(actualMaxLag + 1);
-    for (size_t lag = 0; lag <= actualMaxLag; ++lag) {
-        double numerator = 0.0;
-        for (size_t i = 0; i < n - lag; ++i) numerator += (x[i] - avg) * (x[i + lag] - avg);
-        acfCoeffs.push_back(numerator / denominator);
+DurbinLevinson durbinLevinson(Samples gamma, size_t maxLag) {
+    DurbinLevinson result;
+    if (gamma.empty()) return result;
+    const size_t order = std::min(maxLag, gamma.size() - 1);
+    result.partialAutocorrelations.reserve(order + 1);
+    result.innovationVariances.reserve(order + 1);
+    result.coefficientTriangle.reserve(order * (order + 1) / 2);
+    result.partialAutocorrelations.push_back(1.0);
+    result.innovationVariances.push_back(gamma[0]);
+
+    // Order k is built from order k - 1 in place at the end of the triangle:
+    //   phi_kk = (gamma_k - sum_j phi_{k-1,j} gamma_{k-j}) / v_{k-1}
+    //   phi_kj = phi_{k-1,j} - phi_kk phi_{k-1,k-j}
+    //   v_k    = v_{k-1} (1 - phi_kk^2)
+    std::vector<double>& triangle = result.coefficientTriangle;
+    for (size_t k = 1; k <= order; ++k) {
+        const size_t previous = triangle.size() - (k - 1);
+        const double variance = result.innovationVariances.back();
+        double reflection = 0.0;
+        if (variance > 0.0) {
+            double residual = gamma[k];
+            for (size_t j = 1; j < k; ++j) residual -= triangle[previous + j - 1] * gamma[k - j];
+            reflection = residual / variance;
+        }
+        for (size_t j = 1; j < k; ++j) {
+            triangle.push_back(triangle[previous + j - 1] - reflection * triangle[previous + k - j - 1]);
+        }
+        triangle.push_back(reflection);
+        result.partialAutocorrelations.push_back(reflection);
+        result.innovationVariances.push_back(std::max(0.0, variance * (1.0 - reflection * reflection)));
     }
-    return acfCoeffs;
+    return result;
 }
 
-std::vector<double> autocovariances(Samples x, size_t maxLag) {
-    const size_t n = x.size();
-    if (n == 0) return {};
-    const size_t actualMaxLag = std::min(maxLag, n - 1);
-
-    double avg = mean(x);
+std::vector<double> autocovariances(Samples x, size_t maxLag, CorrelationMethod method) {
     std::vector<double> gamma;
-    gamma.reserve(actualMaxLag + 1);
-    for (size_t lag = 0; lag <= actualMaxLag; ++lag) {
-        double value = 0.0;
-        for (size_t i = 0; i < n - lag; ++i) value += (x[i] - avg) * (x[i + lag] - avg);
-        gamma.push_back(value);
-    }
+    extendAutocovariances(x, gamma, maxLag, method);
     return gamma;
 }
 
+void extendAutocovariances(Samples x, std::vector<double>& gamma, size_t maxLag, CorrelationMethod method) {
+    const size_t n = x.size();
+    if (n == 0) return;
+    const size_t lastLag = std::min(maxLag, n - 1);
+    const size_t firstLag = gamma.size();
+    if (firstLag > lastLag) return;
+
+    const double avg = mean(x);
+    // The method is chosen on the lags still missing: a few more lags on a long series is
+    // cheaper as direct sums than as a full transform.
+    if (useFft(n, lastLag - firstLag, method)) {
+        const auto all = autocovariancesFft(x, avg, lastLag);
+        gamma.insert(gamma.end(), all.begin() + static_cast<std::ptrdiff_t>(firstLag), all.end());
+        return;
+    }
+    appendLagSums(x, avg, firstLag, lastLag, gamma);
+}
+
 Eigen::MatrixXd toeplitzFromSamples(Samples x, size_t maxLag) {
     return toeplitzFromAutocovariances(autocovariances(x, maxLag), std::min(maxLag, x.empty() ? 0 : x.size() - 1));
 }
@@ -216,6 +470,401 @@ Eigen::MatrixXd toeplitzFromAutocovariances(Samples gamma, size_t maxLag) {
 
 namespace ts::analysis::hypothesisTesting {
 
+namespace {
+using stats::Samples;
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+// What a constant sample gets: no statistic, but no exception to abort a batch either.
+constexpr HypothesisTestResult kUndefined{.statistic = kNaN, .p_value = kNaN};
+// Columns per breuschPagan work item: wide enough for the shared solve to run as a matrix
+// product, narrow enough that a batch of long series still spreads over every thread.
+constexpr Eigen::Index kBatchColumns = 64;
+
+// ---------------------------------------------------------------------------
+// Reference distributions
+// ---------------------------------------------------------------------------
+// log Gamma(k / 2) for an integer k >= 1, up the recurrence from Gamma(1/2) = sqrt(pi) and
+// Gamma(1) = 1. std::lgamma may write the global signgam, which the batch kernels would race on.
+double logGammaHalf(size_t k) {
+    double result = (k % 2 == 0) ? 0.0 : 0.5 * std::log(std::numbers::pi);
+    for (size_t j = (k % 2 == 0) ? 2 : 1; j + 2 <= k; j += 2) result += std::log(static_cast<double>(j) / 2.0);
+    return result;
+}
+
+// Upper tail of a chi-squared with `dof` degrees of freedom: the regularised incomplete gamma
+// Q(dof / 2, stat / 2), by its series below a + 1 and by Lentz's continued fraction above.
+double chiSquaredSurvival(double stat, size_t dof) {
+    if (!(stat > 0.0)) return 1.0;
+    const double a = static_cast<double>(dof) / 2.0;
+    const double x = stat / 2.0;
+    const double prefix = std::exp(a * std::log(x) - x - logGammaHalf(dof));
+    constexpr int kMaxIterations = 1000;
+    constexpr double kEpsilon = 1e-15;
+    constexpr double kTiny = 1e-300;
+    if (x < a + 1.0) {
+        double term = 1.0 / a;
+        double sum = term;
+        for (int k = 1; k < kMaxIterations && std::abs(term) > std::abs(sum) * kEpsilon; ++k) {
+            term *= x / (a + k);
+            sum += term;
+        }
+        return std::max(0.0, 1.0 - sum * prefix);
+    }
+    double b = x + 1.0 - a;
+    double c = 1.0 / kTiny;
+    double d = 1.0 / b;
+    double h = d;
+    for (int i = 1; i < kMaxIterations; ++i) {
+        const double an = -i * (i - a);
+        b += 2.0;
+        d = an * d + b;
+        if (std::abs(d) < kTiny) d = kTiny;
+        c = b + an / c;
+        if (std::abs(c) < kTiny) c = kTiny;
+        d = 1.0 / d;
+        const double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < kEpsilon) break;
+    }
+    return prefix * h;
+}
+
+double normalCdf(double z) { return 0.5 * std::erfc(-z / std::numbers::sqrt2); }
+
+// MacKinnon (1994) response-surface p-value for the Dickey-Fuller t-ratio, constant-only case
+// with one integrated variable: the normal CDF of a polynomial in tau, with separate fits for
+// the lower and upper part of the distribution.
+double mackinnonPValue(double tau) {
+    constexpr double kTauMax = 2.74;
+    constexpr double kTauMin = -18.83;
+    constexpr double kTauStar = -1.61;
+    if (tau > kTauMax) return 1.0;
+    if (tau < kTauMin) return 0.0;
+    if (tau <= kTauStar) return normalCdf(2.1659 + tau * (1.4412 + tau * 0.038269));
+    return normalCdf(1.7339 + tau * (0.93202 + tau * (-0.12745 + tau * -0.010368)));
+}
+
+// ---------------------------------------------------------------------------
+// Sample checks (run before any parallel work: a throw inside it would terminate)
+// ---------------------------------------------------------------------------
+void ensureGapFree(Samples x, std::string_view test, std::string_view id) {
+    const auto bad = std::ranges::find_if(x, [](double v) { return !std::isfinite(v); });
+    ensure<InvalidArgument>(bad == x.end(),
+                            "{}: '{}' has a missing or non-finite value at row {}",
+                            test,
+                            id,
+                            static_cast<size_t>(bad - x.begin()));
+}
+
+void ensureGapFree(const TimeSeriesView& view, std::string_view test) {
+    if (view.hasValidity() && view.validCount() < view.size()) {
+        size_t row = 0;
+        while (view.validity().isValid(row)) ++row;
+        throw InvalidArgument("{}: '{}' has a missing value at row {}", test, view.getTimeSeriesId(), row);
+    }
+    ensureGapFree(Samples(view), test, view.getTimeSeriesId());
+}
+
+size_t schwertLags(size_t n) { return static_cast<size_t>(12.0 * std::pow(static_cast<double>(n) / 100.0, 0.25)); }
+
+// ADF regresses n - 1 - p differences on p + 2 columns.
+size_t adfLags(size_t n, std::optional<size_t> lags, std::string_view id) {
+    ensure<InvalidArgument>(n >= 4, "adf: '{}' needs at least 4 points, got {}", id, n);
+    const size_t p = lags.value_or(std::min(schwertLags(n), (n - 4) / 2));
+    ensure<InvalidArgument>(n > 2 * p + 3, "adf: '{}' has {} points, too few for {} lags", id, n, p);
+    return p;
+}
+
+// The auxiliary regression has n - p rows and p + 1 columns.
+size_t breuschGodfreyLags(size_t n, std::optional<size_t> lags, std::string_view id) {
+    ensure<InvalidArgument>(n >= 4, "breuschGodfrey: '{}' needs at least 4 points, got {}", id, n);
+    const size_t p = lags.value_or(std::clamp<size_t>(schwertLags(n), 1, (n - 2) / 2));
+    ensure<InvalidArgument>(p >= 1, "breuschGodfrey: '{}' needs at least one lag", id);
+    ensure<InvalidArgument>(n > 2 * p + 1, "breuschGodfrey: '{}' has {} points, too few for {} lags", id, n, p);
+    return p;
+}
+
+void ensureBreuschPaganLength(size_t n, std::string_view id) {
+    ensure<InvalidArgument>(n >= 4, "breuschPagan: '{}' needs at least 4 points, got {}", id, n);
+}
+
+// ---------------------------------------------------------------------------
+// Kernels (inputs already validated; nothing here throws)
+// ---------------------------------------------------------------------------
+HypothesisTestResult jarqueBeraFromMoments(const stats::Moments& m) {
+    if (m.m2 == 0.0) return kUndefined;
+    const auto n = static_cast<double>(m.count);
+    const double skew = m.skewness();
+    const double excess = m.excessKurtosis();
+    const double statistic = n / 6.0 * (skew * skew + excess * excess / 4.0);
+    // The chi-squared survival function with 2 dof is exactly exp(-x / 2).
+    return {.statistic = statistic, .p_value = std::exp(-statistic / 2.0)};
+}
+
+// Least squares by column-pivoting QR: the ADF design puts a level next to an intercept, whose
+// condition number the normal equations would square.
+HypothesisTestResult adfKernel(Samples y, size_t p) {
+    const size_t n = y.size();
+    const auto m = static_cast<Eigen::Index>(n - 1 - p);
+    const auto k = static_cast<Eigen::Index>(p + 2);
+    Eigen::MatrixXd X(m, k);
+    Eigen::VectorXd dy(m);
+    for (Eigen::Index r = 0; r < m; ++r) {
+        const size_t t = p + 1 + static_cast<size_t>(r);
+        dy(r) = y[t] - y[t - 1];
+        X(r, 0) = 1.0;
+        X(r, 1) = y[t - 1];
+        for (size_t i = 1; i <= p; ++i) X(r, static_cast<Eigen::Index>(i + 1)) = y[t - i] - y[t - i - 1];
+    }
+    const Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(X);
+    if (qr.rank() < k) return kUndefined;
+    const Eigen::VectorXd beta = qr.solve(dy);
+    const double rss = (dy - X * beta).squaredNorm();
+    if (rss == 0.0) return kUndefined;
+
+    // Var(beta) = s^2 (X'X)^-1 = s^2 P R^-1 R^-T P'; only the level coefficient's entry is needed.
+    const Eigen::MatrixXd rInverse = qr.matrixR().topLeftCorner(k, k).triangularView<Eigen::Upper>().solve(
+        Eigen::MatrixXd::Identity(k, k));
+    const Eigen::MatrixXd permuted = qr.colsPermutation() * rInverse;
+    const double s2 = rss / static_cast<double>(m - k);
+    const double tau = beta(1) / std::sqrt(s2 * permuted.row(1).squaredNorm());
+    return {.statistic = tau, .p_value = mackinnonPValue(tau)};
+}
+
+HypothesisTestResult breuschGodfreyKernel(Samples x, size_t p) {
+    const size_t n = x.size();
+    double mean = 0.0;
+    for (double v : x) mean += v;
+    mean /= static_cast<double>(n);
+
+    const auto m = static_cast<Eigen::Index>(n - p);
+    const auto k = static_cast<Eigen::Index>(p + 1);
+    Eigen::MatrixXd X(m, k);
+    Eigen::VectorXd e(m);
+    for (Eigen::Index r = 0; r < m; ++r) {
+        const size_t t = p + static_cast<size_t>(r);
+        e(r) = x[t] - mean;
+        X(r, 0) = 1.0;
+        for (size_t i = 1; i <= p; ++i) X(r, static_cast<Eigen::Index>(i)) = x[t - i] - mean;
+    }
+    const double tss = (e.array() - e.mean()).square().sum();
+    if (tss == 0.0) return kUndefined;
+    const Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr(X);
+    const double rss = (e - X * qr.solve(e)).squaredNorm();
+    const double statistic = static_cast<double>(m) * (1.0 - rss / tss);
+    return {.statistic = statistic, .p_value = chiSquaredSurvival(statistic, p)};
+}
+
+// [1, t] on n rows, with t scaled to [0, 1) so both columns have comparable norms, and its
+// factorisation.
+struct TrendDesign {
+    Eigen::MatrixXd X;
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> qr;
+
+    explicit TrendDesign(Eigen::Index n) : X(n, 2) {
+        X.col(0).setOnes();
+        X.col(1) = Eigen::VectorXd::LinSpaced(n, 0.0, static_cast<double>(n - 1) / static_cast<double>(n));
+        qr.compute(X);
+    }
+};
+
+// Every column of Y through the same factorisation: both stages are one solve against a matrix
+// right-hand side, so a block of series costs about what one series does in BLAS-3 terms.
+void breuschPaganBlock(const TrendDesign& design, const Eigen::Ref<const Eigen::MatrixXd>& Y,
+                       std::span<HypothesisTestResult> out) {
+    const Eigen::MatrixXd& X = design.X;
+    const Eigen::MatrixXd residuals = Y - X * design.qr.solve(Y);
+    const Eigen::MatrixXd squared = residuals.array().square().matrix();
+    const Eigen::MatrixXd unexplained = squared - X * design.qr.solve(squared);
+    const auto n = static_cast<double>(Y.rows());
+    for (Eigen::Index j = 0; j < Y.cols(); ++j) {
+        const double tss = (squared.col(j).array() - squared.col(j).mean()).square().sum();
+        if (tss == 0.0) {
+            out[static_cast<size_t>(j)] = kUndefined;
+            continue;
+        }
+        const double statistic = n * (1.0 - unexplained.col(j).squaredNorm() / tss);
+        out[static_cast<size_t>(j)] = {.statistic = statistic, .p_value = chiSquaredSurvival(statistic, 1)};
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Batch plumbing
+// ---------------------------------------------------------------------------
+template <typename F>
+void parallelFor(size_t count, F&& f) {
+    std::vector<size_t> ordinals(count);
+    std::iota(ordinals.begin(), ordinals.end(), size_t{0});
+    std::for_each(kParallelPolicy, ordinals.begin(), ordinals.end(), f);
+}
+
+template <typename Kernel>
+std::vector<HypothesisTestResult> runBatch(size_t count, Kernel&& kernel) {
+    std::vector<HypothesisTestResult> results(count);
+    parallelFor(count, [&](size_t i) { results[i] = kernel(i); });
+    return results;
+}
+
+std::vector<HypothesisTestResult> finishJarqueBera(const std::vector<stats::Moments>& moments,
+                                                   std::span<const std::string> ids) {
+    std::vector<HypothesisTestResult> results(moments.size());
+    for (size_t i = 0; i < moments.size(); ++i) {
+        ensure<InvalidArgument>(moments[i].count >= 4,
+                                "jarqueBera: '{}' needs at least 4 present points, got {}",
+                                ids[i],
+                                moments[i].count);
+        results[i] = jarqueBeraFromMoments(moments[i]);
+    }
+    return results;
+}
+
+std::vector<std::string> viewIds(std::span<const TimeSeriesView> views) {
+    std::vector<std::string> ids;
+    ids.reserve(views.size());
+    for (const auto& view : views) ids.push_back(view.getTimeSeriesId());
+    return ids;
+}
+}  // namespace
+
 double PvalueFromTStatistic(double tStat) { return std::erfc(std::abs(tStat) / std::sqrt(2.0)); }
 
+// ---------------------------------------------------------------------------
+// Single series
+// ---------------------------------------------------------------------------
+HypothesisTestResult jarqueBera(Samples x) {
+    const stats::Moments m = stats::moments(x);
+    ensure<InvalidArgument>(m.count >= 4, "jarqueBera: needs at least 4 present points, got {}", m.count);
+    return jarqueBeraFromMoments(m);
+}
+
+HypothesisTestResult adf(Samples x, std::optional<size_t> lags) {
+    ensureGapFree(x, "adf", "sample");
+    return adfKernel(x, adfLags(x.size(), lags, "sample"));
+}
+
+HypothesisTestResult breuschPagan(Samples x) {
+    ensureGapFree(x, "breuschPagan", "sample");
+    ensureBreuschPaganLength(x.size(), "sample");
+    const auto n = static_cast<Eigen::Index>(x.size());
+    HypothesisTestResult result{};
+    breuschPaganBlock(TrendDesign(n), Eigen::Map<const Eigen::MatrixXd>(x.data(), n, 1), {&result, 1});
+    return result;
+}
+
+HypothesisTestResult breuschGodfrey(Samples x, std::optional<size_t> lags) {
+    ensureGapFree(x, "breuschGodfrey", "sample");
+    return breuschGodfreyKernel(x, breuschGodfreyLags(x.size(), lags, "sample"));
+}
+
+// ---------------------------------------------------------------------------
+// Batch
+// ---------------------------------------------------------------------------
+std::vector<HypothesisTestResult> jarqueBera(std::span<const TimeSeriesView> views) {
+    std::vector<stats::Moments> moments(views.size());
+    parallelFor(views.size(), [&](size_t i) { moments[i] = stats::moments(views[i], views[i].validity()); });
+    return finishJarqueBera(moments, viewIds(views));
+}
+
+std::vector<HypothesisTestResult> jarqueBera(const TimeSeriesPanel& panel) {
+    std::vector<stats::Moments> moments(panel.cols());
+    parallelFor(panel.cols(), [&](size_t j) { moments[j] = stats::moments(panel.column(j)); });
+    return finishJarqueBera(moments, panel.columnIds());
+}
+
+std::vector<HypothesisTestResult> adf(std::span<const TimeSeriesView> views, std::optional<size_t> lags) {
+    std::vector<size_t> orders(views.size());
+    for (size_t i = 0; i < views.size(); ++i) {
+        ensureGapFree(views[i], "adf");
+        orders[i] = adfLags(views[i].size(), lags, views[i].getTimeSeriesId());
+    }
+    return runBatch(views.size(), [&](size_t i) { return adfKernel(views[i], orders[i]); });
+}
+
+std::vector<HypothesisTestResult> adf(const TimeSeriesPanel& panel, std::optional<size_t> lags) {
+    if (panel.cols() == 0) return {};
+    size_t order = 0;
+    for (size_t j = 0; j < panel.cols(); ++j) {
+        ensureGapFree(panel.column(j), "adf", panel.columnIds()[j]);
+        order = adfLags(panel.rows(), lags, panel.columnIds()[j]);
+    }
+    return runBatch(panel.cols(), [&](size_t j) { return adfKernel(panel.column(j), order); });
+}
+
+std::vector<HypothesisTestResult> breuschPagan(std::span<const TimeSeriesView> views) {
+    // Series of equal length share one design; each length is factorised once, up front.
+    std::map<size_t, std::vector<size_t>> byLength;
+    for (size_t i = 0; i < views.size(); ++i) {
+        ensureGapFree(views[i], "breuschPagan");
+        ensureBreuschPaganLength(views[i].size(), views[i].getTimeSeriesId());
+        byLength[views[i].size()].push_back(i);
+    }
+    struct Block {
+        const TrendDesign* design;
+        std::span<const size_t> members;
+    };
+    std::map<size_t, TrendDesign> designs;
+    std::vector<Block> blocks;
+    for (const auto& [length, members] : byLength) {
+        const auto& design = designs.try_emplace(length, static_cast<Eigen::Index>(length)).first->second;
+        const std::span<const size_t> all(members);
+        for (size_t start = 0; start < all.size(); start += kBatchColumns) {
+            blocks.push_back({&design, all.subspan(start, std::min<size_t>(kBatchColumns, all.size() - start))});
+        }
+    }
+
+    std::vector<HypothesisTestResult> results(views.size());
+    parallelFor(blocks.size(), [&](size_t b) {
+        const Block& block = blocks[b];
+        const auto rows = static_cast<Eigen::Index>(views[block.members.front()].size());
+        Eigen::MatrixXd Y(rows, static_cast<Eigen::Index>(block.members.size()));
+        for (size_t c = 0; c < block.members.size(); ++c) {
+            Y.col(static_cast<Eigen::Index>(c)) = views[block.members[c]].asEigenVector();
+        }
+        std::vector<HypothesisTestResult> out(block.members.size());
+        breuschPaganBlock(*block.design, Y, out);
+        for (size_t c = 0; c < block.members.size(); ++c) results[block.members[c]] = out[c];
+    });
+    return results;
+}
+
+std::vector<HypothesisTestResult> breuschPagan(const TimeSeriesPanel& panel) {
+    if (panel.cols() == 0) return {};
+    for (size_t j = 0; j < panel.cols(); ++j) {
+        ensureGapFree(panel.column(j), "breuschPagan", panel.columnIds()[j]);
+        ensureBreuschPaganLength(panel.rows(), panel.columnIds()[j]);
+    }
+    // The panel is already one column-major block: each work item solves a slice of it in place.
+    const TrendDesign design(static_cast<Eigen::Index>(panel.rows()));
+    const auto Y = panel.asEigenMatrix();
+    const auto cols = static_cast<Eigen::Index>(panel.cols());
+    std::vector<HypothesisTestResult> results(panel.cols());
+    parallelFor(static_cast<size_t>((cols + kBatchColumns - 1) / kBatchColumns), [&](size_t b) {
+        const auto start = static_cast<Eigen::Index>(b) * kBatchColumns;
+        const auto width = std::min(kBatchColumns, cols - start);
+        breuschPaganBlock(design,
+                          Y.middleCols(start, width),
+                          std::span(results).subspan(static_cast<size_t>(start), static_cast<size_t>(width)));
+    });
+    return results;
+}
+
+std::vector<HypothesisTestResult> breuschGodfrey(std::span<const TimeSeriesView> views, std::optional<size_t> lags) {
+    std::vector<size_t> orders(views.size());
+    for (size_t i = 0; i < views.size(); ++i) {
+        ensureGapFree(views[i], "breuschGodfrey");
+        orders[i] = breuschGodfreyLags(views[i].size(), lags, views[i].getTimeSeriesId());
+    }
+    return runBatch(views.size(), [&](size_t i) { return breuschGodfreyKernel(views[i], orders[i]); });
+}
+
+std::vector<HypothesisTestResult> breuschGodfrey(const TimeSeriesPanel& panel, std::optional<size_t> lags) {
+    if (panel.cols() == 0) return {};
+    size_t order = 0;
+    for (size_t j = 0; j < panel.cols(); ++j) {
+        ensureGapFree(panel.column(j), "breuschGodfrey", panel.columnIds()[j]);
+        order = breuschGodfreyLags(panel.rows(), lags, panel.columnIds()[j]);
+    }
+    return runBatch(panel.cols(), [&](size_t j) { return breuschGodfreyKernel(panel.column(j), order); });
+}
+
 }  // namespace ts::analysis::hypothesisTesting
@@ -0,0 +1,189 @@
+// Copyright 2026 JBBLET
+#include "finlib/core/TDigest.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <format>
+#include <numbers>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "finlib/common/Error.hpp"
+#include "finlib/common/Format.hpp"
+
+namespace ts::analysis::stats {
+
+namespace {
+// k1(q) = δ / (2π) · asin(2q - 1). A centroid may span at most one unit of k, which keeps
+// centroids near q = 0 and q = 1 tiny and lets the middle ones grow.
+double scale(double q, double compression) {
+    return compression / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0);
+}
+
+double inverseScale(double k, double compression) {
+    const double bounded = std::clamp(k, -compression / 4.0, compression / 4.0);
+    return (std::sin(bounded * 2.0 * std::numbers::pi / compression) + 1.0) / 2.0;
+}
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// constructor
+// ---------------------------------------------------------------------------
+TDigest::TDigest(double compression) : compression_(compression) {
+    ensure<InvalidArgument>(compression_ >= 10.0, "TDigest: compression {} is below 10", compression_);
+    buffer_.reserve(kBufferFactor * static_cast<size_t>(compression_));
+}
+
+// ---------------------------------------------------------------------------
+// Accumulation
+// ---------------------------------------------------------------------------
+void TDigest::add(double x) {
+    if (!std::isfinite(x)) return;
+    buffer_.push_back(x);
+    ++count_;
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+    if (buffer_.size() >= kBufferFactor * static_cast<size_t>(compression_)) compress();
+}
+
+void TDigest::add(std::span<const double> x) {
+    for (double v : x) add(v);
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.empty()) return;
+    std::vector<Centroid> items = merged_();
+    const std::vector<Centroid> theirs = other.merged_();
+    items.insert(items.end(), theirs.begin(), theirs.end());
+    std::sort(items.begin(), items.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+    centroids_ = cluster_(std::move(items), compression_);
+    buffer_.clear();
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void TDigest::compress() {
+    if (buffer_.empty()) return;
+    centroids_ = merged_();
+    buffer_.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+std::vector<TDigest::Centroid> TDigest::centroids() const { return merged_(); }
+
+double TDigest::quantile(double q) const {
+    ensure<InvalidArgument>(!empty(), "TDigest: quantile of an empty sketch");
+    ensure<InvalidArgument>(q >= 0.0 && q <= 1.0, "TDigest: q must lie in [0, 1], got {}", q);
+    // The extremes are tracked exactly; an end centroid holding several samples would otherwise
+    // interpolate short of them.
+    if (q == 0.0) return min_;
+    if (q == 1.0) return max_;
+    const std::vector<Centroid> items = merged_();
+    const auto n = static_cast<double>(count_);
+    // Each centroid's mass is centred on its cumulative midpoint. A singleton at rank i (0-based)
+    // then sits at i + 1/2, so mapping q onto q (n - 1) + 1/2 reproduces quantileSorted exactly
+    // wherever no two samples were merged.
+    const double target = q * (n - 1.0) + 0.5;
+    const Centroid& first = items.front();
+    if (target < first.weight / 2.0) {
+        return min_ + (first.mean - min_) * target / (first.weight / 2.0);
+    }
+    double midpoint = first.weight / 2.0;
+    for (size_t i = 0; i + 1 < items.size(); ++i) {
+        const double next = midpoint + (items[i].weight + items[i + 1].weight) / 2.0;
+        if (target <= next) {
+            const double t = (target - midpoint) / (next - midpoint);
+            return items[i].mean + t * (items[i + 1].mean - items[i].mean);
+        }
+        midpoint = next;
+    }
+    const Centroid& last = items.back();
+    const double tail = n - midpoint;  // = last.weight / 2
+    return last.mean + (max_ - last.mean) * std::min(1.0, (target - midpoint) / tail);
+}
+
+double TDigest::cdf(double x) const {
+    if (empty() || x < min_) return 0.0;
+    if (x >= max_) return 1.0;
+    const std::vector<Centroid> items = merged_();
+    const auto n = static_cast<double>(count_);
+
+    // Walks the same piecewise-linear rank curve quantile() inverts.
+    double previousMean = min_;
+    double previousRank = 0.0;
+    double cumulative = 0.0;
+    for (const Centroid& c : items) {
+        const double rank = cumulative + c.weight / 2.0;
+        if (x < c.mean) {
+            const double t = c.mean > previousMean ? (x - previousMean) / (c.mean - previousMean) : 1.0;
+            return (previousRank + t * (rank - previousRank)) / n;
+        }
+        previousMean = c.mean;
+        previousRank = rank;
+        cumulative += c.weight;
+    }
+    const double t = max_ > previousMean ? (x - previousMean) / (max_ - previousMean) : 1.0;
+    return (previousRank + t * (n - previousRank)) / n;
+}
+
+// ---------------------------------------------------------------------------
+// Display
+// ---------------------------------------------------------------------------
+std::string TDigest::toString() const {
+    if (empty()) return std::format("TDigest[empty, compression={}]", compression_);
+    return std::format("TDigest[n={}, {} centroids, compression={}, {} .. {}]",
+                       count_,
+                       merged_().size(),
+                       compression_,
+                       fmt::formatDouble(min_),
+                       fmt::formatDouble(max_));
+}
+
+// ---------------------------------------------------------------------------
+// Private Helpers
+// ---------------------------------------------------------------------------
+std::vector<TDigest::Centroid> TDigest::merged_() const {
+    if (buffer_.empty()) return centroids_;
+    std::vector<Centroid> items;
+    items.reserve(centroids_.size() + buffer_.size());
+    items.insert(items.end(), centroids_.begin(), centroids_.end());
+    for (double v : buffer_) items.push_back({v, 1.0});
+    std::sort(items.begin(), items.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+    return cluster_(std::move(items), compression_);
+}
+
+// One left-to-right pass over mean-ordered items: each is folded into the open centroid while
+// the centroid still spans at most one unit of k, otherwise the centroid is closed.
+std::vector<TDigest::Centroid> TDigest::cluster_(std::vector<Centroid> items, double compression) {
+    if (items.empty()) return items;
+    double total = 0.0;
+    for (const Centroid& c : items) total += c.weight;
+
+    std::vector<Centroid> out;
+    out.reserve(static_cast<size_t>(compression));
+    Centroid open = items.front();
+    double closedWeight = 0.0;
+    double limit = total * inverseScale(scale(0.0, compression) + 1.0, compression);
+    for (size_t i = 1; i < items.size(); ++i) {
+        const Centroid& item = items[i];
+        if (closedWeight + open.weight + item.weight <= limit) {
+            open.weight += item.weight;
+            open.mean += (item.mean - open.mean) * item.weight / open.weight;
+        } else {
+            out.push_back(open);
+            closedWeight += open.weight;
+            limit = total * inverseScale(scale(closedWeight / total, compression) + 1.0, compression);
+            open = item;
+        }
+    }
+    out.push_back(open);
+    return out;
+}
+
+}  // namespace ts::analysis::stats
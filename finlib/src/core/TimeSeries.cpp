@@ -6,6 +6,7 @@
 #include <format>
 #include <iterator>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <print>
 #include <span>
@@ -16,6 +17,8 @@
 #include "finlib/common/Error.hpp"
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/Format.hpp"
+#include "finlib/common/Memory.hpp"
+#include "finlib/core/Kernels.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
 
 namespace ts {
@@ -26,7 +29,7 @@ namespace ts {
 TimeSeries::TimeSeries() : id_{""}, timestamps_{nullptr}, values_{} {}
 
 TimeSeries::TimeSeries(std::string id, Timestamps ts, std::vector<double> vals)
-    : id_(id), timestamps_(std::make_shared<const Timestamps>(std::move(ts))), values_(std::move(vals)) {
+    : id_(id), timestamps_(std::make_shared<const TimestampGrid>(std::move(ts))), values_(std::move(vals)) {
     ensure<InvalidArgument>(timestamps_->size() == values_.size(),
                             "Size mismatch between timestamps ({}) and values ({})",
                             timestamps_->size(),
@@ -42,6 +45,9 @@ TimeSeries::TimeSeries(std::string id, TimestampsPtr ts, std::vector<double> val
 }
 
 TimeSeries::TimeSeries(std::string id, TimestampsPtr sharedTimestamps, size_t tsOffset, std::vector<double> vals)
+    : TimeSeries(std::move(id), std::move(sharedTimestamps), tsOffset, ValueBuffer(std::move(vals))) {}
+
+TimeSeries::TimeSeries(std::string id, TimestampsPtr sharedTimestamps, size_t tsOffset, ValueBuffer vals)
     : id_(std::move(id)), timestamps_(std::move(sharedTimestamps)), tsOffset_(tsOffset), values_(std::move(vals)) {
     ensure<InvalidArgument>(tsOffset_ + values_.size() <= timestamps_->size(),
                             "TimeSeries: tsOffset ({}) + size ({}) exceeds timestamp vector length ({})",
@@ -54,145 +60,204 @@ TimeSeries::TimeSeries(std::string id, TimestampsPtr sharedTimestamps, size_t ts
 // Named Factory
 // ---------------------------------------------------------------------------
 TimeSeries TimeSeries::synthetic(std::string id, TimestampsPtr ts, std::vector<double> vals) {
-    TimeSeries s(std::move(id), std::move(ts), std::move(vals));
+    return synthetic(std::move(id), std::move(ts), ValueBuffer(std::move(vals)));
+}
+
+TimeSeries TimeSeries::synthetic(std::string id, TimestampsPtr ts, ValueBuffer vals) {
+    ensure<InvalidArgument>(ts->size() == vals.size(),
+                            "Size mismatch between timestamps ({}) and values ({})",
+                            ts->size(),
+                            vals.size());
+    TimeSeries s(std::move(id), std::move(ts), 0, std::move(vals));
     s.isSynthetic_ = true;
     return s;
 }
 
 // Timestamps Accessors
+// Through the grid rather than getTimestamps(): a regular grid answers arithmetically and is
+// never materialised for a lookup.
 size_t TimeSeries::lowerBound(Timestamp ts) const {
-    auto span = getTimestamps();
-    return std::distance(span.begin(), std::lower_bound(span.begin(), span.end(), ts));
+    if (!timestamps_) return 0;
+    return timestamps_->lowerBound(ts, tsOffset_, tsOffset_ + values_.size()) - tsOffset_;
 }
 size_t TimeSeries::upperBound(Timestamp ts) const {
-    auto span = getTimestamps();
-    return std::distance(span.begin(), std::upper_bound(span.begin(), span.end(), ts));
+    if (!timestamps_) return 0;
+    return timestamps_->upperBound(ts, tsOffset_, tsOffset_ + values_.size()) - tsOffset_;
 }
 std::optional<double> TimeSeries::exactValue(Timestamp ts) const {
     size_t idx = lowerBound(ts);
-    auto span = getTimestamps();
-    if (idx < values_.size() && span[idx] == ts) return values_[idx];
+    if (idx < values_.size() && (*timestamps_)[tsOffset_ + idx] == ts && isValid(idx)) return values_[idx];
     return std::nullopt;
 }
 double TimeSeries::latestValue(Timestamp ts) const {
     ensure(!values_.empty(), "TimeSeries::latestValue: empty series '{}'", id_);
-    size_t idx = lowerBound(ts);
+    // Last point at or before ts, then back over any missing lanes.
+    size_t idx = upperBound(ts);
+    while (idx != 0 && !isValid(idx - 1)) --idx;
     ensure(idx != 0, "TimeSeries::latestValue: ts before start of series '{}'", id_);
-    auto span = getTimestamps();
-    if (idx < values_.size() && span[idx] == ts) return values_[idx];
     return values_[idx - 1];
 }
 
+// ---------------------------------------------------------------------------
+// Validity
+// ---------------------------------------------------------------------------
+TimeSeries& TimeSeries::setValidity(ValidityBitmap bitmap) {
+    ensure<InvalidArgument>(bitmap.size() == values_.size(),
+                            "TimeSeries::setValidity: bitmap has {} lanes for {:s}",
+                            bitmap.size(),
+                            *this);
+    if (bitmap.allValid()) {
+        validity_.reset();
+    } else {
+        validity_ = std::make_shared<const ValidityBitmap>(std::move(bitmap));
+    }
+    return *this;
+}
+
+TimeSeries& TimeSeries::markMissing() { return setValidity(ValidityBitmap::fromValues(values_.span())); }
+
+TimeSeries TimeSeries::dropInvalid() const {
+    if (!validity_) return *this;
+    const auto& values = values_.get();
+    const size_t valid = validity_->countValid();
+    Timestamps timestamps;
+    std::pmr::vector<double> kept(memory::currentResource());
+    timestamps.reserve(valid);
+    kept.reserve(valid);
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (!validity_->isValid(i)) continue;
+        timestamps.push_back((*timestamps_)[tsOffset_ + i]);
+        kept.push_back(values[i]);
+    }
+    TimeSeries result(
+        id_, std::make_shared<const TimestampGrid>(std::move(timestamps)), 0, ValueBuffer(std::move(kept)));
+    result.isSynthetic_ = isSynthetic_;
+    return result;
+}
+
 // ---------------------------------------------------------------------------
 // Operator Overloading
 // ---------------------------------------------------------------------------
 
+// The compound forms run the kernel in place (out aliases values_, cloned first only if another
+// copy still shares it); the binary forms write straight into a fresh buffer instead of
+// copying *this first and then overwriting it. Kernels run over every lane, missing or not:
+// the payload of a missing lane is don't-care, and the validity bitmaps are ANDed afterwards.
+
 // Operator *
 TimeSeries& TimeSeries::operator*=(const TimeSeries& other) {
     verifyAlignment_(other);
-    for (size_t i = 0; i < values_.size(); ++i) {
-        values_[i] *= other.values_[i];
-    }
+    const auto values = values_.mutate();
+    kernels::mul(values, other.values_.get(), values);
+    validity_ = combinedValidity_(other);
     return *this;
 }
 
 TimeSeries TimeSeries::operator*(const TimeSeries& other) const {
-    TimeSeries temp = TimeSeries{*this};
-    temp *= other;
-    return temp;
+    verifyAlignment_(other);
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::mul(values_.get(), other.values_.get(), out);
+    TimeSeries result = withValues_(ValueBuffer(std::move(out)));
+    result.validity_ = combinedValidity_(other);
+    return result;
 }
 
 TimeSeries& TimeSeries::operator*=(double scalar) {
-    for (double& v : values_) {
-        v *= scalar;
-    }
+    const auto values = values_.mutate();
+    kernels::mul(values, scalar, values);
     return *this;
 }
 
 TimeSeries TimeSeries::operator*(double scalar) const {
-    TimeSeries temp = TimeSeries{*this};
-    temp *= scalar;
-    return temp;
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::mul(values_.get(), scalar, out);
+    return withValues_(ValueBuffer(std::move(out)));
 }
 
 // Operator /
 TimeSeries& TimeSeries::operator/=(const TimeSeries& other) {
     verifyAlignment_(other);
-    for (size_t i = 0; i < values_.size(); ++i) {
-        other.values_[i] == 0.0 ? values_[i] = 0.0 : values_[i] /= other.values_[i];
-    }
+    const auto values = values_.mutate();
+    kernels::div(values, other.values_.get(), values);  // zero divisors yield 0
+    validity_ = combinedValidity_(other);
     return *this;
 }
 
 TimeSeries TimeSeries::operator/(const TimeSeries& other) const {
-    TimeSeries temp = TimeSeries{*this};
-    temp /= other;
-    return temp;
+    verifyAlignment_(other);
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::div(values_.get(), other.values_.get(), out);
+    TimeSeries result = withValues_(ValueBuffer(std::move(out)));
+    result.validity_ = combinedValidity_(other);
+    return result;
 }
 
 TimeSeries& TimeSeries::operator/=(double scalar) {
     ensure(scalar != 0.0, "Division by 0 of TimeSeries {}", id_);
-    for (double& v : values_) {
-        v /= scalar;
-    }
+    const auto values = values_.mutate();
+    kernels::div(values, scalar, values);
     return *this;
 }
 
 TimeSeries TimeSeries::operator/(double scalar) const {
     ensure(scalar != 0.0, "Division by 0 of TimeSeries {}", id_);
-    TimeSeries temp = TimeSeries{*this};
-    temp /= scalar;
-    return temp;
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::div(values_.get(), scalar, out);
+    return withValues_(ValueBuffer(std::move(out)));
 }
 
 // Operator +
 TimeSeries& TimeSeries::operator+=(const TimeSeries& other) {
     verifyAlignment_(other);
-    for (size_t i = 0; i < values_.size(); ++i) {
-        values_[i] += other.values_[i];
-    }
+    const auto values = values_.mutate();
+    kernels::add(values, other.values_.get(), values);
+    validity_ = combinedValidity_(other);
     return *this;
 }
 TimeSeries TimeSeries::operator+(const TimeSeries& other) const {
-    TimeSeries temp = TimeSeries{*this};
-    temp += other;
-    return temp;
+    verifyAlignment_(other);
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::add(values_.get(), other.values_.get(), out);
+    TimeSeries result = withValues_(ValueBuffer(std::move(out)));
+    result.validity_ = combinedValidity_(other);
+    return result;
 }
 TimeSeries& TimeSeries::operator+=(double scalar) {
-    for (double& v : values_) {
-        v += scalar;
-    }
+    const auto values = values_.mutate();
+    kernels::add(values, scalar, values);
     return *this;
 }
 TimeSeries TimeSeries::operator+(double scalar) const {
-    TimeSeries temp = TimeSeries{*this};
-    temp += scalar;
-    return temp;
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::add(values_.get(), scalar, out);
+    return withValues_(ValueBuffer(std::move(out)));
 }
 
 // Operator -
 TimeSeries& TimeSeries::operator-=(const TimeSeries& other) {
     verifyAlignment_(other);
-    for (size_t i = 0; i < values_.size(); ++i) {
-        values_[i] -= other.values_[i];
-    }
+    const auto values = values_.mutate();
+    kernels::sub(values, other.values_.get(), values);
+    validity_ = combinedValidity_(other);
     return *this;
 }
 TimeSeries TimeSeries::operator-(const TimeSeries& other) const {
-    TimeSeries temp = TimeSeries{*this};
-    temp -= other;
-    return temp;
+    verifyAlignment_(other);
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::sub(values_.get(), other.values_.get(), out);
+    TimeSeries result = withValues_(ValueBuffer(std::move(out)));
+    result.validity_ = combinedValidity_(other);
+    return result;
 }
 TimeSeries& TimeSeries::operator-=(double scalar) {
-    for (double& v : values_) {
-        v -= scalar;
-    }
+    const auto values = values_.mutate();
+    kernels::sub(values, scalar, values);
     return *this;
 }
 TimeSeries TimeSeries::operator-(double scalar) const {
-    TimeSeries temp = TimeSeries{*this};
-    temp -= scalar;
-    return temp;
+    auto out = ValueBuffer::allocate(values_.size());
+    kernels::sub(values_.get(), scalar, out);
+    return withValues_(ValueBuffer(std::move(out)));
 }
 
 // ---------------------------------------------------------------------------
@@ -209,12 +274,14 @@ std::string TimeSeries::toString(const fmt::FormatSpec& spec) const {
     if (values_.empty()) {
         identity += " [empty";
     } else if (dated) {
-        const auto span = getTimestamps();
-        identity +=
-            std::format(" [n={}, {} .. {}", values_.size(), fmt::AsDate{span.front()}, fmt::AsDate{span.back()});
+        // Indexed, not getTimestamps(): naming a series must not materialise a regular grid.
+        const Timestamp first = (*timestamps_)[tsOffset_];
+        const Timestamp last = (*timestamps_)[tsOffset_ + values_.size() - 1];
+        identity += std::format(" [n={}, {} .. {}", values_.size(), fmt::AsDate{first}, fmt::AsDate{last});
     } else {
         identity += std::format(" [n={}, undated", values_.size());
     }
+    if (validity_) identity += std::format(", missing={}", values_.size() - validity_->countValid());
     if (isSynthetic_) identity += ", synthetic";
     identity += ']';
 
@@ -222,9 +289,9 @@ std::string TimeSeries::toString(const fmt::FormatSpec& spec) const {
         case fmt::FormatMode::Identity:
             return identity;
         case fmt::FormatMode::Describe:
-            return fmt::renderDescribe(identity, values_, spec.precision);
+            return fmt::renderDescribe(identity, values_.get(), spec.precision);
         default:
-            return fmt::renderSeries(identity, dated ? getTimestamps() : std::span<const Timestamp>{}, values_, spec);
+            return fmt::renderSeries(identity, dated ? getTimestamps() : std::span<const Timestamp>{}, values_.get(), spec);
     }
 }
 
@@ -253,14 +320,35 @@ TimeSeriesView TimeSeries::sliceIndex(size_t start, size_t end) const {
 // Private Helpers
 // ---------------------------------------------------------------------------
 
+TimeSeries TimeSeries::withValues_(ValueBuffer vals) const {
+    // Field by field rather than through a constructor: the sizes already match by
+    // construction, and a default-constructed (timestamp-less) operand must not throw here.
+    TimeSeries result;
+    result.id_ = id_;
+    result.timestamps_ = timestamps_;
+    result.tsOffset_ = tsOffset_;
+    result.values_ = std::move(vals);
+    result.validity_ = validity_;
+    result.isSynthetic_ = isSynthetic_;
+    return result;
+}
+
+std::shared_ptr<const ValidityBitmap> TimeSeries::combinedValidity_(const TimeSeries& other) const {
+    if (!other.validity_ || validity_ == other.validity_) return validity_;
+    if (!validity_) return other.validity_;
+    auto combined = ValidityBitmap::combine(validity_->mask(), other.validity_->mask(), size());
+    return std::make_shared<const ValidityBitmap>(std::move(combined));
+}
+
 void TimeSeries::verifyAlignment_(const TimeSeries& other) const {
     // Fast path: same backing vector at the same offset — definitely aligned.
     if (timestamps_ == other.timestamps_ && tsOffset_ == other.tsOffset_) return;
     // Both messages name the operands: which two series met is the first thing anyone asks,
     // and the identity form carries the id and the date span without dumping the values.
     ensure<InvalidArgument>(this->size() == other.size(), "TimeSeries size mismatch: {:s} vs {:s}", *this, other);
-    // Slow path: compare only the slices each series actually represents.
-    ensure<InvalidArgument>(std::equal(getTimestamps().begin(), getTimestamps().end(), other.getTimestamps().begin()),
+    if (size() == 0) return;
+    // Slow path: compare only the slices each series actually represents (O(1) for two regular grids).
+    ensure<InvalidArgument>(timestamps_->matches(tsOffset_, *other.timestamps_, other.tsOffset_, size()),
                             "TimeSeries timestamps do not match: {:s} vs {:s}",
                             *this,
                             other);
@@ -0,0 +1,205 @@
+// "Copyright (c) 2026 JBBLET All Rights Reserved."
+#include "finlib/core/TimeSeriesPanel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <format>
+#include <memory>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "finlib/common/Error.hpp"
+#include "finlib/common/FinlibTypes.hpp"
+#include "finlib/common/Format.hpp"
+#include "finlib/common/utils/TimeUtils.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+
+namespace ts {
+
+// ---------------------------------------------------------------------------
+// constructor
+// ---------------------------------------------------------------------------
+TimeSeriesPanel::TimeSeriesPanel(TimestampsPtr timestamps, std::vector<std::string> columnIds)
+    : timestamps_(std::move(timestamps)), columnIds_(std::move(columnIds)) {
+    ensure<InvalidArgument>(timestamps_ != nullptr, "TimeSeriesPanel: timestamps must not be null");
+    rows_ = timestamps_->size();
+    values_.assign(rows_ * columnIds_.size(), 0.0);
+}
+
+TimeSeriesPanel::TimeSeriesPanel(TimestampsPtr timestamps, std::vector<std::string> columnIds,
+                                 std::vector<double> columnMajor)
+    : TimeSeriesPanel(timestamps, 0, timestamps ? timestamps->size() : 0, std::move(columnIds), std::move(columnMajor)) {}
+
+TimeSeriesPanel::TimeSeriesPanel(TimestampsPtr timestamps, size_t tsOffset, size_t rows,
+                                 std::vector<std::string> columnIds, std::vector<double> columnMajor)
+    : timestamps_(std::move(timestamps)),
+      tsOffset_(tsOffset),
+      rows_(rows),
+      columnIds_(std::move(columnIds)),
+      values_(std::move(columnMajor)) {
+    ensure<InvalidArgument>(timestamps_ != nullptr, "TimeSeriesPanel: timestamps must not be null");
+    ensure<InvalidArgument>(tsOffset_ + rows_ <= timestamps_->size(),
+                            "TimeSeriesPanel: tsOffset ({}) + rows ({}) exceeds timestamp vector length ({})",
+                            tsOffset_,
+                            rows_,
+                            timestamps_->size());
+    ensure<InvalidArgument>(values_.size() == rows_ * columnIds_.size(),
+                            "TimeSeriesPanel: {} values for {} rows x {} columns",
+                            values_.size(),
+                            rows_,
+                            columnIds_.size());
+}
+
+// ---------------------------------------------------------------------------
+// Named Factory
+// ---------------------------------------------------------------------------
+TimeSeriesPanel TimeSeriesPanel::fromSeries(std::span<const TimeSeries* const> series) {
+    ensure<InvalidArgument>(!series.empty(), "TimeSeriesPanel::fromSeries: no series given");
+    const TimeSeries& first = *series.front();
+    for (const TimeSeries* s : series.subspan(1)) {
+        // Fast path first, exactly as TimeSeries::verifyAlignment_ does it.
+        if (s->getSharedTimestamps() == first.getSharedTimestamps() && s->tsOffset() == first.tsOffset() &&
+            s->size() == first.size()) {
+            continue;
+        }
+        ensure<InvalidArgument>(s->size() == first.size(), "TimeSeriesPanel size mismatch: {:s} vs {:s}", first, *s);
+        ensure<InvalidArgument>(first.size() == 0 || first.getSharedTimestamps()->matches(first.tsOffset(),
+                                                                                          *s->getSharedTimestamps(),
+                                                                                          s->tsOffset(),
+                                                                                          first.size()),
+                                "TimeSeriesPanel timestamps do not match: {:s} vs {:s}",
+                                first,
+                                *s);
+    }
+
+    const size_t rows = first.size();
+    std::vector<std::string> ids;
+    ids.reserve(series.size());
+    std::vector<double> block(rows * series.size());
+    for (size_t j = 0; j < series.size(); ++j) {
+        ids.push_back(series[j]->getId());
+        std::ranges::copy(series[j]->getValues(), block.begin() + static_cast<std::ptrdiff_t>(j * rows));
+    }
+    return TimeSeriesPanel(first.getSharedTimestamps(), first.tsOffset(), rows, std::move(ids), std::move(block));
+}
+
+TimeSeriesPanel TimeSeriesPanel::fromSeries(std::span<const TimeSeries> series) {
+    std::vector<const TimeSeries*> pointers;
+    pointers.reserve(series.size());
+    for (const TimeSeries& s : series) pointers.push_back(&s);
+    return fromSeries(std::span<const TimeSeries* const>(pointers));
+}
+
+// ---------------------------------------------------------------------------
+// Accessors
+// ---------------------------------------------------------------------------
+size_t TimeSeriesPanel::columnIndex(std::string_view id) const {
+    const auto it = std::ranges::find(columnIds_, id);
+    ensure<InvalidArgument>(it != columnIds_.end(), "TimeSeriesPanel: no column '{}' in {:s}", id, *this);
+    return static_cast<size_t>(std::distance(columnIds_.begin(), it));
+}
+
+std::span<const Timestamp> TimeSeriesPanel::getTimestamps() const {
+    if (!timestamps_) return {};
+    return timestamps_->span().subspan(tsOffset_, rows_);
+}
+
+// ---------------------------------------------------------------------------
+// Transformation Method
+// ---------------------------------------------------------------------------
+TimeSeriesView TimeSeriesPanel::columnView(size_t col) const {
+    ensure<InvalidArgument>(col < cols(), "TimeSeriesPanel: column {} out of range ({} columns)", col, cols());
+    return TimeSeriesView(ViewBacking{.owner = shared_from_this(),
+                                      .id = std::make_shared<const std::string>(columnIds_[col]),
+                                      .values = values_.data() + col * rows_,
+                                      .size = rows_,
+                                      .timestamps = timestamps_,
+                                      .tsOffset = tsOffset_},
+                          0,
+                          rows_);
+}
+
+TimeSeriesView TimeSeriesPanel::columnView(std::string_view id) const { return columnView(columnIndex(id)); }
+
+TimeSeries TimeSeriesPanel::columnSeries(size_t col) const {
+    ensure<InvalidArgument>(col < cols(), "TimeSeriesPanel: column {} out of range ({} columns)", col, cols());
+    const auto values = column(col);
+    return TimeSeries(columnIds_[col], timestamps_, tsOffset_, std::vector<double>(values.begin(), values.end()));
+}
+
+// ---------------------------------------------------------------------------
+// Display
+// ---------------------------------------------------------------------------
+
+std::string TimeSeriesPanel::toString(const fmt::FormatSpec& spec) const {
+    const auto timestamps = getTimestamps();
+    std::string identity = std::format("TimeSeriesPanel [{} x {}", rows_, cols());
+    if (rows_ > 0 && timestamps.size() == rows_) {
+        identity += std::format(", {} .. {}", fmt::AsDate{timestamps.front()}, fmt::AsDate{timestamps.back()});
+    }
+    identity += ']';
+
+    switch (spec.mode) {
+        case fmt::FormatMode::Identity:
+            return identity;
+        case fmt::FormatMode::Describe: {
+            std::string out = identity + '\n';
+            for (size_t j = 0; j < cols(); ++j) out += fmt::renderDescribe(columnIds_[j], column(j), spec.precision);
+            return out;
+        }
+        default:
+            break;
+    }
+
+    // Same head / ellipsis / tail layout as renderSeries, one value column per series.
+    std::string out = identity + '\n';
+    if (empty()) return out;
+    size_t headRows = 0;
+    size_t tailRows = 0;
+    if (spec.mode == fmt::FormatMode::Head) {
+        headRows = std::min(spec.count, rows_);
+    } else if (spec.mode == fmt::FormatMode::Tail) {
+        tailRows = std::min(spec.count, rows_);
+    } else if (rows_ <= spec.count) {
+        headRows = rows_;
+    } else {
+        headRows = tailRows = std::max<size_t>(spec.count / 2, 1);
+    }
+
+    std::vector<std::string> headers{"index", "date"};
+    std::vector<fmt::Table::Align> alignment{fmt::Table::Align::Right, fmt::Table::Align::Left};
+    std::vector<fmt::ColumnFormat> formats;
+    for (size_t j = 0; j < cols(); ++j) {
+        headers.push_back(columnIds_[j]);
+        alignment.push_back(fmt::Table::Align::Right);
+        formats.push_back(fmt::columnFormat(column(j), spec.precision));
+    }
+    fmt::Table table(std::move(headers), std::move(alignment));
+    auto emit = [&](size_t i) {
+        std::vector<std::string> cells{std::format("{}", i), common::utils::time::msToStringDate(timestamps[i])};
+        for (size_t j = 0; j < cols(); ++j) cells.push_back(formats[j]((*this)(i, j)));
+        table.addRow(std::move(cells));
+    };
+    for (size_t i = 0; i < headRows; ++i) emit(i);
+    if (headRows + tailRows < rows_) table.addRow(std::vector<std::string>(cols() + 2, "..."));
+    for (size_t i = rows_ - tailRows; i < rows_; ++i) emit(i);
+
+    out += table.render();
+    if (headRows + tailRows < rows_) out += std::format("[{} rows, {} shown]\n", rows_, headRows + tailRows);
+    return out;
+}
+
+void TimeSeriesPanel::println(const fmt::FormatSpec& spec) const { std::println("{}", toString(spec)); }
+
+void TimeSeriesPanel::head(size_t rows) const { println({.mode = fmt::FormatMode::Head, .count = rows}); }
+
+void TimeSeriesPanel::tail(size_t rows) const { println({.mode = fmt::FormatMode::Tail, .count = rows}); }
+
+void TimeSeriesPanel::describe() const { println({.mode = fmt::FormatMode::Describe}); }
+
+}  // namespace ts
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <format>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <print>
 #include <span>
@@ -16,93 +17,118 @@
 #include "finlib/common/Error.hpp"
 #include "finlib/common/FinlibTypes.hpp"
 #include "finlib/common/Format.hpp"
+#include "finlib/common/Memory.hpp"
+#include "finlib/core/Kernels.hpp"
 #include "finlib/core/TimeSeries.hpp"
 
-using std::vector;
 namespace ts {
 TimeSeriesView::TimeSeriesView(std::shared_ptr<const TimeSeries> src, size_t start, size_t len, int lag)
-    : source_(std::move(src)), begin_(start), length_(len), valueLag_(lag) {
-    ensure(static_cast<int>(begin_) - valueLag_ >= 0 && (begin_ + length_ - valueLag_) <= source_->size(),
+    : TimeSeriesView(ViewBacking{.owner = src,
+                                 .storage = src->getValueStorage(),
+                                 .id = std::make_shared<const std::string>(src->getId()),
+                                 .values = src->getValues().data(),
+                                 .size = src->size(),
+                                 .timestamps = src->getSharedTimestamps(),
+                                 .tsOffset = src->tsOffset(),
+                                 .validity = src->getSharedValidity()},
+                     start,
+                     len,
+                     lag) {}
+
+TimeSeriesView::TimeSeriesView(ViewBacking backing, size_t start, size_t len, int lag)
+    : backing_(std::move(backing)), begin_(start), length_(len), valueLag_(lag) {
+    ensure(static_cast<int>(begin_) - valueLag_ >= 0 && (begin_ + length_ - valueLag_) <= backing_.size,
            "View window/lag exceeds data boundaries");
 }
 
-Timestamp TimeSeriesView::timestamp(size_t i) const { return source_->getTimestamps()[begin_ + i]; }
+Timestamp TimeSeriesView::timestamp(size_t i) const { return (*backing_.timestamps)[backing_.tsOffset + begin_ + i]; }
 
-const double* TimeSeriesView::begin() const noexcept { return &(source_->getValues()[begin_ - valueLag_]); }
+std::span<const Timestamp> TimeSeriesView::getTimestamps() const {
+    // Same clamp as toString: a positive lag lets the window run past the last timestamp.
+    if (!backing_.timestamps) return {};
+    const auto all = backing_.timestamps->span().subspan(backing_.tsOffset, backing_.size);
+    const size_t available = begin_ < all.size() ? std::min(length_, all.size() - begin_) : 0;
+    return all.subspan(begin_ < all.size() ? begin_ : all.size(), available);
+}
+
+const double* TimeSeriesView::begin() const noexcept { return backing_.values + (begin_ - valueLag_); }
 
 const double* TimeSeriesView::end() const noexcept { return begin() + length_; }
 
-double TimeSeriesView::operator[](size_t i) const { return source_->getValues()[begin_ + i - valueLag_]; }
+double TimeSeriesView::operator[](size_t i) const { return backing_.values[begin_ + i - valueLag_]; }
+
+ValidityMask TimeSeriesView::validity() const {
+    if (!backing_.validity) return {};
+    return backing_.validity->mask(begin_ - valueLag_, length_);
+}
+
+TimeSeries TimeSeriesView::materialise_(const std::string& id, std::pmr::vector<double> vals,
+                                        std::optional<ValidityBitmap> validity) const {
+    TimeSeries series(id, getSharedTimestamps(), tsOffset(), ValueBuffer(std::move(vals)));
+    if (validity) series.setValidity(std::move(*validity));
+    return series;
+}
 
-TimeSeries TimeSeriesView::materialise_(const std::string& id, std::vector<double> vals) const {
-    return TimeSeries(id, source_->getSharedTimestamps(), source_->tsOffset() + begin_, std::move(vals));
+std::optional<ValidityBitmap> TimeSeriesView::ownValidity_() const {
+    if (!hasValidity()) return std::nullopt;
+    return ValidityBitmap::fromMask(validity(), length_);
+}
+
+std::optional<ValidityBitmap> TimeSeriesView::combinedValidity_(const TimeSeriesView& other) const {
+    if (!hasValidity() && !other.hasValidity()) return std::nullopt;
+    return ValidityBitmap::combine(validity(), other.validity(), length_);
 }
 
 TimeSeries TimeSeriesView::operator+(const double& scalar) const {
-    vector<double> result;
-    result.reserve(length_);
-    for (size_t i = 0; i < length_; ++i) result.push_back((*this)[i] + scalar);
-    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result));
+    auto result = ValueBuffer::allocate(length_);
+    kernels::add(*this, scalar, result);
+    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result), ownValidity_());
 }
 
 TimeSeries TimeSeriesView::operator-(const double& scalar) const {
-    vector<double> result;
-    result.reserve(length_);
-    for (size_t i = 0; i < length_; ++i) result.push_back((*this)[i] - scalar);
-    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result));
+    auto result = ValueBuffer::allocate(length_);
+    kernels::sub(*this, scalar, result);
+    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result), ownValidity_());
 }
 
 TimeSeries TimeSeriesView::operator*(const double& scalar) const {
-    vector<double> result;
-    result.reserve(length_);
-    for (size_t i = 0; i < length_; ++i) result.push_back((*this)[i] * scalar);
-    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result));
+    auto result = ValueBuffer::allocate(length_);
+    kernels::mul(*this, scalar, result);
+    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result), ownValidity_());
 }
 
 TimeSeries TimeSeriesView::operator+(const TimeSeriesView& other) const {
     ensure(isAlignedWith(other), "views are not aligned: {:s} vs {:s}", *this, other);
-    vector<double> result;
-    result.reserve(length_);
-    for (size_t i = 0; i < length_; ++i) result.push_back((*this)[i] + other[i]);
-    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result));
+    auto result = ValueBuffer::allocate(length_);
+    kernels::add(*this, other, result);
+    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result), combinedValidity_(other));
 }
 
 TimeSeries TimeSeriesView::operator-(const TimeSeriesView& other) const {
     ensure(isAlignedWith(other), "views are not aligned: {:s} vs {:s}", *this, other);
-    vector<double> result;
-    result.reserve(length_);
-    for (size_t i = 0; i < length_; ++i) result.push_back((*this)[i] - other[i]);
-    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result));
+    auto result = ValueBuffer::allocate(length_);
+    kernels::sub(*this, other, result);
+    return materialise_("ViewChange " + getTimeSeriesId(), std::move(result), combinedValidity_(other));
 }
 
 TimeSeries TimeSeriesView::operator*(const TimeSeriesView& other) const {
     ensure(isAlignedWith(other), "views are not aligned: {:s} vs {:s}", *this, other);
-    vector<double> result;
-    result.reserve(length_);
-    for (size_t i = 0; i < length_; ++i) result.push_back((*this)[i] * other[i]);
-    return materialise_(getTimeSeriesId() + " * " + other.getTimeSeriesId(), std::move(result));
+    auto result = ValueBuffer::allocate(length_);
+    kernels::mul(*this, other, result);
+    return materialise_(getTimeSeriesId() + " * " + other.getTimeSeriesId(), std::move(result), combinedValidity_(other));
 }
 
 bool TimeSeriesView::isAlignedWith(const TimeSeriesView& other) const {
     if (length_ != other.length_) return false;
     // Fast path: same physical timestamp range — pointer into the backing array is identical.
-    if (source_->getTimestamps().data() + begin_ == other.source_->getTimestamps().data() + other.begin_) {
-        return true;
-    }
-    // Slow path: element-by-element comparison.
-    const auto ts1 = source_->getTimestamps();
-    const auto ts2 = other.source_->getTimestamps();
-    for (size_t i = 0; i < length_; ++i) {
-        if (ts1[begin_ + i] != ts2[other.begin_ + i]) return false;
-    }
-    return true;
+    if (backing_.timestamps == other.backing_.timestamps && tsOffset() == other.tsOffset()) return true;
+    // Slow path: compare the two windows on their grids (O(1) when both are regular).
+    return backing_.timestamps->matches(tsOffset(), *other.backing_.timestamps, other.tsOffset(), length_);
 }
 
 TimeSeries TimeSeriesView::toSeries() const {
-    vector<double> result;
-    result.reserve(length_);
-    for (size_t i = 0; i < length_; i++) result.push_back((*this)[i]);
-    return materialise_("View_Copy " + getTimeSeriesId(), std::move(result));
+    std::pmr::vector<double> result(begin(), end(), memory::currentResource());
+    return materialise_("View_Copy " + getTimeSeriesId(), std::move(result), ownValidity_());
 }
 
 // ---------------------------------------------------------------------------
@@ -110,23 +136,17 @@ TimeSeries TimeSeriesView::toSeries() const {
 // ---------------------------------------------------------------------------
 
 std::string TimeSeriesView::toString(const fmt::FormatSpec& spec) const {
-    if (source_ == nullptr) return "TimeSeriesView [detached]";
+    if (backing_.owner == nullptr) return "TimeSeriesView [detached]";
 
-    const bool empty = (length_ == 0 || source_->size() == 0);
+    const bool empty = (length_ == 0 || backing_.size == 0);
     const auto values = empty ? std::span<const double>{} : std::span<const double>{begin(), length_};
 
     // A positive lag lets the value window run past the end of the timestamp vector, so
     // the dates are taken only as far as they actually exist. renderSeries drops the date
     // column when it gets a short span rather than reading off the end.
-    std::span<const Timestamp> timestamps;
-    if (!empty) {
-        const auto sourceTimestamps = source_->getTimestamps();
-        const size_t available =
-            begin_ < sourceTimestamps.size() ? std::min(length_, sourceTimestamps.size() - begin_) : 0;
-        timestamps = sourceTimestamps.subspan(begin_, available);
-    }
+    const std::span<const Timestamp> timestamps = empty ? std::span<const Timestamp>{} : getTimestamps();
 
-    std::string identity = std::format("TimeSeriesView '{}'", source_->getId());
+    std::string identity = std::format("TimeSeriesView '{}'", getTimeSeriesId());
     if (empty) {
         identity += " [empty";
     } else {
@@ -135,6 +155,7 @@ std::string TimeSeriesView::toString(const fmt::FormatSpec& spec) const {
             identity += std::format(", {} .. {}", fmt::AsDate{timestamps.front()}, fmt::AsDate{timestamps.back()});
         }
     }
+    if (!empty && hasValidity()) identity += std::format(", missing={}", length_ - validCount());
     if (valueLag_ != 0) identity += std::format(", lag={}", valueLag_);
     identity += ']';
 
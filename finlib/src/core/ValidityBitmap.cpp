@@ -0,0 +1,94 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#include "finlib/core/ValidityBitmap.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace ts {
+namespace {
+constexpr size_t wordsFor(size_t lanes) { return (lanes + 63) / 64; }
+
+// Keeps the low `lanes` bits of a word (lanes in [0, 64]).
+constexpr uint64_t lowBits(size_t lanes) { return lanes >= 64 ? ~uint64_t{0} : (uint64_t{1} << lanes) - 1; }
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// ValidityMask
+// ---------------------------------------------------------------------------
+uint64_t ValidityMask::word(size_t k) const {
+    const size_t first = 64 * k;
+    if (first >= size_) return 0;
+    const size_t lanes = std::min<size_t>(64, size_ - first);
+    if (!words_) return lowBits(lanes);
+    const size_t bit = offset_ + first;
+    const size_t q = bit >> 6;
+    const size_t r = bit & 63;
+    uint64_t w = words_[q] >> r;
+    // The high part comes from the next word only if the window actually reaches into it.
+    if (r != 0 && r + lanes > 64) w |= words_[q + 1] << (64 - r);
+    return w & lowBits(lanes);
+}
+
+size_t ValidityMask::countValid() const {
+    size_t count = 0;
+    for (size_t k = 0; k < wordsFor(size_); ++k) count += static_cast<size_t>(std::popcount(word(k)));
+    return count;
+}
+
+// ---------------------------------------------------------------------------
+// ValidityBitmap
+// ---------------------------------------------------------------------------
+ValidityBitmap::ValidityBitmap(size_t size, bool valid)
+    : words_(wordsFor(size), valid ? ~uint64_t{0} : uint64_t{0}), size_(size) {
+    // Bits past size_ stay clear so countValid() can popcount whole words.
+    if (valid && size_ % 64 != 0) words_.back() = lowBits(size_ % 64);
+}
+
+ValidityBitmap ValidityBitmap::fromValues(std::span<const double> values) {
+    ValidityBitmap bitmap(values.size(), false);
+    for (size_t k = 0; k < bitmap.words_.size(); ++k) {
+        const size_t first = 64 * k;
+        const size_t lanes = std::min<size_t>(64, values.size() - first);
+        uint64_t w = 0;
+        for (size_t j = 0; j < lanes; ++j) w |= static_cast<uint64_t>(!std::isnan(values[first + j])) << j;
+        bitmap.words_[k] = w;
+    }
+    return bitmap;
+}
+
+ValidityBitmap ValidityBitmap::fromMask(ValidityMask mask, size_t size) {
+    if (mask.allValid()) return ValidityBitmap(size, true);
+    ValidityBitmap bitmap(size, false);
+    for (size_t k = 0; k < bitmap.words_.size(); ++k) bitmap.words_[k] = mask.word(k);
+    return bitmap;
+}
+
+ValidityBitmap ValidityBitmap::combine(ValidityMask a, ValidityMask b, size_t size) {
+    ValidityBitmap bitmap(size, false);
+    for (size_t k = 0; k < bitmap.words_.size(); ++k) {
+        const uint64_t all = lowBits(std::min<size_t>(64, size - 64 * k));
+        bitmap.words_[k] = (a.allValid() ? all : a.word(k)) & (b.allValid() ? all : b.word(k));
+    }
+    return bitmap;
+}
+
+void ValidityBitmap::set(size_t i, bool valid) {
+    const uint64_t bit = uint64_t{1} << (i & 63);
+    if (valid) {
+        words_[i >> 6] |= bit;
+    } else {
+        words_[i >> 6] &= ~bit;
+    }
+}
+
+size_t ValidityBitmap::countValid() const {
+    size_t count = 0;
+    for (uint64_t w : words_) count += static_cast<size_t>(std::popcount(w));
+    return count;
+}
+
+}  // namespace ts
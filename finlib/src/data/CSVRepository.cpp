@@ -84,7 +84,7 @@ void CSVRepository::doMerge(const SeriesKey& key, const TimeSeries& newData) {
     const auto& newTs = newData.getTimestamps();
     const auto& newVals = newData.getValues();
     for (size_t i = 0; i < newData.size(); ++i) {
-        combined[newTs[i]] = newVals[i];
+        if (newData.isValid(i)) combined[newTs[i]] = newVals[i];  // a gap never overwrites a stored point
     }
 
     // Build merged TimeSeries
@@ -196,7 +196,9 @@ void CSVRepository::writeCsv_(const SeriesKey& key, const TimeSeries& ts) const
     CSVWriterHeaderAware writer{CSVWriter{file, ';'}, {"timestamp", "value"}};
     const auto& timestamps = ts.getTimestamps();
     const auto& values = ts.getValues();
+    // The file lists the points that exist: missing lanes are not written.
     for (size_t i = 0; i < ts.size(); ++i) {
+        if (!ts.isValid(i)) continue;
         writer.writeMap(Row{{"timestamp", std::to_string(timestamps[i])}, {"value", std::format("{}", values[i])}},
                         false);
     }
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -16,34 +17,20 @@
 #include "finlib/common/Log.hpp"
 #include "finlib/core/Resampling.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/CoverageInfo.hpp"
 #include "finlib/data/SeriesKey.hpp"
 #include "finlib/data/TimeRange.hpp"
 
 namespace {
-ts::TimeSeries stripNaN(ts::TimeSeries series) {
-    const auto stamps = series.getTimestamps();
-    const auto& vals = series.getValues();
-    std::vector<int64_t> cleanTs;
-    std::vector<double> cleanVals;
-    cleanTs.reserve(stamps.size());
-    cleanVals.reserve(vals.size());
-    for (size_t i = 0; i < stamps.size(); ++i) {
-        if (!std::isnan(vals[i])) {
-            cleanTs.push_back(stamps[i]);
-            cleanVals.push_back(vals[i]);
-        }
-    }
-    return ts::TimeSeries(series.getId(), std::move(cleanTs), std::move(cleanVals));
-}
-
 int64_t nowMs() {
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch())
         .count();
 }
 
-ts::Timestamp minSpacing(const ts::Timestamps& grid) {
+ts::Timestamp minSpacing(const ts::TimestampGrid& grid) {
     if (grid.size() < 2) return INT64_MAX;
+    if (grid.isRegular()) return grid.step();
     ts::Timestamp best = INT64_MAX;
     for (size_t i = 1; i < grid.size(); ++i) {
         const ts::Timestamp d = grid[i] - grid[i - 1];
@@ -104,38 +91,144 @@ TimeSeries TimeSeriesService::loadBucket_(const std::string& id, Timestamp start
         }
     } else {
         logging::info("loadBucket_ '{}' freq={}ms: provider full fetch [{}, {}]", id, providerFreq, startMs, endMs);
-        TimeSeries fetched = stripNaN(provider_->load(id, startMs, endMs, providerFreq));
-        ensure(fetched.size() != 0, "TimeSeriesService::loadBucket_: provider returned no data for '{}'", id);
+        // Provider NaNs are flagged in place, not stripped: no copy of the values or the grid.
+        TimeSeries fetched = provider_->load(id, startMs, endMs, providerFreq);
+        fetched.markMissing();
+        ensure(fetched.validCount() != 0, "TimeSeriesService::loadBucket_: provider returned no data for '{}'", id);
         cache_->save(key, fetched);  // persists down to the DB (coverage computed on read)
     }
     return cache_->load(key, startMs, endMs);
 }
 
 TimeSeries TimeSeriesService::getRaw(const std::string& id, Timestamp startMs, Timestamp endMs, Timestamp coarsestMs) {
-    // Finest available (most points) within the optional cap.
-    return loadBucket_(id, startMs, endMs, coarsestMs, /*finestFirst=*/true);
+    // Finest available (most points) within the optional cap. Raw means the points that exist:
+    // flagged gaps are compacted away here, which costs nothing when there are none.
+    return loadBucket_(id, startMs, endMs, coarsestMs, /*finestFirst=*/true).dropInvalid();
 }
 
 TimeSeries TimeSeriesService::getAligned(const std::string& id, TimestampsPtr grid) {
     ensure<InvalidArgument>(grid && !grid->empty(), "TimeSeriesService::getAligned: grid must be non-empty.");
     // Analysis: coarsest bucket fine enough to resolve the grid (else throw — no fabrication).
     TimeSeries bucket = loadBucket_(id, grid->front(), grid->back(), minSpacing(*grid), /*finestFirst=*/false);
-    return resample(bucket, std::move(grid), InterpolationStrategy::Exact);
+    return resample_(bucket, std::move(grid), InterpolationStrategy::Exact);
 }
 
 TimeSeries TimeSeriesService::getFilled(const std::string& id, TimestampsPtr grid, InterpolationStrategy strategy) {
     ensure<InvalidArgument>(grid && !grid->empty(), "TimeSeriesService::getFilled: grid must be non-empty.");
     // Graphing: coarsest available bucket (interpolation may upsample from coarser data).
     TimeSeries bucket = loadBucket_(id, grid->front(), grid->back(), INT64_MAX, /*finestFirst=*/false);
-    return resample(bucket, std::move(grid), strategy);
+    return resample_(bucket, std::move(grid), strategy);
 }
 
 TimeSeries TimeSeriesService::getFilled(const std::string& id, Timestamp startMs, Timestamp endMs, Timestamp freqMs,
                                         InterpolationStrategy strategy) {
-    auto grid = std::make_shared<Timestamps>();
-    for (Timestamp t = startMs; t <= endMs; t += freqMs) grid->push_back(t);
-    if (grid->empty()) grid->push_back(startMs);
-    return getFilled(id, std::move(grid), strategy);
+    ensure<InvalidArgument>(freqMs > 0, "TimeSeriesService::getFilled: freqMs must be positive, got {}", freqMs);
+    // Implicit (start, step, count) grid: nothing per point is allocated unless a caller asks
+    // the result for a timestamp span. Interned, so every asset filled over the same window
+    // shares one grid. A reversed range still yields the single tick startMs.
+    const size_t count = endMs >= startMs ? static_cast<size_t>((endMs - startMs) / freqMs) + 1 : 1;
+    return getFilled(id, TimestampGrid::regular(startMs, freqMs, count), strategy);
+}
+
+TimeSeries TimeSeriesService::aggregationSource_(const std::string& id, const TimestampGrid& grid) {
+    ensure<InvalidArgument>(!grid.empty(), "TimeSeriesService::getAggregated: grid must be non-empty.");
+    // The last bucket runs one step past the grid's end (see ts::aggregate), so the load does too.
+    const size_t n = grid.size();
+    const Timestamp end = n > 1 ? grid.back() + (grid.back() - grid[n - 2]) - 1 : grid.back();
+    // Bars are only as good as the points inside them: finest first, and never a bucket as
+    // coarse as the grid, which would hand back one point per bar.
+    return loadBucket_(id, grid.front(), end, minSpacing(grid) - 1, /*finestFirst=*/true);
+}
+
+TimeSeries TimeSeriesService::getAggregated(const std::string& id, TimestampsPtr grid, Aggregation aggregation) {
+    ensure<InvalidArgument>(grid != nullptr, "TimeSeriesService::getAggregated: grid must be non-empty.");
+    // Loaded before the call: the grid is moved into it, and argument order is unspecified.
+    const TimeSeries source = aggregationSource_(id, *grid);
+    return aggregate(source, std::move(grid), aggregation);
+}
+
+TimeSeriesPanel TimeSeriesService::getAggregated(const std::string& id, TimestampsPtr grid,
+                                                 std::span<const Aggregation> columns) {
+    ensure<InvalidArgument>(grid != nullptr, "TimeSeriesService::getAggregated: grid must be non-empty.");
+    const TimeSeries source = aggregationSource_(id, *grid);
+    return aggregate(source, std::move(grid), columns);
+}
+
+TimeSeries TimeSeriesService::resample_(const TimeSeries& bucket, TimestampsPtr grid, InterpolationStrategy strategy) {
+    // Stochastic has no plan; evenly spaced grids need none, the arithmetic path is as cheap.
+    if (strategy == InterpolationStrategy::Stochastic || resamplesArithmetically(bucket, *grid, strategy)) {
+        return resample(bucket, std::move(grid), strategy);
+    }
+    // Plans are keyed on the grid object, so equal grids from different callers must be one.
+    grid = TimestampGrid::intern(std::move(grid));
+
+    // Candidates are copied out under the lock and confirmed outside it: appliesTo() may compare
+    // every timestamp and lane, and other threads should not queue behind that.
+    std::vector<std::shared_ptr<const InterpolationPlan>> candidates;
+    {
+        const std::lock_guard lock(planMutex_);
+        for (const auto& p : plans_) {
+            if (p->target() == grid && p->strategy() == strategy) candidates.push_back(p);
+        }
+    }
+    for (const auto& plan : candidates) {
+        if (!plan->appliesTo(bucket)) continue;
+        {
+            const std::lock_guard lock(planMutex_);
+            const auto at = std::find(plans_.begin(), plans_.end(), plan);
+            if (at != plans_.end()) {
+                plans_.erase(at);
+                plans_.push_front(plan);
+            }
+        }
+        return resample(bucket, *plan);
+    }
+
+    const TimestampGrid& source = *bucket.getSharedTimestamps();
+    const PlanKey key{grid.get(),
+                      strategy,
+                      source[bucket.tsOffset()],
+                      source[bucket.tsOffset() + bucket.size() - 1],
+                      bucket.size(),
+                      bucket.validCount()};
+    bool repeated = false;
+    {
+        const std::lock_guard lock(planMutex_);
+        const auto seen = std::find(seenOnce_.begin(), seenOnce_.end(), key);
+        repeated = seen != seenOnce_.end();
+        if (repeated) {
+            seenOnce_.erase(seen);
+        } else {
+            seenOnce_.push_front(key);
+            if (seenOnce_.size() > kSeenKeys) seenOnce_.pop_back();
+        }
+    }
+    if (!repeated) return resample(bucket, std::move(grid), strategy);
+
+    // Built outside the lock; two threads missing on the same key both build, harmlessly.
+    auto plan = std::make_shared<const InterpolationPlan>(bucket, std::move(grid), strategy);
+    {
+        const std::lock_guard lock(planMutex_);
+        plans_.push_front(plan);
+        planBytes_ += plan->bytes();
+        // Oldest out first; a plan larger than the whole budget serves this call and is dropped.
+        while (planBytes_ > kPlanCacheBytes) {
+            planBytes_ -= plans_.back()->bytes();
+            plans_.pop_back();
+        }
+    }
+    return resample(bucket, *plan);
+}
+
+TimeSeriesPanel TimeSeriesService::getFilledMany(const std::vector<std::string>& ids, TimestampsPtr grid,
+                                                 InterpolationStrategy strategy) {
+    ensure<InvalidArgument>(grid && !grid->empty(), "TimeSeriesService::getFilledMany: grid must be non-empty.");
+    std::vector<TimeSeries> buckets;
+    buckets.reserve(ids.size());
+    for (const std::string& id : ids) {
+        buckets.push_back(loadBucket_(id, grid->front(), grid->back(), INT64_MAX, /*finestFirst=*/false));
+    }
+    return resampleMany(buckets, std::move(grid), strategy, {}, ids);
 }
 
 double TimeSeriesService::getSinglePoint(const std::string& id, Timestamp ts) { return singlePoint_(id, ts, false); }
@@ -163,12 +256,11 @@ double TimeSeriesService::singlePoint_(const std::string& id, Timestamp ts, bool
         const Timestamp windowMs = std::max((minRange / 2) + 1, 5 * freqMs);
 
         TimeSeries raw = provider_->load(id, ts - windowMs, ts + windowMs);
-        if (raw.size() > 0) {
-            auto providerExact = raw.exactValue(ts);
-            TimeSeries clean = stripNaN(std::move(raw));
-            if (clean.size() > 0) cache_->merge(SeriesKey{id, freqMs}, clean);
-            if (providerExact.has_value() && !std::isnan(*providerExact)) return *providerExact;
-            if (!requireExact && clean.size() > 0) return clean.latestValue(ts);
+        raw.markMissing();
+        if (raw.validCount() > 0) {
+            cache_->merge(SeriesKey{id, freqMs}, raw);
+            if (auto providerExact = raw.exactValue(ts)) return *providerExact;
+            if (!requireExact) return raw.latestValue(ts);
         }
     }
 
@@ -209,9 +301,9 @@ void TimeSeriesService::fetchAndMergeGaps_(const SeriesKey& key, const std::vect
     for (const auto& gap : gaps) {
         // Skip gaps narrower than the series interval — nothing new to fetch there.
         if (gap.endTimeStampMs - gap.startTimeStampMs < key.frequencyInMs) continue;
-        TimeSeries gapData =
-            stripNaN(provider_->load(key.SeriesId, gap.startTimeStampMs, gap.endTimeStampMs, key.frequencyInMs));
-        if (gapData.size() > 0) cache_->merge(key, gapData);
+        TimeSeries gapData = provider_->load(key.SeriesId, gap.startTimeStampMs, gap.endTimeStampMs, key.frequencyInMs);
+        gapData.markMissing();
+        if (gapData.validCount() > 0) cache_->merge(key, gapData);
     }
 }
 
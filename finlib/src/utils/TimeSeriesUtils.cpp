@@ -24,13 +24,10 @@ TimestampsPtr makeRegularTimestamps(Timestamp beginMs, Timestamp endMs, Timestam
     ensure<InvalidArgument>(endMs >= beginMs, "makeRegularTimestamps: endMs ({}) must be >= beginMs ({})", endMs,
                             beginMs);
 
-    Timestamps timestamps;
-    const size_t expected = static_cast<size_t>((endMs - beginMs) / frequencyMs) + 1;
-    timestamps.reserve(expected);
-    for (Timestamp t = beginMs; t <= endMs; t += frequencyMs) {
-        timestamps.push_back(t);
-    }
-    return std::make_shared<const Timestamps>(std::move(timestamps));
+    const size_t count = static_cast<size_t>((endMs - beginMs) / frequencyMs) + 1;
+    // Interned: every request for the same window and step gets the same grid, so series built
+    // on it align by pointer.
+    return TimestampGrid::regular(beginMs, frequencyMs, count);
 }
 
 TimeSeries generateConstantTimeSeries(const std::string& id, Timestamp beginMs, Timestamp endMs, Timestamp frequencyMs,
@@ -5,6 +5,7 @@
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "finapp/data/repository/implementation/InMemoryRepository/InMemoryAssetRepository.hpp"
 #include "finapp/data/repository/interface/IAssetRepository.hpp"
@@ -14,6 +15,7 @@
 #include "finapp/service/AssetService.hpp"
 #include "finlib/common/utils/TimeSeriesUtils.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/implementation/CachedTimeSeriesRepository.hpp"
 #include "finlib/data/implementation/InMemoryTimeSeriesRepository.hpp"
 #include "finlib/data/services/TimeSeriesService.hpp"
@@ -149,6 +151,32 @@ TEST_F(AssetServiceTest, LoadTimeSeriesValueSharedTimestampsForCash) {
     }
 }
 
+TEST_F(AssetServiceTest, LoadTimeSeriesValuesMatchesOneLoadPerAsset) {
+    equityRepo->save(std::make_shared<finance::Equity>("AAPL", "Apple Inc.", finance::Currency::USD));
+    equityRepo->save(std::make_shared<finance::Equity>("MSFT", "Microsoft", finance::Currency::USD));
+    provider->setSeries("AAPL", finapp::test::makeRampSeries("AAPL", 0, 6 * kDay, kDay, 170.0, 1.5));
+    provider->setSeries("MSFT", finapp::test::makeRampSeries("MSFT", 0, 6 * kDay, kDay, 410.0, -2.0));
+
+    // Half-day grid: every other row falls between observations and takes the latest one.
+    auto timestamps = ts::common::utils::timeSeries::makeRegularTimestamps(0, 4 * kDay, kDay / 2);
+    const std::vector<finance::AssetId> ids{finance::AssetId{finance::AssetType::Equity, "AAPL"},
+                                            finance::AssetId{finance::AssetType::Cash, "USD"},
+                                            finance::AssetId{finance::AssetType::Equity, "MSFT"}};
+    const ts::TimeSeriesPanel panel = service->loadTimeSeriesValues(ids, timestamps);
+    ASSERT_EQ(panel.cols(), ids.size());
+    EXPECT_EQ(panel.getSharedTimestamps().get(), timestamps.get());
+    for (size_t j = 0; j < ids.size(); ++j) {
+        EXPECT_EQ(panel.columnIds()[j], ids[j].ticker);
+        const TimeSeries single = service->loadTimeSeriesValue(ids[j], timestamps);
+        for (size_t i = 0; i < timestamps->size(); ++i) {
+            EXPECT_DOUBLE_EQ(panel(i, j), single.getValues()[i]) << ids[j].ticker << " row " << i;
+        }
+    }
+    EXPECT_DOUBLE_EQ(panel(3, 0), 171.5);  // 1.5 days in: the day-1 close
+    EXPECT_DOUBLE_EQ(panel(3, 1), 1.0);
+    EXPECT_THROW(service->loadTimeSeriesValues(ids, TimestampsPtr{}), std::invalid_argument);
+}
+
 TEST_F(AssetServiceTest, LoadTimeSeriesValueSharedTimestampsThrowsOnNull) {
     EXPECT_THROW(service->loadTimeSeriesValue(finance::AssetId{finance::AssetType::Cash, "USD"}, TimestampsPtr{}),
                  std::invalid_argument);
@@ -0,0 +1,194 @@
+// Copyright (c) 2026 JBBLET. All Rights Reserved.
+#include <gtest/gtest.h>
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "finapp/finance/stats/FinanceStats.hpp"
+#include "finlib/core/Ewma.hpp"
+#include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+
+using finapp::stats::Shrinkage;
+using ts::TimeSeries;
+using ts::TimeSeriesView;
+
+namespace {
+
+// Covariance and correlation of a and b over the rows where both are finite, the slow way.
+struct PairStats {
+    double covariance;
+    double correlation;
+};
+
+PairStats pairStats(const std::vector<double>& a, const std::vector<double>& b) {
+    std::vector<double> x, y;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::isfinite(a[i]) && std::isfinite(b[i])) {
+            x.push_back(a[i]);
+            y.push_back(b[i]);
+        }
+    }
+    const auto n = static_cast<double>(x.size());
+    double mx = 0.0, my = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        mx += x[i] / n;
+        my += y[i] / n;
+    }
+    double sxy = 0.0, sxx = 0.0, syy = 0.0;
+    for (size_t i = 0; i < x.size(); ++i) {
+        sxy += (x[i] - mx) * (y[i] - my);
+        sxx += (x[i] - mx) * (x[i] - mx);
+        syy += (y[i] - my) * (y[i] - my);
+    }
+    return {sxy / (n - 1.0), sxy / std::sqrt(sxx * syy)};
+}
+
+class FinanceStatsTest : public ::testing::Test {
+ protected:
+    static constexpr size_t kRows = 250;
+    static constexpr size_t kAssets = 6;
+    std::vector<std::vector<double>> columns;
+    std::vector<std::shared_ptr<const TimeSeries>> series;
+    std::vector<TimeSeriesView> views;
+
+    // One common factor plus idiosyncratic noise around a large level, so naive raw sums would
+    // cancel; `gaps` punches NaN holes at asset-specific rows.
+    void build(bool gaps) {
+        std::mt19937 rng(20260520);
+        std::normal_distribution<double> normal;
+        columns.assign(kAssets, std::vector<double>(kRows));
+        for (size_t t = 0; t < kRows; ++t) {
+            const double factor = normal(rng);
+            for (size_t j = 0; j < kAssets; ++j) {
+                columns[j][t] = 1e3 + 0.5 * static_cast<double>(j + 1) * factor + normal(rng);
+                if (gaps && (t * (j + 3)) % 17 == 5) columns[j][t] = NAN;
+            }
+        }
+        auto grid = std::make_shared<const ts::TimestampGrid>(0, 86'400'000, kRows);
+        series.clear();
+        views.clear();
+        for (size_t j = 0; j < kAssets; ++j) {
+            series.push_back(std::make_shared<const TimeSeries>("A" + std::to_string(j), grid, columns[j]));
+            views.emplace_back(series.back(), 0, kRows);
+        }
+    }
+
+    std::vector<const TimeSeriesView*> pointers() const {
+        std::vector<const TimeSeriesView*> out;
+        for (const auto& v : views) out.push_back(&v);
+        return out;
+    }
+};
+
+}  // namespace
+
+TEST_F(FinanceStatsTest, GemmMatricesMatchThePairwiseDefinition) {
+    for (const bool gaps : {false, true}) {
+        build(gaps);
+        const Eigen::MatrixXd covariance = finapp::stats::covarianceMatrix(pointers());
+        const auto correlation = finapp::stats::correlationMatrix(pointers());
+        for (size_t a = 0; a < kAssets; ++a) {
+            EXPECT_DOUBLE_EQ(correlation[a][a], 1.0);
+            for (size_t b = 0; b < kAssets; ++b) {
+                const PairStats expected = pairStats(columns[a], columns[b]);
+                const auto ia = static_cast<Eigen::Index>(a), ib = static_cast<Eigen::Index>(b);
+                EXPECT_NEAR(covariance(ia, ib), expected.covariance, 1e-10) << a << "," << b << " gaps " << gaps;
+                if (a != b) EXPECT_NEAR(correlation[a][b], expected.correlation, 1e-12) << a << "," << b;
+            }
+        }
+    }
+}
+
+TEST_F(FinanceStatsTest, OneMissingRowNoLongerPoisonsItsPairs) {
+    build(false);
+    // A single hole in A2: each pair with A2 uses the other kRows - 1 rows instead of turning
+    // NaN, and pairs without A2 still use every row.
+    columns[2][17] = NAN;
+    series[2] = std::make_shared<const TimeSeries>("A2", series[2]->getSharedTimestamps(), columns[2]);
+    views[2] = TimeSeriesView(series[2], 0, kRows);
+
+    const Eigen::MatrixXd covariance = finapp::stats::covarianceMatrix(pointers());
+    const auto correlation = finapp::stats::correlationMatrix(pointers());
+    for (size_t b = 0; b < kAssets; ++b) {
+        const PairStats expected = pairStats(columns[2], columns[b]);
+        ASSERT_TRUE(std::isfinite(correlation[2][b])) << b;
+        EXPECT_NEAR(covariance(2, static_cast<Eigen::Index>(b)), expected.covariance, 1e-10) << b;
+        if (b != 2) EXPECT_NEAR(correlation[b][2], expected.correlation, 1e-12) << b;
+    }
+    EXPECT_NEAR(correlation[0][1], pairStats(columns[0], columns[1]).correlation, 1e-12);
+}
+
+TEST_F(FinanceStatsTest, PanelAndViewsAgree) {
+    build(true);
+    std::vector<double> block;
+    for (const auto& c : columns) block.insert(block.end(), c.begin(), c.end());
+    const ts::TimeSeriesPanel panel(
+        series.front()->getSharedTimestamps(), {"A0", "A1", "A2", "A3", "A4", "A5"}, std::move(block));
+    EXPECT_TRUE(finapp::stats::covarianceMatrix(panel).isApprox(finapp::stats::covarianceMatrix(pointers()), 1e-14));
+    const Eigen::MatrixXd correlation = finapp::stats::correlationMatrix(panel);
+    EXPECT_NEAR(correlation(1, 4), finapp::stats::correlationMatrix(pointers())[1][4], 1e-14);
+}
+
+TEST_F(FinanceStatsTest, LedoitWolfShrinksTowardsTheScaledIdentity) {
+    build(false);
+    const Eigen::MatrixXd sample = finapp::stats::covarianceMatrix(pointers());
+    const Eigen::MatrixXd shrunk = finapp::stats::covarianceMatrix(pointers(), Shrinkage::LedoitWolf);
+
+    // Every off-diagonal entry scales by the same 1 - intensity, and the trace is preserved.
+    const double keep = shrunk(0, 1) / sample(0, 1);
+    EXPECT_GT(keep, 0.0);
+    EXPECT_LT(keep, 1.0);
+    EXPECT_NEAR(shrunk(2, 5) / sample(2, 5), keep, 1e-12);
+    EXPECT_NEAR(shrunk.trace(), sample.trace(), 1e-9);
+    EXPECT_TRUE(shrunk.isApprox(shrunk.transpose()));
+
+    // With more assets than rows the sample matrix is singular; the shrunk one is not.
+    std::vector<const TimeSeriesView*> wide;
+    std::vector<TimeSeriesView> shortViews;
+    for (const auto& s : series) shortViews.emplace_back(s, 0, 4);
+    for (const auto& v : shortViews) wide.push_back(&v);
+    const Eigen::MatrixXd singular = finapp::stats::covarianceMatrix(wide);
+    const Eigen::MatrixXd conditioned = finapp::stats::covarianceMatrix(wide, Shrinkage::LedoitWolf);
+    EXPECT_LT(Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(singular).eigenvalues().minCoeff(), 1e-9);
+    EXPECT_GT(Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(conditioned).eigenvalues().minCoeff(), 1e-6);
+}
+
+TEST_F(FinanceStatsTest, MisalignedViewsThrow) {
+    build(false);
+    std::vector<const TimeSeriesView*> ragged = pointers();
+    const TimeSeriesView shorter(series.front(), 0, kRows - 1);
+    ragged.push_back(&shorter);
+    EXPECT_THROW(finapp::stats::covarianceMatrix(ragged), std::invalid_argument);
+}
+
+TEST(FinanceStatsFlatSeries, ZeroSpreadGivesZeroVolatilityAndSharpe) {
+    // 0.001 is not representable: a mean that did not round back to it would leave a ~1e-34
+    // variance, slip past the zero-volatility guard and blow the ratio up to ~1e13.
+    const size_t n = 300;
+    auto grid = std::make_shared<const ts::TimestampGrid>(0, 86'400'000, n);
+    const auto flat = std::make_shared<const TimeSeries>("Flat", grid, std::vector<double>(n, 0.001));
+    const TimeSeriesView view(flat, 0, n);
+    EXPECT_EQ(ts::analysis::stats::varianceFast(view), 0.0);
+    EXPECT_EQ(finapp::stats::volatility(view), 0.0);
+    EXPECT_EQ(finapp::stats::sharpeRatio(view), 0.0);
+}
+
+TEST_F(FinanceStatsTest, EwmaVolatilityIsTheLastRowOfTheEwmaSeries) {
+    build(true);
+    namespace stats = ts::analysis::stats;
+    const auto params = stats::EwmaParameters::fromHalfLife(20.0, false, false);
+    for (const TimeSeriesView& view : views) {
+        const auto series = stats::ewma(view, view.validity(), params, stats::EwmaStatistic::StandardDeviation);
+        EXPECT_DOUBLE_EQ(finapp::stats::ewmaVolatility(view, 20.0), series.back() * std::sqrt(252.0));
+    }
+}
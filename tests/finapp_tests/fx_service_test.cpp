@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "finapp/data/repository/implementation/InMemoryRepository/InMemoryFXRepository.hpp"
@@ -10,6 +11,7 @@
 #include "finapp/service/FXService.hpp"
 #include "finlib/common/utils/TimeSeriesUtils.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/data/implementation/CachedTimeSeriesRepository.hpp"
 #include "finlib/data/implementation/InMemoryTimeSeriesRepository.hpp"
 #include "finlib/data/services/TimeSeriesService.hpp"
@@ -123,3 +125,25 @@ TEST_F(FXServiceTest, SharedTimestampsOverloadForUnknownPairRegistersAndAlignsPo
     // Shared-timestamps pointer alignment must hold even on first-time resolution.
     EXPECT_EQ(result.getSharedTimestamps().get(), timestamps.get());
 }
+
+TEST_F(FXServiceTest, BatchLoadMatchesOneLoadPerPair) {
+    fxRepo->save(finapp::FXInfos{finance::Currency::EUR, finance::Currency::USD, "EURUSD"});
+    fxRepo->save(finapp::FXInfos{finance::Currency::GBP, finance::Currency::USD, "GBPUSD"});
+    provider->setSeries("EURUSD", finapp::test::makeRampSeries("EURUSD", 0, 6 * kDay, kDay, 1.08, 0.01));
+    provider->setSeries("GBPUSD", finapp::test::makeRampSeries("GBPUSD", 0, 6 * kDay, kDay, 1.25, -0.02));
+
+    auto timestamps = ts::common::utils::timeSeries::makeRegularTimestamps(0, 4 * kDay, kDay / 2);
+    const std::vector<finance::Currency> bases{finance::Currency::EUR, finance::Currency::USD, finance::Currency::GBP};
+    const ts::TimeSeriesPanel panel = service->load(bases, finance::Currency::USD, timestamps);
+    ASSERT_EQ(panel.cols(), bases.size());
+    EXPECT_EQ(panel.getSharedTimestamps().get(), timestamps.get());
+    for (size_t j = 0; j < bases.size(); ++j) {
+        const TimeSeries single = service->load(bases[j], finance::Currency::USD, timestamps);
+        for (size_t i = 0; i < timestamps->size(); ++i) {
+            EXPECT_DOUBLE_EQ(panel(i, j), single.getValues()[i]) << "column " << j << " row " << i;
+        }
+    }
+    EXPECT_DOUBLE_EQ(panel(5, 2), 1.21);  // 2.5 days in: the day-2 GBPUSD close
+    EXPECT_DOUBLE_EQ(panel(5, 1), 1.0);
+    EXPECT_THROW(service->load(bases, finance::Currency::USD, ts::TimestampsPtr{}), std::invalid_argument);
+}
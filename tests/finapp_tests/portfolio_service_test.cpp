@@ -83,6 +83,27 @@ class PortfolioServiceTest : public ::testing::Test {
         equityRepo->save(asset);
         tsProvider->setSeries(ticker, finapp::test::makeFlatSeries(ticker, 0, 30 * kDay, kDay, price));
     }
+
+    // Helper — a USD portfolio "pf1" holding 2 AAPL (USD), 4 VOD (GBP), 100 USD and 50 EUR, with
+    // prices and both FX rates moving every day, so every factor must be read off the right tick.
+    void seedMovingMarket() {
+        equityRepo->save(std::make_shared<finance::Equity>("AAPL", "AAPL", finance::Currency::USD));
+        equityRepo->save(std::make_shared<finance::Equity>("VOD", "VOD", finance::Currency::GBP));
+        tsProvider->setSeries("AAPL", finapp::test::makeRampSeries("AAPL", 0, 30 * kDay, kDay, 100.0, 1.0));
+        tsProvider->setSeries("VOD", finapp::test::makeRampSeries("VOD", 0, 30 * kDay, kDay, 50.0, -0.5));
+        fxRepo->save(finapp::FXInfos{finance::Currency::GBP, finance::Currency::USD, "GBPUSD"});
+        fxRepo->save(finapp::FXInfos{finance::Currency::EUR, finance::Currency::USD, "EURUSD"});
+        tsProvider->setSeries("GBPUSD", finapp::test::makeRampSeries("GBPUSD", 0, 30 * kDay, kDay, 1.25, 0.01));
+        tsProvider->setSeries("EURUSD", finapp::test::makeRampSeries("EURUSD", 0, 30 * kDay, kDay, 1.10, -0.01));
+        portfolioRepo->saveSnapshot(finance::PortfolioSnapshot{
+            "pf",
+            finance::Currency::USD,
+            0,
+            "pf1",
+            {finance::SnapshotPosition{finance::AssetId{finance::AssetType::Equity, "AAPL"}, 2.0},
+             finance::SnapshotPosition{finance::AssetId{finance::AssetType::Equity, "VOD"}, 4.0}},
+            {{finance::Currency::USD, 100.0}, {finance::Currency::EUR, 50.0}}});
+    }
 };
 
 }  // namespace
@@ -300,10 +321,66 @@ TEST_F(PortfolioServiceTest, ValueSeriesSharedTimestampsKeepsPointerAlignment) {
     EXPECT_EQ(series.getSharedTimestamps().get(), timestamps.get());
 }
 
+TEST_F(PortfolioServiceTest, ValueSeriesMatchesPricingEachAssetOnItsOwn) {
+    seedMovingMarket();
+    const finance::AssetId aaplId{finance::AssetType::Equity, "AAPL"};
+    const finance::AssetId vodId{finance::AssetType::Equity, "VOD"};
+
+    // Half-day grid, so the batched loaders have to fill between the daily ticks.
+    auto timestamps = ts::common::utils::timeSeries::makeRegularTimestamps(0, 5 * kDay, kDay / 2);
+    const TimeSeries value = service->valueSeries("pf1", timestamps);
+
+    // The same factors fetched one series at a time.
+    const TimeSeries aaplPrice = assetService->loadTimeSeriesValue(aaplId, timestamps);
+    const TimeSeries vodPrice = assetService->loadTimeSeriesValue(vodId, timestamps);
+    const TimeSeries gbpUsd = fxService->load(finance::Currency::GBP, finance::Currency::USD, timestamps);
+    const TimeSeries eurUsd = fxService->load(finance::Currency::EUR, finance::Currency::USD, timestamps);
+    ASSERT_EQ(value.size(), timestamps->size());
+    for (size_t i = 0; i < value.size(); ++i) {
+        const double expected = 2.0 * aaplPrice.getValues()[i] + 4.0 * vodPrice.getValues()[i] * gbpUsd.getValues()[i] +
+                                100.0 + 50.0 * eurUsd.getValues()[i];
+        EXPECT_NEAR(value.getValues()[i], expected, 1e-9) << "row " << i;
+    }
+}
+
+TEST_F(PortfolioServiceTest, ValueAndWeightSeriesMatchPricingEachAssetOnItsOwn) {
+    seedMovingMarket();
+    const finance::AssetId aaplId{finance::AssetType::Equity, "AAPL"};
+    const finance::AssetId vodId{finance::AssetType::Equity, "VOD"};
+    const finance::AssetId usdId{finance::AssetType::Cash, "USD"};
+    const finance::AssetId eurId{finance::AssetType::Cash, "EUR"};
+
+    auto timestamps = ts::common::utils::timeSeries::makeRegularTimestamps(0, 5 * kDay, kDay / 2);
+    const finance::PortfolioSeries series = service->valueAndWeightSeries("pf1", timestamps);
+    const auto weights = service->weightsSeries("pf1", timestamps);
+
+    const TimeSeries aaplPrice = assetService->loadTimeSeriesValue(aaplId, timestamps);
+    const TimeSeries vodPrice = assetService->loadTimeSeriesValue(vodId, timestamps);
+    const TimeSeries gbpUsd = fxService->load(finance::Currency::GBP, finance::Currency::USD, timestamps);
+    const TimeSeries eurUsd = fxService->load(finance::Currency::EUR, finance::Currency::USD, timestamps);
+    ASSERT_EQ(series.total.size(), timestamps->size());
+    ASSERT_EQ(series.weights.size(), 4u);
+    ASSERT_EQ(weights.size(), 4u);
+    for (size_t i = 0; i < series.total.size(); ++i) {
+        const std::unordered_map<finance::AssetId, double> values{
+            {aaplId, 2.0 * aaplPrice.getValues()[i]},
+            {vodId, 4.0 * vodPrice.getValues()[i] * gbpUsd.getValues()[i]},
+            {usdId, 100.0},
+            {eurId, 50.0 * eurUsd.getValues()[i]}};
+        double total = 0.0;
+        for (const auto& [_, v] : values) total += v;
+        EXPECT_NEAR(series.total.getValues()[i], total, 1e-9) << "row " << i;
+        for (const auto& [id, v] : values) {
+            EXPECT_NEAR(series.weights.at(id).getValues()[i], v / total, 1e-12) << id.ticker << " row " << i;
+            EXPECT_NEAR(weights.at(id).getValues()[i], v / total, 1e-12) << id.ticker << " row " << i;
+        }
+    }
+}
+
 TEST_F(PortfolioServiceTest, ValueSeriesEmptyTimestampsThrows) {
     finance::PortfolioSnapshot snap{"pf", finance::Currency::USD, 0, "pf1", {}, {{finance::Currency::USD, 1.0}}};
     portfolioRepo->saveSnapshot(snap);
-    auto empty = std::make_shared<const std::vector<int64_t>>();
+    auto empty = std::make_shared<const ts::TimestampGrid>();
     EXPECT_THROW(service->valueSeries("pf1", empty), std::invalid_argument);
 }
 
@@ -98,4 +98,17 @@ inline TimeSeries makeFlatSeries(const std::string& id, int64_t startMs, int64_t
     return TimeSeries(id, std::move(ts), std::move(vs));
 }
 
+// Same grid, but the value moves by `slope` per point, so a test can tell which observation a
+// resampled value came from.
+inline TimeSeries makeRampSeries(const std::string& id, int64_t startMs, int64_t endMs, int64_t frequencyMs,
+                                 double first, double slope) {
+    std::vector<int64_t> ts;
+    std::vector<double> vs;
+    for (int64_t t = startMs; t <= endMs; t += frequencyMs) {
+        vs.push_back(first + slope * static_cast<double>(ts.size()));
+        ts.push_back(t);
+    }
+    return TimeSeries(id, std::move(ts), std::move(vs));
+}
+
 }  // namespace finapp::test
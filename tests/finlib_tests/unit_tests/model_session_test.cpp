@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <memory>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +19,7 @@
 #include "finlib/data/CoverageInfo.hpp"
 #include "finlib/data/SeriesKey.hpp"
 #include "finlib/data/implementation/CSVRepository.hpp"
+#include "finlib/data/interfaces/ITimeSeriesSaver.hpp"
 
 using ts::AppContext;
 using ts::CoverageInfo;
@@ -175,6 +177,31 @@ TEST_F(ModelSessionTest, ObserveSequenceProducesReasonableError) {
     EXPECT_LT(mse, 100.0);
 }
 
+TEST_F(ModelSessionTest, TrackEwmaFollowsEachObservation) {
+    auto sessionView = series->slice(0, 400);
+    ModelSession session(context, fittedModel, sessionView, 50, deltaT, 100.0);
+    EXPECT_FALSE(session.errorEwma().has_value());
+
+    const auto params = ts::analysis::stats::EwmaParameters::fromHalfLife(5.0);
+    session.trackEwma(params);
+    const auto forecasts = session.forecast(20);
+
+    const auto& vals = series->getValues();
+    const auto& timestamps = series->getTimestamps();
+    double weight = 0.0, squaredErrors = 0.0;
+    for (size_t i = 0; i < 20; ++i) {
+        session.observe(vals[400 + i], timestamps[400 + i]);
+        const double error = vals[400 + i] - forecasts[i].predictedValue;
+        weight = params.decay * weight + 1.0;
+        squaredErrors = params.decay * squaredErrors + error * error;
+    }
+    ASSERT_TRUE(session.errorEwma().has_value());
+    EXPECT_EQ(session.observedEwma()->count(), 20u);
+    // Errors are taken around zero, so the variance is the weighted mean squared error.
+    EXPECT_NEAR(session.errorEwma()->variance(), squaredErrors / weight, 1e-12);
+    EXPECT_TRUE(std::isfinite(session.observedEwma()->standardDeviation()));
+}
+
 // Rolling Error Tests
 
 TEST_F(ModelSessionTest, RollingMSEWithNoObservationsReturnsZero) {
@@ -369,3 +396,39 @@ TEST_F(ModelSessionTest, ObserveFlushesBufferToRepository) {
     double mse = session.rollingMSE(5);
     EXPECT_GE(mse, 0.0);
 }
+
+// A saver that refuses every write while `failing` is set, and records what it accepted.
+class FlakySaver : public ts::ITimeSeriesSaver {
+ public:
+    bool failing = true;
+    std::vector<std::vector<std::pair<int64_t, double>>> merged;
+
+ protected:
+    void doSave(const SeriesKey& key, const TimeSeries& ts) override { doMerge(key, ts); }
+    void doMerge(const SeriesKey&, const TimeSeries& ts) override {
+        if (failing) throw std::runtime_error("repository unavailable");
+        auto& batch = merged.emplace_back();
+        for (size_t i = 0; i < ts.size(); ++i) batch.emplace_back(ts.getTimestamps()[i], ts.getValues()[i]);
+    }
+};
+
+TEST_F(ModelSessionTest, FailedFlushKeepsEveryObservationForTheNextOne) {
+    FlakySaver saver;
+    AppContext flaky{&saver};
+    {
+        ModelSession session(flaky, fittedModel, series->slice(0, 400), 50, deltaT, 100.0);
+        session.forecast(10);
+        session.observe(1.0, 1000);
+        session.observe(2.0, 2000);
+        // A repeated timestamp closes the batch and flushes it; the save fails.
+        session.observe(3.0, 2000);
+        session.observe(4.0, 3000);
+        saver.failing = false;
+    }  // the destructor's flush retries
+
+    // Both batches arrive, in order, so the repository's merge keeps the later value at t=2000.
+    ASSERT_EQ(saver.merged.size(), 2);
+    EXPECT_EQ(saver.merged[0], (std::vector<std::pair<int64_t, double>>{{1000, 1.0}, {2000, 2.0}}));
+    EXPECT_EQ(saver.merged[1], (std::vector<std::pair<int64_t, double>>{{2000, 3.0}, {3000, 4.0}}));
+}
+
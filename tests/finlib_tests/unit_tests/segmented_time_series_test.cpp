@@ -0,0 +1,113 @@
+// "Copyright (c) 2026 JBBLET All Rights Reserved."
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "TestMockTimeSeries.hpp"
+#include "finlib/core/SegmentedTimeSeries.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+#include "finlib/data/SeriesKey.hpp"
+#include "finlib/data/implementation/InMemoryTimeSeriesRepository.hpp"
+
+using ts::SegmentedTimeSeries;
+using ts::TimeSeriesView;
+
+namespace {
+// Ticks at t = 10 * (i + 1) holding value i.
+SegmentedTimeSeries filled(size_t n, size_t blockSize) {
+    SegmentedTimeSeries series("feed", blockSize);
+    for (size_t i = 0; i < n; ++i) series.append(static_cast<int64_t>(10 * (i + 1)), static_cast<double>(i));
+    return series;
+}
+}  // namespace
+
+TEST(SegmentedTimeSeriesTest, AppendSealsFullBlocksAndKeepsTheRestInTheTail) {
+    const SegmentedTimeSeries series = filled(10, 4);
+    EXPECT_EQ(series.size(), 10u);
+    EXPECT_EQ(series.blockCount(), 2u);
+    EXPECT_EQ(series.sealedCount(), 8u);
+    EXPECT_DOUBLE_EQ(series[5], 5.0);
+    EXPECT_DOUBLE_EQ(series[9], 9.0);
+    EXPECT_EQ(series.timestamp(3), 40);
+    EXPECT_EQ(series.back(), 100);
+}
+
+TEST(SegmentedTimeSeriesTest, SealedBlocksNeverMoveAsTheSeriesGrows) {
+    SegmentedTimeSeries series = filled(4, 4);
+    const TimeSeriesView first = series.blockView(0);
+    const double* data = first.begin();
+    for (size_t i = 4; i < 4'000; ++i) series.append(static_cast<int64_t>(10 * (i + 1)), static_cast<double>(i));
+    EXPECT_EQ(series.blockView(0).begin(), data);
+    EXPECT_DOUBLE_EQ(first[3], 3.0);
+}
+
+TEST(SegmentedTimeSeriesTest, ViewsInsideABlockAreZeroCopy) {
+    const SegmentedTimeSeries series = filled(10, 4);
+    const TimeSeriesView inside = series.view(5, 3);  // rows 5..7, all in block 1
+    EXPECT_EQ(inside.begin(), series.blockView(1).begin() + 1);
+    EXPECT_EQ(inside.getSharedTimestamps(), series.block(1)->getSharedTimestamps());
+
+    // Across a block boundary and into the tail, the rows are copied but read the same.
+    const TimeSeriesView across = series.view(2, 7);
+    ASSERT_EQ(across.size(), 7u);
+    for (size_t i = 0; i < across.size(); ++i) {
+        EXPECT_DOUBLE_EQ(across[i], static_cast<double>(i + 2));
+        EXPECT_EQ(across.timestamp(i), static_cast<int64_t>(10 * (i + 3)));
+    }
+    EXPECT_THROW(series.view(8, 3), std::invalid_argument);
+}
+
+TEST(SegmentedTimeSeriesTest, CompactFlattensEverything) {
+    const SegmentedTimeSeries series = filled(10, 4);
+    const TimeSeries flat = series.compact();
+    ASSERT_EQ(flat.size(), 10u);
+    EXPECT_EQ(flat.getId(), "feed");
+    EXPECT_EQ(flat.getTimestamps()[9], 100);
+    EXPECT_DOUBLE_EQ(flat.getValues()[6], 6.0);
+}
+
+TEST(SegmentedTimeSeriesTest, AppendingASeriesSkipsOverlapAndGaps) {
+    SegmentedTimeSeries series = filled(3, 4);  // t = 10, 20, 30
+    auto batch = makeSeriesAt("batch", {20, 30, 40, 50, 60}, {-1.0, -1.0, 4.0, NAN, 6.0});
+    batch->markMissing();
+    EXPECT_EQ(series.append(*batch), 2u);
+    EXPECT_EQ(series.size(), 5u);
+    EXPECT_EQ(series.back(), 60);
+    EXPECT_DOUBLE_EQ(series[3], 4.0);
+
+    EXPECT_THROW(series.append(60, 1.0), std::invalid_argument);
+    EXPECT_THROW(SegmentedTimeSeries("bad", 0), std::invalid_argument);
+}
+
+TEST(SegmentedTimeSeriesTest, InMemoryRepositoryAppendsPastTheEndAndFoldsOnRead) {
+    ts::InMemoryTimeSeriesRepository repository;
+    const ts::SeriesKey key{"feed", 10};
+    TimeSeries saved("feed", std::vector<int64_t>{10, 20, 30}, std::vector<double>{0, 1, NAN});
+    saved.markMissing();
+    repository.save(key, saved);
+
+    // Appends past the end, one with a gap and one re-delivering an already stored tick.
+    repository.merge(key, TimeSeries("feed", std::vector<int64_t>{40, 50}, std::vector<double>{3, 4}));
+    TimeSeries gapped("feed", std::vector<int64_t>{60, 70, 80}, std::vector<double>{5, NAN, 7});
+    gapped.markMissing();
+    repository.merge(key, gapped);
+    const auto coverage = repository.coverage(key);
+    ASSERT_TRUE(coverage.has_value());
+    EXPECT_EQ(coverage->coveredToMs, 80);
+
+    // The fold keeps only present points, in order, exactly as the general merge would.
+    const TimeSeries folded = repository.load(key);
+    EXPECT_EQ(folded.getTimestamps().size(), 6u);
+    EXPECT_TRUE(std::ranges::equal(folded.getTimestamps(), std::vector<int64_t>{10, 20, 40, 50, 60, 80}));
+    EXPECT_TRUE(std::ranges::equal(folded.getValues(), std::vector<double>{0, 1, 3, 4, 5, 7}));
+
+    // An overlapping batch still takes the general path (newer values win) on top of the fold.
+    repository.merge(key, TimeSeries("feed", std::vector<int64_t>{50, 90}, std::vector<double>{40, 9}));
+    const TimeSeries merged = repository.load(key, 45, 95);
+    EXPECT_TRUE(std::ranges::equal(merged.getValues(), std::vector<double>{40, 5, 7, 9}));
+}
@@ -1,17 +1,22 @@
 // Copyright (c) 2026 JBBLET. All Rights Reserved.
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "TestMockTimeSeries.hpp"
 #include "finlib/analysis/seriesAnalysis/CustomTimeSeriesAnalysis.hpp"
 #include "finlib/common/Error.hpp"
+#include "finlib/common/Memory.hpp"
 #include "finlib/analysis/seriesAnalysis/MetricHandle.hpp"
+#include "finlib/analysis/seriesAnalysis/Metrics.hpp"
 #include "finlib/analysis/session/MultiTimeSeriesSession.hpp"
+#include "finlib/analysis/session/RollingTransforms.hpp"
 #include "finlib/analysis/session/TimeSeriesSession.hpp"
 #include "finlib/core/TimeSeries.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
@@ -66,6 +71,21 @@ TEST_F(TimeSeriesSessionTest, ScalarMultiplyTransform) {
     for (size_t i = 0; i < vals.size(); ++i) EXPECT_DOUBLE_EQ(vals[i], static_cast<double>(i + 1) * 2.0);
 }
 
+TEST_F(TimeSeriesSessionTest, RequestArenaHoldsDerivedSeriesUntilSwappedOut) {
+    ts::memory::RequestArena arena;
+    session_->addTransform("scaled", [](const TimeSeries& src) { return src * 2.0; });
+    session_->setMemoryResource(&arena);
+    EXPECT_DOUBLE_EQ(session_->derivedTimeSeriesPtr("scaled")->getValues()[4], 10.0);
+    EXPECT_GT(arena.bytesAllocated(), 0u);
+
+    // Swapping the arena out drops what was built on it, so releasing it is safe; the next
+    // access rebuilds on the default heap.
+    session_->setMemoryResource(nullptr);
+    arena.release();
+    EXPECT_DOUBLE_EQ(session_->derivedTimeSeriesPtr("scaled")->getValues()[4], 10.0);
+    EXPECT_EQ(arena.bytesAllocated(), 0u);
+}
+
 TEST_F(TimeSeriesSessionTest, DerivedViewViaSeriesView) {
     session_->addTransform("scaled", [](const TimeSeries& src) { return src * 3.0; });
     auto v = session_->seriesView("scaled");
@@ -130,6 +150,31 @@ TEST_F(TimeSeriesSessionTest, CustomAnalysisOnDerivedComputesSum) {
     EXPECT_DOUBLE_EQ(ca.compute(handle), 30.0);
 }
 
+TEST_F(TimeSeriesSessionTest, RollingTransformsAndMetricsLineUpWithTheSource) {
+    using ts::analysis::stats::RollingStatistic;
+    namespace transforms = ts::analysis::transforms;
+    session_->addTransform("max3", transforms::rolling(RollingStatistic::Max, 3));
+    session_->addTransform("scaled", [](const TimeSeries& src) { return src * 2.0; });
+    session_->addTransform(
+        "scaledMedian3", {"scaled"}, transforms::applyTo("scaled", transforms::rollingQuantile(3, 0.5)));
+
+    // {1..5}: the trailing max is the row itself and the warm-up rows are flagged missing.
+    auto max3 = session_->derivedTimeSeriesPtr("max3");
+    ASSERT_EQ(max3->size(), 5u);
+    EXPECT_EQ(max3->getSharedTimestamps(), ts_->getSharedTimestamps());
+    EXPECT_FALSE(max3->isValid(0));
+    EXPECT_FALSE(max3->isValid(1));
+    for (size_t i = 2; i < 5; ++i) EXPECT_DOUBLE_EQ(max3->getValues()[i], static_cast<double>(i + 1));
+    EXPECT_DOUBLE_EQ(session_->derivedTimeSeriesPtr("scaledMedian3")->getValues()[4], 8.0);
+
+    auto& ca = session_->customAnalysis();
+    auto mean2 = ca.addMetric<std::vector<double>>("", "rollingMean2", ts::analysis::metrics::movingAverage(2));
+    const auto means = ca.compute(mean2);
+    ASSERT_EQ(means.size(), 5u);
+    EXPECT_TRUE(std::isnan(means[0]));
+    EXPECT_DOUBLE_EQ(means[4], 4.5);
+}
+
 // ============================================================
 // MultiTimeSeriesSession
 // ============================================================
@@ -226,7 +271,7 @@ TEST_F(MultiTimeSeriesSessionTest, ChainedCrossTransformDerivesReturnsFromCrossT
             const auto ts = m.at("sum")->getTimestamps();
             std::vector<double> r;
             for (size_t i = 1; i < vals.size(); ++i) r.push_back((vals[i] - vals[i - 1]) / vals[i - 1]);
-            auto rt = std::make_shared<std::vector<int64_t>>(ts.begin() + 1, ts.end());
+            auto rt = std::make_shared<const ts::TimestampGrid>(ts::Timestamps(ts.begin() + 1, ts.end()));
             return TimeSeries("ret", std::move(rt), std::move(r));
         });
 
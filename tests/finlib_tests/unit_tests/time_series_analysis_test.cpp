@@ -1,10 +1,16 @@
 // "Copyright (c) 2026 JBBLET All Rights Reserved."
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <random>
 
 #include "TestMockTimeSeries.hpp"
 #include "finlib/analysis/seriesAnalysis/TimeSeriesAnalysis.hpp"
+#include "finlib/analysis/simulation/monteCarlo/Distribution.hpp"
+#include "finlib/analysis/simulation/monteCarlo/MonteCarloEngine.hpp"
+#include "finlib/common/Random.hpp"
 #include "finlib/core/StatsCore.hpp"
 
 using ts::analysis::TimeSeriesAnalysis;
@@ -140,6 +146,23 @@ TEST_F(TimeSeriesAnalysisTest, ACFCacheGrowsWithLargerLag) {
     }
 }
 
+TEST_F(TimeSeriesAnalysisTest, LagCachesGrowToMatchAFreshComputation) {
+    auto view = largerSeries->view();
+    TimeSeriesAnalysis grown(view);
+    for (size_t lag = 1; lag <= 8; ++lag) grown.autocovariances(lag);
+    const auto smallT = grown.toeplitz(3);
+    const auto bigT = grown.toeplitz(8);
+
+    const auto expected = ts::analysis::stats::autocovariances(view, 8);
+    const auto gamma = grown.autocovariances(8);
+    ASSERT_EQ(gamma.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) EXPECT_DOUBLE_EQ(gamma[k], expected[k]);
+
+    EXPECT_TRUE(bigT.isApprox(ts::analysis::stats::toeplitzFromAutocovariances(expected, 8)));
+    EXPECT_TRUE(smallT.isApprox(bigT.topLeftCorner(3, 3)));
+    EXPECT_EQ(grown.toeplitz(5).rows(), 5);
+}
+
 // ============================================================
 // Autocovariance Tests
 // ============================================================
@@ -169,6 +192,33 @@ TEST_F(TimeSeriesAnalysisTest, AutocovarianceSymmetryWithACF) {
     }
 }
 
+TEST_F(TimeSeriesAnalysisTest, PacfComesFromTheCachedAutocovariances) {
+    auto view = largerSeries->view();
+    TimeSeriesAnalysis analysis(view);
+
+    const auto recursion = analysis.durbinLevinson(4);
+    const auto expected = ts::analysis::stats::pacf(view, 4);
+    ASSERT_EQ(analysis.pacf(4).size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) EXPECT_NEAR(analysis.pacf(4)[k], expected[k], 1e-12);
+    // Per-observation scale: order 0 predicts with the mean, so its error is the population variance.
+    EXPECT_NEAR(recursion.innovationVariances[0],
+                analysis.variance(ts::analysis::stats::VarianceType::Population).value(),
+                1e-12);
+}
+
+TEST_F(TimeSeriesAnalysisTest, QuantilesComeFromTheCachedSketch) {
+    auto view = decadeSeries->view();
+    TimeSeriesAnalysis analysis(view);
+
+    // Five points never merge, so the sketch answers exactly.
+    EXPECT_DOUBLE_EQ(analysis.quantile(0.5), 30.0);
+    EXPECT_DOUBLE_EQ(analysis.quantile(0.25), 20.0);
+    EXPECT_DOUBLE_EQ(analysis.quantile(1.0), 50.0);
+    EXPECT_EQ(analysis.cdf(5.0), 0.0);
+    EXPECT_EQ(&analysis.quantileSketch(), &analysis.quantileSketch());
+    EXPECT_EQ(analysis.quantileSketch().count(), 5u);
+}
+
 // ============================================================
 // Toeplitz Tests
 // ============================================================
@@ -244,3 +294,55 @@ TEST_F(TimeSeriesAnalysisTest, VarianceFastAndSlowAgreePopulation) {
 
     EXPECT_NEAR(fast, slow, 1e-10);
 }
+
+// ============================================================
+// Monte Carlo Sketch Tests
+// ============================================================
+
+namespace {
+// A Gaussian random walk; its end point is the path result.
+struct GaussianWalk {
+    double x = 0.0;
+    std::normal_distribution<double> increment;
+    void step(size_t /*t*/, ts::Rng& rng) { x += increment(rng); }
+    double result() const { return x; }
+};
+}  // namespace
+
+TEST(MonteCarloSketchTest, SketchedRunMatchesTheExactDistributionWithinTheTDigestBound) {
+    using ts::simulation::Distribution;
+    // Several chunks of kSketchChunkPaths, the last one partial.
+    const ts::simulation::MonteCarloSpecification spec{.paths = 50'000, .steps = 12, .seed = 42};
+    const auto makePath = [](size_t) { return GaussianWalk{}; };
+    const auto identity = [](double x) { return x; };
+
+    const auto results = ts::simulation::run(spec, makePath);
+    const Distribution exact = Distribution::from("exact", results, identity);
+    const Distribution sketched = ts::simulation::runSketched("sketched", spec, makePath, identity);
+    ASSERT_TRUE(sketched.isSketched());
+    EXPECT_TRUE(sketched.samples().empty());
+
+    // Same paths, so the moments and extremes agree (up to summation order for the mean).
+    ASSERT_EQ(sketched.size(), exact.size());
+    EXPECT_EQ(sketched.min(), exact.min());
+    EXPECT_EQ(sketched.max(), exact.max());
+    EXPECT_NEAR(sketched.mean(), exact.mean(), 1e-12);
+    EXPECT_NEAR(sketched.stddev(), exact.stddev(), 1e-9);
+
+    // Quantiles and CDF within TDigest's documented rank error, measured on the exact samples.
+    const auto sorted = exact.samples();
+    const auto n = static_cast<double>(sorted.size());
+    const auto rankOf = [&](double v) {
+        return static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), v) - sorted.begin()) / n;
+    };
+    for (const double q : {1e-3, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999}) {
+        const double bound = (q <= 1e-3 || q >= 0.999) ? 2e-4 : 1e-3;
+        EXPECT_NEAR(rankOf(sketched.quantile(q)), q, bound) << "q " << q;
+        EXPECT_NEAR(sketched.cdf(exact.quantile(q)), exact.cdf(exact.quantile(q)), bound) << "cdf, q " << q;
+    }
+
+    // The chunk partials fold in order, so a rerun gives the same sketch.
+    const Distribution again = ts::simulation::runSketched("again", spec, makePath, identity);
+    EXPECT_EQ(again.quantile(0.9), sketched.quantile(0.9));
+}
+
@@ -1,8 +1,16 @@
 // "Copyright (c) 2026 JBBLET All Rights Reserved."
 #include <gtest/gtest.h>
 
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
 #include "TestMockTimeSeries.hpp"
+#include "finlib/common/Memory.hpp"
+#include "finlib/core/Kernels.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesExpression.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
 
 class TimeSeriesOperatorsTest : public TimeSeriesMocks {};
 
@@ -42,3 +50,271 @@ TEST_F(TimeSeriesOperatorsTest, ThrowsOnMismatchedTimestamps) {
     EXPECT_THROW(*s1 + *s2, std::invalid_argument);
     EXPECT_THROW(*s1 *= *s2, std::invalid_argument);
 }
+
+// ---------------------------------------------------------------------------
+// Lazy expressions
+// ---------------------------------------------------------------------------
+
+TEST_F(TimeSeriesOperatorsTest, LazyExpressionMatchesEagerOperators) {
+    // decade * simple + constant * 2 = {16, 46, 96, 166, 256}
+    TimeSeries eager = (*decadeSeries * *simpleSeries) + (*constantSeries * 2.0);
+    TimeSeries fused = ts::lazy(*decadeSeries) * *simpleSeries + ts::lazy(*constantSeries) * 2.0;
+    ASSERT_EQ(fused.size(), eager.size());
+    for (size_t i = 0; i < eager.size(); ++i) EXPECT_DOUBLE_EQ(fused.getValues()[i], eager.getValues()[i]);
+    EXPECT_EQ(fused.getSharedTimestamps(), decadeSeries->getSharedTimestamps());
+    EXPECT_EQ(fused.getId(), decadeSeries->getId());
+}
+
+TEST_F(TimeSeriesOperatorsTest, LazyDivisionFollowsZeroDivisorRule) {
+    auto zeros = makeSeries("zeros", {1.0, 0.0, 2.0, 0.0, 5.0});
+    TimeSeries result = ts::lazy(*decadeSeries) / *zeros;
+    EXPECT_DOUBLE_EQ(result.getValues()[0], 10.0);
+    EXPECT_DOUBLE_EQ(result.getValues()[1], 0.0);
+    EXPECT_DOUBLE_EQ(result.getValues()[4], 10.0);
+    EXPECT_ANY_THROW(ts::lazy(*decadeSeries) / 0.0);
+}
+
+TEST_F(TimeSeriesOperatorsTest, LazyCompoundAssignmentUpdatesInPlace) {
+    // Built from its own vector: a plain copy would share decadeSeries' buffer and clone on write.
+    const auto decade = decadeSeries->getValues();
+    TimeSeries total(decadeSeries->getId(),
+                     decadeSeries->getSharedTimestamps(),
+                     std::vector<double>(decade.begin(), decade.end()));
+    const double* before = total.getValues().data();
+    total += ts::lazy(*simpleSeries) * *constantSeries - 1.0;  // {12, 25, 38, 51, 64}
+    EXPECT_EQ(total.getValues().data(), before);
+    EXPECT_DOUBLE_EQ(total.getValues()[0], 12.0);
+    EXPECT_DOUBLE_EQ(total.getValues()[4], 64.0);
+}
+
+TEST_F(TimeSeriesOperatorsTest, LazyExpressionOverViews) {
+    // Rows 1..3 of each series: {20,30,40} - {2,3,4} = {18,27,36}
+    auto decadeView = decadeSeries->slice(1, 3);
+    auto simpleView = simpleSeries->slice(1, 3);
+    TimeSeries result = (ts::lazy(decadeView) - simpleView).evaluate("diff");
+    EXPECT_EQ(result.getId(), "diff");
+    ASSERT_EQ(result.size(), 3u);
+    EXPECT_DOUBLE_EQ(result.getValues()[0], 18.0);
+    EXPECT_DOUBLE_EQ(result.getValues()[2], 36.0);
+    EXPECT_EQ(result.getTimestamps()[0], 2000);
+}
+
+TEST_F(TimeSeriesOperatorsTest, LazyCompoundAssignmentMayReadItsTarget) {
+    auto series = makeSeries("s", {1.0, 2.0, 3.0, 4.0});
+    *series += ts::lazy(*series) * 2.0 + series->view();  // x + 2x + x
+    EXPECT_DOUBLE_EQ(series->getValues()[0], 4.0);
+    EXPECT_DOUBLE_EQ(series->getValues()[3], 16.0);
+}
+
+TEST_F(TimeSeriesOperatorsTest, LazyExpressionThrowsOnMismatchedTimestamps) {
+    auto s1 = makeSeriesAt("s1", {1000, 2000}, {10.0, 20.0});
+    auto s2 = makeSeriesAt("s2", {1000, 2001}, {1.0, 2.0});
+    auto s3 = makeSeriesAt("s3", {1000}, {1.0});
+    EXPECT_THROW(TimeSeries(ts::lazy(*s1) + *s2), std::invalid_argument);
+    EXPECT_THROW(TimeSeries(ts::lazy(*s1) * *s3), std::invalid_argument);
+    EXPECT_THROW(*s1 += ts::lazy(*s2) * 2.0, std::invalid_argument);
+}
+
+// ---------------------------------------------------------------------------
+// Element-wise kernels
+// ---------------------------------------------------------------------------
+
+// 19 lanes: two full AVX-512 blocks plus a tail, so every ISA exercises both its vector
+// loop and its scalar remainder.
+TEST(ElementWiseKernelsTest, EveryIsaMatchesTheScalarRule) {
+    std::vector<double> a(19);
+    std::vector<double> b(19);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = 1.5 * static_cast<double>(i) - 4.0;
+        b[i] = (i % 5 == 0) ? 0.0 : 0.25 * static_cast<double>(i) + 1.0;
+    }
+    for (ts::kernels::Isa isa : ts::kernels::supportedIsas()) {
+        const auto& k = ts::kernels::table(isa);
+        std::vector<double> out(a.size());
+        k.add(a.data(), b.data(), out.data(), a.size());
+        for (size_t i = 0; i < a.size(); ++i) EXPECT_DOUBLE_EQ(out[i], a[i] + b[i]) << toString(isa) << " add @" << i;
+        k.sub(a.data(), b.data(), out.data(), a.size());
+        for (size_t i = 0; i < a.size(); ++i) EXPECT_DOUBLE_EQ(out[i], a[i] - b[i]) << toString(isa) << " sub @" << i;
+        k.mul(a.data(), b.data(), out.data(), a.size());
+        for (size_t i = 0; i < a.size(); ++i) EXPECT_DOUBLE_EQ(out[i], a[i] * b[i]) << toString(isa) << " mul @" << i;
+        k.div(a.data(), b.data(), out.data(), a.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            EXPECT_DOUBLE_EQ(out[i], b[i] == 0.0 ? 0.0 : a[i] / b[i]) << toString(isa) << " div @" << i;
+        }
+        k.mulScalar(a.data(), 3.0, out.data(), a.size());
+        for (size_t i = 0; i < a.size(); ++i) EXPECT_DOUBLE_EQ(out[i], a[i] * 3.0) << toString(isa) << " mulScalar @" << i;
+        k.divScalar(a.data(), 4.0, out.data(), a.size());
+        for (size_t i = 0; i < a.size(); ++i) EXPECT_DOUBLE_EQ(out[i], a[i] / 4.0) << toString(isa) << " divScalar @" << i;
+    }
+}
+
+TEST(ElementWiseKernelsTest, InPlaceAliasingAndSizeChecks) {
+    std::vector<double> a{1.0, 2.0, 3.0, 4.0, 5.0};
+    const std::vector<double> b{5.0, 4.0, 3.0, 2.0, 1.0};
+    ts::kernels::add(a, b, a);
+    for (double v : a) EXPECT_DOUBLE_EQ(v, 6.0);
+    std::vector<double> shorter(3);
+    EXPECT_THROW(ts::kernels::add(a, b, shorter), std::invalid_argument);
+}
+
+TEST_F(TimeSeriesOperatorsTest, SeriesDivisionZeroDivisorYieldsZero) {
+    auto zeros = makeSeries("zeros", {2.0, 0.0, 3.0, 0.0, 5.0});
+    TimeSeries result = *decadeSeries / *zeros;
+    EXPECT_DOUBLE_EQ(result.getValues()[0], 5.0);
+    EXPECT_DOUBLE_EQ(result.getValues()[1], 0.0);
+    EXPECT_DOUBLE_EQ(result.getValues()[3], 0.0);
+    EXPECT_DOUBLE_EQ(result.getValues()[4], 10.0);
+    EXPECT_EQ(result.getId(), decadeSeries->getId());
+    EXPECT_THROW(*decadeSeries / 0.0, ts::Exception);
+}
+
+// ---------------------------------------------------------------------------
+// Copy-on-write values
+// ---------------------------------------------------------------------------
+
+TEST_F(TimeSeriesOperatorsTest, CopiesShareValuesUntilOneSideWrites) {
+    TimeSeries copy = *decadeSeries;
+    EXPECT_TRUE(copy.sharesValuesWith(*decadeSeries));
+    EXPECT_EQ(copy.getValues().data(), decadeSeries->getValues().data());
+
+    copy *= 2.0;
+    EXPECT_FALSE(copy.sharesValuesWith(*decadeSeries));
+    EXPECT_DOUBLE_EQ(copy.getValues()[0], 20.0);
+    EXPECT_DOUBLE_EQ(decadeSeries->getValues()[0], 10.0);
+
+    // Now the sole owner: further writes stay in the same buffer.
+    const double* owned = copy.getValues().data();
+    copy += 1.0;
+    EXPECT_EQ(copy.getValues().data(), owned);
+}
+
+TEST_F(TimeSeriesOperatorsTest, InPlaceWritesNeverLeakIntoCopies) {
+    TimeSeries a = *simpleSeries;
+    TimeSeries b = a;
+    a.applyInPlace([](double v) { return -v; });
+    EXPECT_DOUBLE_EQ(a.getValues()[0], -1.0);
+    EXPECT_DOUBLE_EQ(b.getValues()[0], 1.0);
+
+    // Lazy compound assignment reading a shared target: the clone carries the same numbers.
+    TimeSeries c = b;
+    c += ts::lazy(b) * 2.0;
+    EXPECT_DOUBLE_EQ(c.getValues()[4], 15.0);
+    EXPECT_DOUBLE_EQ(b.getValues()[4], 5.0);
+
+    // A series multiplied into itself while a copy is alive.
+    TimeSeries d = b;
+    d *= d;
+    EXPECT_DOUBLE_EQ(d.getValues()[4], 25.0);
+    EXPECT_DOUBLE_EQ(b.getValues()[4], 5.0);
+}
+
+// ---------------------------------------------------------------------------
+// Validity
+// ---------------------------------------------------------------------------
+
+TEST_F(TimeSeriesOperatorsTest, MarkMissingFlagsNaNLanesWithoutCopying) {
+    TimeSeries series = *makeSeries("Gappy", {1.0, NAN, 3.0, NAN, 5.0});
+    const double* values = series.getValues().data();
+    series.markMissing();
+
+    EXPECT_TRUE(series.hasValidity());
+    EXPECT_EQ(series.size(), 5u);
+    EXPECT_EQ(series.validCount(), 3u);
+    EXPECT_FALSE(series.isValid(1));
+    EXPECT_TRUE(series.isValid(2));
+    EXPECT_EQ(series.getValues().data(), values);
+
+    // A gap-free series stores no bitmap at all.
+    TimeSeries dense = *simpleSeries;
+    dense.markMissing();
+    EXPECT_FALSE(dense.hasValidity());
+    EXPECT_EQ(dense.validCount(), 5u);
+}
+
+TEST_F(TimeSeriesOperatorsTest, LookupsSkipMissingPoints) {
+    TimeSeries series = *makeSeries("Gappy", {1.0, 2.0, NAN, 4.0, 5.0});
+    series.markMissing();
+    EXPECT_FALSE(series.exactValue(3000).has_value());
+    EXPECT_DOUBLE_EQ(series.latestValue(3000), 2.0);
+    EXPECT_DOUBLE_EQ(series.latestValue(3500), 2.0);
+    EXPECT_DOUBLE_EQ(series.latestValue(4000), 4.0);
+}
+
+TEST_F(TimeSeriesOperatorsTest, OperatorsAndValidityBitmapsCompose) {
+    TimeSeries a = *makeSeries("A", {1.0, NAN, 3.0, 4.0, 5.0});
+    a.markMissing();
+    TimeSeries b = *makeSeries("B", {1.0, 2.0, 3.0, NAN, 5.0});
+    b.markMissing();
+
+    // Scalar ops keep the operand's bitmap; series ops keep a lane only where both are present.
+    EXPECT_EQ((a * 2.0).validCount(), 4u);
+    const TimeSeries sum = a + b;
+    EXPECT_EQ(sum.validCount(), 3u);
+    EXPECT_FALSE(sum.isValid(1));
+    EXPECT_FALSE(sum.isValid(3));
+
+    TimeSeries inPlace = a;
+    inPlace -= b;
+    EXPECT_EQ(inPlace.validCount(), 3u);
+
+    const TimeSeries fused = ts::lazy(a) + ts::lazy(b) * 2.0;
+    EXPECT_EQ(fused.validCount(), 3u);
+    EXPECT_FALSE(fused.isValid(3));
+
+    TimeSeries target = *decadeSeries;
+    target += ts::lazy(b);
+    EXPECT_EQ(target.validCount(), 4u);
+    EXPECT_FALSE(target.isValid(3));
+}
+
+TEST_F(TimeSeriesOperatorsTest, ViewsReadTheValidityOfTheirWindow) {
+    auto series = makeSeries("Gappy", {1.0, 2.0, NAN, 4.0, 5.0});
+    series->markMissing();
+    const auto window = series->slice(1, 3);  // rows 1..3
+    EXPECT_EQ(window.validCount(), 2u);
+    EXPECT_FALSE(window.validity().isValid(1));
+
+    const TimeSeries copy = window.toSeries();
+    EXPECT_EQ(copy.validCount(), 2u);
+    EXPECT_FALSE(copy.isValid(1));
+
+    const TimeSeries product = window * simpleSeries->slice(1, 3);
+    EXPECT_FALSE(product.isValid(1));
+    EXPECT_TRUE(product.isValid(2));
+}
+
+TEST_F(TimeSeriesOperatorsTest, DropInvalidCompactsOnlyWhenThereAreGaps) {
+    TimeSeries series = *makeSeries("Gappy", {1.0, NAN, 3.0});
+    series.markMissing();
+    const TimeSeries compact = series.dropInvalid();
+    EXPECT_FALSE(compact.hasValidity());
+    ASSERT_EQ(compact.size(), 2u);
+    EXPECT_EQ(compact.getTimestamps()[1], 3000);
+    EXPECT_DOUBLE_EQ(compact.getValues()[1], 3.0);
+
+    EXPECT_TRUE(simpleSeries->dropInvalid().sharesValuesWith(*simpleSeries));
+    EXPECT_THROW(series.setValidity(ts::ValidityBitmap(2)), std::invalid_argument);
+}
+
+TEST_F(TimeSeriesOperatorsTest, ResultsBuiltInsideAScopeLiveOnItsArena) {
+    ts::memory::RequestArena arena;
+    {
+        const ts::memory::ScopedResource scope(&arena);
+        const TimeSeries sum = *decadeSeries + *simpleSeries;
+        EXPECT_GE(arena.bytesAllocated(), sum.size() * sizeof(double));
+        EXPECT_DOUBLE_EQ(sum.getValues()[4], 55.0);
+
+        // A shared buffer cloned on write lands on the arena too.
+        TimeSeries copy = *decadeSeries;
+        const size_t before = arena.bytesAllocated();
+        copy += 1.0;
+        EXPECT_GT(arena.bytesAllocated(), before);
+        EXPECT_DOUBLE_EQ(decadeSeries->getValues()[0], 10.0);
+    }
+    const size_t used = arena.bytesAllocated();
+    const TimeSeries outside = *decadeSeries * 2.0;
+    EXPECT_EQ(arena.bytesAllocated(), used);
+    EXPECT_EQ(ts::memory::currentResource(), std::pmr::get_default_resource());
+    arena.release();
+    EXPECT_EQ(arena.bytesAllocated(), 0u);
+}
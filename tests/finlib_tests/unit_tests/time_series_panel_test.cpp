@@ -0,0 +1,86 @@
+// "Copyright (c) 2026 JBBLET All Rights Reserved."
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TestMockTimeSeries.hpp"
+#include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
+#include "finlib/core/TimeSeriesView.hpp"
+
+using ts::TimeSeriesPanel;
+using ts::TimeSeriesView;
+
+class TimeSeriesPanelTest : public TimeSeriesMocks {
+ protected:
+    std::shared_ptr<TimeSeriesPanel> panel;
+
+    void SetUp() override {
+        TimeSeriesMocks::SetUp();
+        const std::vector<const TimeSeries*> columns{simpleSeries.get(), decadeSeries.get(), constantSeries.get()};
+        panel = std::make_shared<TimeSeriesPanel>(TimeSeriesPanel::fromSeries(columns));
+    }
+};
+
+TEST_F(TimeSeriesPanelTest, FromSeriesPacksColumnMajor) {
+    EXPECT_EQ(panel->rows(), 5u);
+    EXPECT_EQ(panel->cols(), 3u);
+    EXPECT_EQ(panel->columnIds()[1], "DecadeSeries");
+    EXPECT_DOUBLE_EQ((*panel)(0, 0), 1.0);
+    EXPECT_DOUBLE_EQ((*panel)(4, 1), 50.0);
+    // Column 1 starts right after column 0 in the block.
+    EXPECT_DOUBLE_EQ(panel->data()[5], 10.0);
+    EXPECT_EQ(panel->getSharedTimestamps(), simpleSeries->getSharedTimestamps());
+}
+
+TEST_F(TimeSeriesPanelTest, EigenMapSharesTheBlock) {
+    auto matrix = panel->asEigenMatrix();
+    EXPECT_EQ(matrix.rows(), 5);
+    EXPECT_EQ(matrix.cols(), 3);
+    EXPECT_EQ(matrix.data(), panel->data().data());
+    Eigen::VectorXd rowSums = matrix.rowwise().sum();
+    EXPECT_DOUBLE_EQ(rowSums(2), 3.0 + 30.0 + 3.0);
+}
+
+TEST_F(TimeSeriesPanelTest, ColumnViewIsZeroCopyAndOutlivesHandle) {
+    TimeSeriesView view = panel->columnView("DecadeSeries");
+    EXPECT_EQ(view.begin(), panel->column(1).data());
+    EXPECT_EQ(view.getTimeSeriesId(), "DecadeSeries");
+    EXPECT_EQ(view.timestamp(0), 1000);
+    EXPECT_DOUBLE_EQ(ts::analysis::stats::mean(view), 30.0);
+
+    panel.reset();  // the view keeps the block alive
+    EXPECT_DOUBLE_EQ(view[4], 50.0);
+    auto slice = view.slice(1, 2);
+    EXPECT_DOUBLE_EQ(slice[0], 20.0);
+}
+
+TEST_F(TimeSeriesPanelTest, ColumnViewsCombineWithSeriesViews) {
+    TimeSeries sum = panel->columnView(0) + decadeSeries->view();
+    EXPECT_DOUBLE_EQ(sum.getValues()[4], 55.0);
+    EXPECT_EQ(sum.getSharedTimestamps(), panel->getSharedTimestamps());
+
+    TimeSeries copy = panel->columnSeries(2);
+    EXPECT_EQ(copy.getId(), "ConstantSeries");
+    EXPECT_DOUBLE_EQ(copy.getValues()[0], 3.0);
+}
+
+TEST_F(TimeSeriesPanelTest, MisalignedOrUnknownColumnsThrow) {
+    auto shifted = makeSeriesAt("shifted", {1000, 2000, 3000, 4000, 5001}, {1, 2, 3, 4, 5});
+    const std::vector<const TimeSeries*> columns{simpleSeries.get(), shifted.get()};
+    EXPECT_THROW(TimeSeriesPanel::fromSeries(columns), std::invalid_argument);
+    EXPECT_THROW(panel->columnIndex("missing"), std::invalid_argument);
+    EXPECT_THROW(TimeSeriesPanel(simpleSeries->getSharedTimestamps(), {"a"}, std::vector<double>(4)),
+                 std::invalid_argument);
+}
+
+TEST_F(TimeSeriesPanelTest, ZeroFilledConstructorAndIdentity) {
+    TimeSeriesPanel blank(simpleSeries->getSharedTimestamps(), {"x", "y"});
+    EXPECT_EQ(blank.rows(), 5u);
+    blank(3, 1) = 7.0;
+    EXPECT_DOUBLE_EQ(blank.column(1)[3], 7.0);
+    EXPECT_NE(blank.toString().find("5 x 2"), std::string::npos);
+}
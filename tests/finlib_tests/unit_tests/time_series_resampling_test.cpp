@@ -1,8 +1,14 @@
 // "Copyright (c) 2026 JBBLET All Rights Reserved."
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -11,6 +17,11 @@
 #include "finlib/common/Random.hpp"
 #include "finlib/core/Resampling.hpp"
 #include "finlib/core/TimeSeries.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
+#include "finlib/data/SeriesKey.hpp"
+#include "finlib/data/implementation/CachedTimeSeriesRepository.hpp"
+#include "finlib/data/implementation/InMemoryTimeSeriesRepository.hpp"
+#include "finlib/data/services/TimeSeriesService.hpp"
 
 using ts::InterpolationStrategy;
 
@@ -50,6 +61,313 @@ TEST_F(TimeSeriesResamplingTest, ResamplingStochasticBounds) {
     EXPECT_NE(res1.getValues()[0], res2.getValues()[0]);
 }
 
+TEST_F(TimeSeriesResamplingTest, MissingSourcePointsAreSteppedOver) {
+    // {1, -, 3, 4, -} at t=1000..5000: the walk interpolates across the gap at 2000 and holds
+    // the last present value past 4000.
+    auto gappy = makeSeries("Gappy", {1.0, NAN, 3.0, 4.0, NAN});
+    gappy->markMissing();
+    std::vector<int64_t> target = {1500, 2000, 4500, 5000};
+    auto linear = ts::resample(*gappy, target, InterpolationStrategy::Linear);
+    EXPECT_NEAR(linear.getValues()[0], 1.5, 1e-9);
+    EXPECT_NEAR(linear.getValues()[1], 2.0, 1e-9);
+    EXPECT_DOUBLE_EQ(linear.getValues()[2], 4.0);
+    EXPECT_DOUBLE_EQ(linear.getValues()[3], 4.0);
+    EXPECT_FALSE(linear.hasValidity());
+
+    // Exact flags what it cannot hit instead of handing NaN on.
+    auto exact = ts::resample(*gappy, std::vector<int64_t>{1000, 2000, 2500, 3000}, InterpolationStrategy::Exact);
+    EXPECT_EQ(exact.validCount(), 2u);
+    EXPECT_FALSE(exact.isValid(1));
+    EXPECT_FALSE(exact.isValid(2));
+    EXPECT_DOUBLE_EQ(exact.getValues()[3], 3.0);
+}
+
+TEST_F(TimeSeriesResamplingTest, InterpolationPlanReplaysTheWalk) {
+    // An irregular shared grid, the series a slice of it (offset 2) with two flagged gaps.
+    auto grid = std::make_shared<const ts::TimestampGrid>(
+        ts::Timestamps{0, 500, 1000, 1700, 2000, 3100, 4000, 4200, 5000, 6400, 7000, 9000});
+    TimeSeries src("Src", grid, 2, {10.0, NAN, 30.0, 45.0, 50.0, NAN, 65.0, 80.0});
+    src.markMissing();
+    TimeSeries other("Other", grid, 2, {-1.0, NAN, 2.5, 1e6, -7.0, NAN, 0.125, 3.0});
+    other.markMissing();
+    auto target = std::make_shared<const ts::TimestampGrid>(
+        ts::Timestamps{0, 1000, 1350, 1850, 2000, 2550, 4100, 4200, 4600, 5700, 6400, 6500, 7000, 8000});
+
+    // Bit-identical to the walk, NaN for NaN, for every plannable strategy.
+    const auto sameBits = [](double a, double b) { return (std::isnan(a) && std::isnan(b)) || a == b; };
+    for (const auto strategy : {InterpolationStrategy::Linear,
+                                InterpolationStrategy::Nearest,
+                                InterpolationStrategy::Latest,
+                                InterpolationStrategy::Exact}) {
+        const ts::InterpolationPlan plan(src, target, strategy);
+        ASSERT_TRUE(plan.appliesTo(other));
+        for (const TimeSeries* series : {&src, &other}) {
+            const auto walked = ts::resample(*series, target, strategy);
+            const auto planned = ts::resample(*series, plan);
+            ASSERT_EQ(planned.size(), walked.size());
+            EXPECT_EQ(planned.getSharedTimestamps(), target);
+            EXPECT_EQ(planned.validCount(), walked.validCount()) << ts::toString(strategy);
+            for (size_t i = 0; i < walked.size(); ++i) {
+                EXPECT_TRUE(sameBits(planned.getValues()[i], walked.getValues()[i]))
+                    << ts::toString(strategy) << " row " << i << ": " << planned.getValues()[i] << " vs " << walked.getValues()[i];
+            }
+        }
+    }
+}
+
+TEST_F(TimeSeriesResamplingTest, InterpolationPlanOnlyAppliesToItsSourceShape) {
+    auto target = std::make_shared<const ts::TimestampGrid>(1000, 250, 17);
+    const ts::InterpolationPlan plan(*simpleSeries, target, InterpolationStrategy::Linear);
+
+    // Equal timestamps on another grid object still match; other timestamps or gaps do not.
+    EXPECT_TRUE(plan.appliesTo(*decadeSeries));
+    EXPECT_FALSE(plan.appliesTo(*makeSeriesAt("Shifted", {1000, 2000, 3000, 4000, 5001}, {1, 2, 3, 4, 5})));
+    auto gappy = makeSeries("Gappy", {1.0, NAN, 3.0, 4.0, 5.0});
+    gappy->markMissing();
+    EXPECT_FALSE(plan.appliesTo(*gappy));
+    EXPECT_THROW(ts::resample(*gappy, plan), std::invalid_argument);
+    EXPECT_THROW(plan.apply(std::vector<double>{1.0, 2.0}), std::invalid_argument);
+
+    EXPECT_NEAR(ts::resample(*decadeSeries, plan).getValues()[1], 12.5, 1e-12);
+    EXPECT_THROW(ts::InterpolationPlan(*simpleSeries, target, InterpolationStrategy::Stochastic),
+                 std::invalid_argument);
+    // Two row indices and a weight per target row, and both grids it pins.
+    EXPECT_GE(plan.bytes(), 17 * (2 * sizeof(size_t) + sizeof(double)) + (5 + 17) * sizeof(ts::Timestamp));
+}
+
+TEST(TimeSeriesServicePlans, RepeatedFillsMatchADirectResample) {
+    // Uneven timestamps, so the service cannot take the arithmetic path: the first fill of a
+    // shape walks, the second builds a plan, later ones replay it. Every asset has its own grid
+    // object with the same timestamps, and one has a gap, so its plan must not be reused. Every
+    // fill also passes its own, never interned, copy of the target grid.
+    const ts::Timestamps stamps{0, 100, 250, 300, 480, 500, 700, 910, 1'000};
+    const ts::Timestamps targetStamps{0, 40, 260, 299, 600, 905, 1'000};
+    auto cache = std::make_shared<ts::CachedTimeSeriesRepository>(std::make_shared<ts::InMemoryTimeSeriesRepository>());
+    std::vector<TimeSeries> expected;
+    auto target = std::make_shared<const ts::TimestampGrid>(ts::Timestamps(targetStamps));
+    for (size_t a = 0; a < 4; ++a) {
+        std::vector<double> values;
+        for (size_t i = 0; i < stamps.size(); ++i) values.push_back(static_cast<double>((i + 1) * (a + 2) % 7));
+        if (a == 2) values[4] = NAN;
+        TimeSeries bucket("S" + std::to_string(a), ts::Timestamps(stamps), std::move(values));
+        bucket.markMissing();
+        expected.push_back(ts::resample(bucket, target, InterpolationStrategy::Linear));
+        cache->save(ts::SeriesKey{bucket.getId(), 100}, bucket);
+    }
+    ts::TimeSeriesService service(cache, nullptr);
+    for (int round = 0; round < 3; ++round) {
+        for (size_t a = 0; a < 4; ++a) {
+            auto grid = std::make_shared<const ts::TimestampGrid>(ts::Timestamps(targetStamps));
+            const auto filled = service.getFilled("S" + std::to_string(a), grid, InterpolationStrategy::Linear);
+            ASSERT_EQ(filled.size(), target->size());
+            ASSERT_TRUE(filled.getSharedTimestamps()->matches(filled.tsOffset(), *target, 0, target->size()));
+            for (size_t i = 0; i < filled.size(); ++i) {
+                ASSERT_EQ(filled.getValues()[i], expected[a].getValues()[i]) << "round " << round << " S" << a;
+            }
+        }
+    }
+}
+
+TEST_F(TimeSeriesResamplingTest, ResampleManyMatchesOneResamplePerSeries) {
+    // Two series on the mock grid (planned together), one with its own gaps and one on other
+    // timestamps (each walked on its own).
+    auto gappy = makeSeries("Gappy", {1.0, NAN, 3.0, 4.0, NAN});
+    gappy->markMissing();
+    auto offGrid = makeSeriesAt("OffGrid", {500, 2200, 2900, 6000}, {7.0, -1.0, 2.0, 0.5});
+    const std::vector<const TimeSeries*> sources{simpleSeries.get(), gappy.get(), decadeSeries.get(), offGrid.get()};
+    auto target = std::make_shared<const ts::TimestampGrid>(ts::Timestamps{0, 1000, 1500, 2200, 3000, 4750, 7000});
+
+    for (const auto strategy : {InterpolationStrategy::Linear,
+                                InterpolationStrategy::Nearest,
+                                InterpolationStrategy::Latest,
+                                InterpolationStrategy::Exact,
+                                InterpolationStrategy::Stochastic}) {
+        const auto panel = ts::resampleMany(sources, target, strategy, {.seed = 3});
+        ASSERT_EQ(panel.cols(), sources.size());
+        ASSERT_EQ(panel.rows(), target->size());
+        EXPECT_EQ(panel.getSharedTimestamps(), target);
+        for (size_t j = 0; j < sources.size(); ++j) {
+            EXPECT_EQ(panel.columnIds()[j], sources[j]->getId());
+            // A Stochastic column draws from its own stream, derived from the batch seed.
+            const ts::Seed seed = strategy == InterpolationStrategy::Stochastic
+                                      ? ts::rngForStream(3, ts::RngDomain::Resampling, j)()
+                                      : ts::Seed{3};
+            const auto single = ts::resample(*sources[j], target, strategy, {.seed = seed});
+            for (size_t i = 0; i < target->size(); ++i) {
+                const double expected = single.isValid(i) ? single.getValues()[i] : NAN;
+                if (std::isnan(expected)) {
+                    EXPECT_TRUE(std::isnan(panel(i, j))) << ts::toString(strategy) << " " << i << "," << j;
+                } else {
+                    EXPECT_EQ(panel(i, j), expected) << ts::toString(strategy) << " " << i << "," << j;
+                }
+            }
+        }
+    }
+
+    // The same series twice is not bridged with the same noise twice.
+    const std::vector<const TimeSeries*> twice{simpleSeries.get(), simpleSeries.get()};
+    const auto bridged = ts::resampleMany(twice, target, InterpolationStrategy::Stochastic, {.seed = 3});
+    EXPECT_NE(bridged(2, 0), bridged(2, 1));
+
+    const auto named = ts::resampleMany(sources, target, InterpolationStrategy::Latest, {}, {"a", "b", "c", "d"});
+    EXPECT_EQ(named.columnIndex("c"), 2u);
+    EXPECT_THROW(ts::resampleMany(sources, target, InterpolationStrategy::Latest, {}, {"a"}), std::invalid_argument);
+}
+
+namespace {
+// Every aggregation of bucket [from, to), the slow way.
+double bruteAggregate(const TimeSeries& src, const TimeSeries* volume, ts::Aggregation how, int64_t from, int64_t to) {
+    std::vector<double> in;
+    double pv = 0.0, vs = 0.0, last = NAN;
+    const auto stamps = src.getTimestamps();
+    for (size_t k = 0; k < src.size(); ++k) {
+        if (!src.isValid(k) || stamps[k] >= to) continue;
+        last = src.getValues()[k];
+        if (stamps[k] < from) continue;
+        in.push_back(src.getValues()[k]);
+        if (volume && volume->isValid(k)) {
+            pv += src.getValues()[k] * volume->getValues()[k];
+            vs += volume->getValues()[k];
+        }
+    }
+    double sum = 0.0;
+    for (const double v : in) sum += v;
+    switch (how) {
+        case ts::Aggregation::Open: return in.empty() ? NAN : in.front();
+        case ts::Aggregation::High: return in.empty() ? NAN : *std::max_element(in.begin(), in.end());
+        case ts::Aggregation::Low: return in.empty() ? NAN : *std::min_element(in.begin(), in.end());
+        case ts::Aggregation::Close: return in.empty() ? NAN : in.back();
+        case ts::Aggregation::Sum: return sum;
+        case ts::Aggregation::Mean: return in.empty() ? NAN : sum / static_cast<double>(in.size());
+        case ts::Aggregation::Count: return static_cast<double>(in.size());
+        case ts::Aggregation::Last: return last;
+        case ts::Aggregation::Vwap: return vs > 0.0 ? pv / vs : NAN;
+    }
+    return NAN;
+}
+}  // namespace
+
+TEST_F(TimeSeriesResamplingTest, AggregateBuildsBarsFromTheBucketPoints) {
+    constexpr std::array kAll{ts::Aggregation::Open,
+                              ts::Aggregation::High,
+                              ts::Aggregation::Low,
+                              ts::Aggregation::Close,
+                              ts::Aggregation::Sum,
+                              ts::Aggregation::Mean,
+                              ts::Aggregation::Count,
+                              ts::Aggregation::Last,
+                              ts::Aggregation::Vwap};
+    // Small enough for one chunk, large enough for many: the same checks run on both.
+    for (const size_t points : {size_t{400}, size_t{90'000}}) {
+        std::vector<int64_t> stamps;
+        std::vector<double> prices, volumes;
+        for (size_t k = 0; k < points; ++k) {
+            const auto t = static_cast<int64_t>(k * 7);
+            if (t % 1000 >= 300 && t % 1000 < 420) continue;  // a hole wider than some buckets
+            stamps.push_back(t);
+            prices.push_back(100.0 + std::sin(static_cast<double>(k) * 0.1) * 5.0);
+            volumes.push_back(k % 5 == 0 ? NAN : static_cast<double>(1 + k % 13));
+        }
+        prices[3] = NAN;
+        TimeSeries price("Px", ts::Timestamps(stamps), std::vector<double>(prices));
+        price.markMissing();
+        TimeSeries volume("Vol", ts::Timestamps(stamps), std::vector<double>(volumes));
+        volume.markMissing();
+
+        const int64_t step = 50;
+        const auto buckets = static_cast<size_t>(stamps.back() / step);
+        auto target = std::make_shared<const ts::TimestampGrid>(10, step, buckets);
+        const auto bars = ts::aggregate(price, target, kAll, &volume);
+        ASSERT_EQ(bars.rows(), buckets);
+        ASSERT_EQ(bars.columnIds()[3], "Close");
+        for (size_t i = 0; i < buckets; ++i) {
+            const int64_t from = (*target)[i];
+            for (size_t c = 0; c < kAll.size(); ++c) {
+                const double expected = bruteAggregate(price, &volume, kAll[c], from, from + step);
+                if (std::isnan(expected)) {
+                    ASSERT_TRUE(std::isnan(bars(i, c))) << ts::toString(kAll[c]) << " bucket " << i;
+                } else {
+                    ASSERT_NEAR(bars(i, c), expected, 1e-9) << ts::toString(kAll[c]) << " bucket " << i;
+                }
+            }
+        }
+    }
+
+    // One aggregation as a series: empty buckets are flagged rather than handed on as NaN.
+    auto target = std::make_shared<const ts::TimestampGrid>(ts::Timestamps{0, 2500, 2600, 4000});
+    const auto close = ts::aggregate(*simpleSeries, target, ts::Aggregation::Close);
+    EXPECT_DOUBLE_EQ(close.getValues()[0], 2.0);
+    EXPECT_FALSE(close.isValid(1));
+    EXPECT_DOUBLE_EQ(close.getValues()[2], 3.0);
+    EXPECT_DOUBLE_EQ(close.getValues()[3], 5.0);  // the last bucket is as long as the one before it
+
+    EXPECT_THROW(ts::aggregate(*simpleSeries, target, ts::Aggregation::Vwap), std::invalid_argument);
+    auto offGrid = makeSeriesAt("Vol", {1000, 2000, 3000, 4000, 5001}, {1, 1, 1, 1, 1});
+    EXPECT_THROW(ts::aggregate(*simpleSeries, target, ts::Aggregation::Vwap, offGrid.get()), std::invalid_argument);
+}
+
+TEST(TimeSeriesServiceAggregation, BarsComeFromTheFinestCachedBucket) {
+    constexpr int64_t kMinute = 60'000;
+    constexpr int64_t kDay = 1'440 * kMinute;
+    // Minute points count up from 0 over two and a bit days; the daily bucket holds only -1s,
+    // so any bar built from it shows.
+    std::vector<int64_t> minuteStamps, dayStamps;
+    std::vector<double> minuteValues;
+    for (int64_t t = 0; t <= 2 * kDay + kMinute; t += kMinute) {
+        minuteStamps.push_back(t);
+        minuteValues.push_back(static_cast<double>(t / kMinute));
+    }
+    for (int64_t t = 0; t <= 2 * kDay; t += kDay) dayStamps.push_back(t);
+    auto cache = std::make_shared<ts::CachedTimeSeriesRepository>(std::make_shared<ts::InMemoryTimeSeriesRepository>());
+    cache->save(ts::SeriesKey{"X", kMinute}, TimeSeries("X", ts::Timestamps(minuteStamps), std::move(minuteValues)));
+    cache->save(ts::SeriesKey{"X", kDay}, TimeSeries("X", ts::Timestamps(dayStamps), std::vector<double>(3, -1.0)));
+    ts::TimeSeriesService service(cache, nullptr);
+
+    constexpr std::array kBar{
+        ts::Aggregation::Open, ts::Aggregation::High, ts::Aggregation::Low, ts::Aggregation::Count};
+    const auto bars = service.getAggregated("X", ts::TimestampGrid::regular(0, kDay, 2), kBar);
+    ASSERT_EQ(bars.rows(), 2u);
+    for (size_t day = 0; day < 2; ++day) {
+        const double first = static_cast<double>(day * 1'440);
+        EXPECT_DOUBLE_EQ(bars(day, 0), first);
+        EXPECT_DOUBLE_EQ(bars(day, 1), first + 1'439.0);
+        EXPECT_DOUBLE_EQ(bars(day, 2), first);
+        EXPECT_DOUBLE_EQ(bars(day, 3), 1'440.0);
+    }
+
+    // An hourly grid reads the minutes too; a grid as fine as the minutes has no bucket strictly
+    // finer to read, and no provider to fetch one from.
+    const auto hourly = ts::TimestampGrid::regular(kDay, 60 * kMinute, 3);
+    EXPECT_DOUBLE_EQ(service.getAggregated("X", hourly, ts::Aggregation::Close).getValues()[2], 1'440.0 + 179.0);
+    EXPECT_THROW(service.getAggregated("X", ts::TimestampGrid::regular(0, kMinute, 10), ts::Aggregation::Close),
+                 std::exception);
+}
+
+TEST(TimeSeriesServiceBatch, GetFilledManyMatchesGetFilledPerId) {
+    // Two ids on one set of timestamps (one plan between them) and one on its own.
+    auto cache = std::make_shared<ts::CachedTimeSeriesRepository>(std::make_shared<ts::InMemoryTimeSeriesRepository>());
+    cache->save(ts::SeriesKey{"A", 10}, TimeSeries("A", ts::Timestamps{0, 10, 25, 40}, {1.0, 2.0, 4.0, 8.0}));
+    cache->save(ts::SeriesKey{"B", 10}, TimeSeries("B", ts::Timestamps{0, 10, 25, 40}, {-1.0, 0.0, 3.0, 1.0}));
+    cache->save(ts::SeriesKey{"C", 10}, TimeSeries("C", ts::Timestamps{0, 17, 40}, {5.0, 6.0, 7.0}));
+    ts::TimeSeriesService service(cache, nullptr);
+    const std::vector<std::string> ids{"A", "B", "C"};
+    auto grid = std::make_shared<const ts::TimestampGrid>(ts::Timestamps{0, 5, 12, 25, 33, 40});
+
+    for (const auto strategy : {InterpolationStrategy::Linear, InterpolationStrategy::Latest}) {
+        const auto panel = service.getFilledMany(ids, grid, strategy);
+        ASSERT_EQ(panel.cols(), ids.size());
+        EXPECT_EQ(panel.getSharedTimestamps(), grid);
+        for (size_t j = 0; j < ids.size(); ++j) {
+            EXPECT_EQ(panel.columnIds()[j], ids[j]);
+            const auto single = service.getFilled(ids[j], grid, strategy);
+            for (size_t i = 0; i < grid->size(); ++i) {
+                EXPECT_EQ(panel(i, j), single.getValues()[i]) << ts::toString(strategy) << " " << ids[j] << " " << i;
+            }
+        }
+    }
+    EXPECT_THROW(service.getFilledMany(ids, nullptr), std::invalid_argument);
+}
+
 TEST_F(TimeSeriesResamplingTest, ParallelBoundaryContinuity) {
     const size_t N = 100000;
     std::vector<int64_t> ts(N);
@@ -73,6 +391,126 @@ TEST_F(TimeSeriesResamplingTest, ParallelBoundaryContinuity) {
     }
 }
 
+TEST_F(TimeSeriesResamplingTest, ChunkedWalkMatchesOneSequentialWalk) {
+    // Eleven chunks on the pool against the plan, which walks the whole grid in one pass.
+    const size_t N = 70'000;
+    std::vector<int64_t> ts(N);
+    std::vector<double> vals(N);
+    for (size_t i = 0; i < N; ++i) {
+        ts[i] = static_cast<int64_t>(i * 300 + (i * i) % 97);
+        vals[i] = std::sin(static_cast<double>(i) * 0.01);
+    }
+    TimeSeries src("Chunked", std::move(ts), std::move(vals));
+    auto target = std::make_shared<const ts::TimestampGrid>(-1'000, 100, 215'000);
+
+    for (const auto strategy : {InterpolationStrategy::Linear,
+                                InterpolationStrategy::Nearest,
+                                InterpolationStrategy::Latest,
+                                InterpolationStrategy::Exact}) {
+        const auto chunked = ts::resample(src, target, strategy);
+        const auto sequential = ts::resample(src, ts::InterpolationPlan(src, target, strategy));
+        ASSERT_EQ(chunked.validCount(), sequential.validCount()) << ts::toString(strategy);
+        for (size_t i = 0; i < chunked.size(); ++i) {
+            if (!chunked.isValid(i)) continue;
+            ASSERT_EQ(chunked.getValues()[i], sequential.getValues()[i]) << ts::toString(strategy) << " row " << i;
+        }
+    }
+
+    // Each chunk's noise stream follows its ordinal, so the schedule never shows in the result.
+    const auto first = ts::resample(src, target, InterpolationStrategy::Stochastic, {.seed = 7});
+    const auto second = ts::resample(src, target, InterpolationStrategy::Stochastic, {.seed = 7});
+    EXPECT_TRUE(std::equal(first.getValues().begin(), first.getValues().end(), second.getValues().begin()));
+}
+
+TEST_F(TimeSeriesResamplingTest, RegularGridsTakeTheArithmeticPathBitForBit) {
+    // A slice (offset 3) of a regular source grid onto regular targets: integer up- and
+    // downsampling ratios, a non-integer one, phase-shifted starts and rows past both ends.
+    const size_t N = 5'000;
+    std::vector<double> vals(N + 3);
+    for (size_t i = 0; i < vals.size(); ++i) vals[i] = std::sin(static_cast<double>(i) * 0.37) * 1e3;
+    auto grid = std::make_shared<const ts::TimestampGrid>(10'000, 60, N + 3);
+    TimeSeries src("Regular", grid, 3, std::vector<double>(vals.begin() + 3, vals.end()));
+
+    const std::array<std::array<int64_t, 3>, 6> targets{{{10'180, 60, N},          // the source's own grid
+                                                          {9'000, 15, 4 * N},       // 4x upsampling
+                                                          {10'187, 20, 3 * N},      // 3x, off-phase
+                                                          {8'000, 180, N / 2},      // 3x downsampling
+                                                          {10'003, 47, 7'000},      // no integer ratio
+                                                          {400'000, 11, 1'000}}};  // past the end
+    for (const auto& [start, step, count] : targets) {
+        auto target = std::make_shared<const ts::TimestampGrid>(start, step, static_cast<size_t>(count));
+        for (const auto strategy : {InterpolationStrategy::Linear,
+                                    InterpolationStrategy::Nearest,
+                                    InterpolationStrategy::Latest,
+                                    InterpolationStrategy::Exact}) {
+            const auto regular = ts::resample(src, target, strategy);
+            const auto walked = ts::resample(src, ts::InterpolationPlan(src, target, strategy));
+            ASSERT_EQ(regular.validCount(), walked.validCount()) << ts::toString(strategy) << " step " << step;
+            for (size_t i = 0; i < regular.size(); ++i) {
+                if (!regular.isValid(i)) continue;
+                ASSERT_EQ(regular.getValues()[i], walked.getValues()[i])
+                    << ts::toString(strategy) << " step " << step << " row " << i;
+            }
+        }
+    }
+}
+
+TEST_F(TimeSeriesResamplingTest, EvenlySpacedExplicitGridsTakeTheArithmeticPath) {
+    // Loaded grids are explicit even when evenly spaced; their spacing is found with the
+    // fingerprint, so they resample like the regular grid of the same points.
+    const size_t N = 3'000;
+    ts::Timestamps stamps(N);
+    std::vector<double> vals(N);
+    for (size_t i = 0; i < N; ++i) {
+        stamps[i] = 5'000 + static_cast<int64_t>(i) * 40;
+        vals[i] = std::cos(static_cast<double>(i) * 0.21) * 50.0;
+    }
+    TimeSeries explicitSrc("Explicit", ts::Timestamps(stamps), std::vector<double>(vals));
+    auto regularGrid = std::make_shared<const ts::TimestampGrid>(5'000, 40, N);
+    TimeSeries regularSrc("Regular", regularGrid, std::vector<double>(vals));
+    ts::Timestamps targetStamps;
+    for (int64_t t = 4'990; t < 5'000 + static_cast<int64_t>(N) * 40 + 100; t += 10) targetStamps.push_back(t);
+    auto explicitTarget = std::make_shared<const ts::TimestampGrid>(ts::Timestamps(targetStamps));
+    auto regularTarget = std::make_shared<const ts::TimestampGrid>(4'990, 10, targetStamps.size());
+    ASSERT_FALSE(explicitSrc.getSharedTimestamps()->isRegular());
+    EXPECT_EQ(explicitSrc.getSharedTimestamps()->uniformStep(), 40);
+    EXPECT_EQ(explicitTarget->uniformStep(), 10);
+
+    for (const auto strategy : {InterpolationStrategy::Linear,
+                                InterpolationStrategy::Nearest,
+                                InterpolationStrategy::Latest,
+                                InterpolationStrategy::Exact}) {
+        ASSERT_TRUE(ts::resamplesArithmetically(explicitSrc, *explicitTarget, strategy));
+        const auto fast = ts::resample(explicitSrc, explicitTarget, strategy);
+        const auto walked = ts::resample(explicitSrc, ts::InterpolationPlan(explicitSrc, explicitTarget, strategy));
+        const auto regular = ts::resample(regularSrc, regularTarget, strategy);
+        for (size_t i = 0; i < fast.size(); ++i) {
+            ASSERT_EQ(fast.isValid(i), walked.isValid(i)) << ts::toString(strategy) << " row " << i;
+            if (!fast.isValid(i)) continue;
+            ASSERT_EQ(fast.getValues()[i], walked.getValues()[i]) << ts::toString(strategy) << " row " << i;
+            ASSERT_EQ(fast.getValues()[i], regular.getValues()[i]) << ts::toString(strategy) << " row " << i;
+        }
+    }
+
+    // The batch replays nothing for such a group, and still matches one resample per series.
+    TimeSeries twin("Twin", explicitSrc.getSharedTimestamps(), std::vector<double>(vals.rbegin(), vals.rend()));
+    const std::vector<const TimeSeries*> both{&explicitSrc, &twin};
+    const auto panel = ts::resampleMany(both, explicitTarget, InterpolationStrategy::Linear);
+    const auto alone = ts::resample(twin, explicitTarget, InterpolationStrategy::Linear);
+    for (size_t i = 0; i < alone.size(); ++i) ASSERT_EQ(panel(i, 1), alone.getValues()[i]) << i;
+
+    // One uneven gap, a gap in the source, or a random strategy: back to the walk.
+    stamps[N / 2] += 1;
+    TimeSeries uneven("Uneven", ts::Timestamps(stamps), std::vector<double>(vals));
+    EXPECT_EQ(uneven.getSharedTimestamps()->uniformStep(), 0);
+    EXPECT_FALSE(ts::resamplesArithmetically(uneven, *explicitTarget, InterpolationStrategy::Linear));
+    EXPECT_FALSE(ts::resamplesArithmetically(explicitSrc, *explicitTarget, InterpolationStrategy::Stochastic));
+    vals[7] = NAN;
+    TimeSeries holed("Holed", explicitSrc.getSharedTimestamps(), std::vector<double>(vals));
+    holed.markMissing();
+    EXPECT_FALSE(ts::resamplesArithmetically(holed, *explicitTarget, InterpolationStrategy::Linear));
+}
+
 TEST_F(TimeSeriesResamplingTest, ParallelSpeedupBenchmark) {
     const size_t N = 1000000;
     std::vector<int64_t> ts(N);
@@ -1,19 +1,51 @@
 // "Copyright (c) 2026 JBBLET All Rights Reserved."
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "TestMockTimeSeries.hpp"
+#include "finlib/core/Ewma.hpp"
+#include "finlib/core/RollingStats.hpp"
 #include "finlib/core/StatsCore.hpp"
+#include "finlib/core/TDigest.hpp"
+#include "finlib/core/TimeSeriesPanel.hpp"
 #include "finlib/core/TimeSeriesView.hpp"
+#include "finlib/core/ValidityBitmap.hpp"
 
 class TimeSeriesStatsTest : public TimeSeriesMocks {
  protected:
     std::shared_ptr<TimeSeries> series;
+    // Textbook inputs for the hypothesis tests, seeded so the verdicts are reproducible: white
+    // noise, its running sum (a unit root), an AR(1) with phi = 0.6, and noise whose scale grows
+    // fourfold over the sample.
+    std::vector<double> noise, walk, autoregressive, heteroskedastic;
 
     void SetUp() override {
         TimeSeriesMocks::SetUp();
         series = decadeSeries;
+
+        constexpr size_t n = 2000;
+        std::mt19937 rng(20260417);
+        std::normal_distribution<double> normal;
+        double level = 0.0, ar = 0.0;
+        for (size_t t = 0; t < n; ++t) {
+            const double e = normal(rng);
+            level += e;
+            ar = 0.6 * ar + e;
+            noise.push_back(e);
+            walk.push_back(level);
+            autoregressive.push_back(ar);
+            heteroskedastic.push_back(e * (1.0 + 3.0 * static_cast<double>(t) / n));
+        }
     }
 };
 
@@ -23,3 +55,456 @@ TEST_F(TimeSeriesStatsTest, TimeSeriesProducesFullView) {
     EXPECT_EQ(ts::analysis::stats::varianceSlow(view, ts::analysis::stats::VarianceType::Population), 200.00);
     EXPECT_EQ(ts::analysis::stats::varianceFast(view, ts::analysis::stats::VarianceType::Population), 200.00);
 }
+
+TEST_F(TimeSeriesStatsTest, MaskedMomentsMatchTheCompactedSample) {
+    // 150 lanes spanning three bitmap words, every seventh one missing (its payload a decoy
+    // finite value, so only the mask can exclude it).
+    std::vector<double> values(150);
+    std::vector<double> present;
+    ts::ValidityBitmap bitmap(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::sin(static_cast<double>(i) * 0.3) * 5.0 + static_cast<double>(i % 11);
+        if (i % 7 == 3) {
+            values[i] = 1e6;
+            bitmap.set(i, false);
+        } else {
+            present.push_back(values[i]);
+        }
+    }
+    namespace stats = ts::analysis::stats;
+    const auto mask = bitmap.mask();
+    EXPECT_EQ(mask.countValid(), present.size());
+    EXPECT_NEAR(stats::mean(values, mask), stats::mean(present), 1e-12);
+    EXPECT_NEAR(stats::varianceFast(values, mask), stats::varianceFast(present), 1e-9);
+    EXPECT_NEAR(stats::varianceSlow(values, mask), stats::varianceSlow(present), 1e-9);
+    EXPECT_NEAR(stats::skewness(values, mask), stats::skewness(present), 1e-9);
+    EXPECT_NEAR(stats::kurtosis(values, mask), stats::kurtosis(present), 1e-9);
+
+    // An unaligned window reads the same lanes as the compacted slice.
+    const std::span<const double> window(values.data() + 37, 90);
+    std::vector<double> windowPresent;
+    for (size_t i = 37; i < 127; ++i) {
+        if (bitmap.isValid(i)) windowPresent.push_back(values[i]);
+    }
+    EXPECT_NEAR(stats::mean(window, bitmap.mask(37, 90)), stats::mean(windowPresent), 1e-12);
+}
+
+TEST_F(TimeSeriesStatsTest, FftAutocovariancesMatchTheDirectSums) {
+    namespace stats = ts::analysis::stats;
+    // An odd length, so the packed real transform also has to handle a trailing even sample.
+    std::vector<double> values(3001);
+    double level = 100.0;
+    for (size_t i = 0; i < values.size(); ++i) {
+        level += std::sin(static_cast<double>(i) * 0.7) + 0.3 * std::cos(static_cast<double>(i * i % 97));
+        values[i] = level;
+    }
+    const auto direct = stats::autocovariances(values, 400, stats::CorrelationMethod::Direct);
+    const auto fft = stats::autocovariances(values, 400, stats::CorrelationMethod::Fft);
+    ASSERT_EQ(fft.size(), direct.size());
+    for (size_t k = 0; k < direct.size(); ++k) EXPECT_NEAR(fft[k], direct[k], 1e-10 * direct[0]) << "lag " << k;
+
+    const auto acfDirect = stats::acf(values, 400, stats::CorrelationMethod::Direct);
+    const auto acfAuto = stats::acf(values, 400);  // 3001·401 is past the threshold
+    for (size_t k = 0; k < acfDirect.size(); ++k) EXPECT_NEAR(acfAuto[k], acfDirect[k], 1e-10);
+
+    // Tiny inputs and lag clamping behave the same on both paths.
+    const std::vector<double> pair{1.0, 3.0};
+    EXPECT_EQ(stats::autocovariances(pair, 5, stats::CorrelationMethod::Fft).size(), 2u);
+    EXPECT_NEAR(stats::autocovariances(pair, 5, stats::CorrelationMethod::Fft)[1], -1.0, 1e-12);
+    EXPECT_NEAR(stats::acf(std::vector<double>(9, 2.0), 3, stats::CorrelationMethod::Fft)[2], 0.0, 1e-12);
+}
+
+TEST_F(TimeSeriesStatsTest, FusedMomentsMatchTheSeparatePassesAndMerge) {
+    namespace stats = ts::analysis::stats;
+    // Several staging blocks, a large offset (where naive power sums lose everything), and a NaN
+    // that must be skipped like the other moment functions skip it.
+    std::vector<double> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        const auto t = static_cast<double>(i);
+        values[i] = 1e6 + std::sin(t) * std::exp(0.002 * t);
+    }
+    values[17] = NAN;
+
+    const stats::Moments m = stats::moments(values);
+    EXPECT_EQ(m.count, 999u);
+    EXPECT_NEAR(m.mean, stats::mean(values), 1e-9);
+    EXPECT_NEAR(m.variance(), stats::varianceSlow(values), 1e-9);
+    EXPECT_NEAR(m.skewness(), stats::skewness(values), 1e-9);
+    EXPECT_NEAR(m.kurtosis(), stats::kurtosis(values), 1e-9);
+    EXPECT_DOUBLE_EQ(m.max, *std::max_element(values.begin() + 18, values.end()));
+
+    // Folding two halves in gives the same accumulator as one pass over the whole.
+    const std::span<const double> all(values);
+    stats::Moments halves = stats::moments(all.first(400));
+    halves.merge(stats::moments(all.subspan(400)));
+    EXPECT_EQ(halves.count, m.count);
+    EXPECT_NEAR(halves.mean, m.mean, 1e-9);
+    EXPECT_NEAR(halves.m2 / m.m2, 1.0, 1e-12);
+    EXPECT_NEAR(halves.m3, m.m3, 1e-9 * std::abs(m.m2));
+    EXPECT_NEAR(halves.m4 / m.m4, 1.0, 1e-12);
+    EXPECT_DOUBLE_EQ(halves.min, m.min);
+
+    EXPECT_THROW(stats::moments(all.first(2)).kurtosis(), std::invalid_argument);
+}
+
+TEST_F(TimeSeriesStatsTest, ParallelMomentsAreReproducibleAndMatchTheOnlineUpdate) {
+    namespace stats = ts::analysis::stats;
+    // Long enough to be split into chunks and run in parallel, with a ragged last chunk and a
+    // mask that knocks out lanes across chunk boundaries.
+    std::vector<double> values(100'003);
+    ts::ValidityBitmap bitmap(values.size());
+    stats::Moments online;
+    for (size_t i = 0; i < values.size(); ++i) {
+        const auto t = static_cast<double>(i);
+        values[i] = 50.0 + std::sin(t * 0.01) * 3.0 + std::cos(t * 1.3);
+        if (i % 8191 == 5) {
+            bitmap.set(i, false);
+        } else {
+            online.push(values[i]);
+        }
+    }
+    const auto mask = bitmap.mask();
+
+    const stats::Moments first = stats::moments(values, mask);
+    const stats::Moments second = stats::moments(values, mask);
+    EXPECT_EQ(first.count, online.count);
+    // Same chunks, same reduction tree: the scheduling of the chunks cannot show in the bits.
+    EXPECT_EQ(first.mean, second.mean);
+    EXPECT_EQ(first.m2, second.m2);
+    EXPECT_EQ(first.m3, second.m3);
+    EXPECT_EQ(first.m4, second.m4);
+    EXPECT_EQ(stats::varianceFast(values, mask), first.variance());
+
+    EXPECT_NEAR(first.mean, online.mean, 1e-10);
+    EXPECT_NEAR(first.m2 / online.m2, 1.0, 1e-10);
+    EXPECT_NEAR(first.m3, online.m3, 1e-9 * online.m2);
+    EXPECT_NEAR(first.m4 / online.m4, 1.0, 1e-10);
+    EXPECT_EQ(first.skewness(), stats::skewness(values, mask));
+    EXPECT_DOUBLE_EQ(first.min, online.min);
+    EXPECT_DOUBLE_EQ(first.max, online.max);
+}
+
+TEST_F(TimeSeriesStatsTest, ConstantSamplesHaveNoSpreadOrShape) {
+    namespace stats = ts::analysis::stats;
+    // 0.1 is not representable, so sum / n does not round back to it; the sums must still be 0.
+    // One staged block, several, and enough chunks to run in parallel.
+    for (const size_t n : {size_t{100}, size_t{1'000}, size_t{50'000}}) {
+        const std::vector<double> flat(n, 0.1);
+        const stats::Moments m = stats::moments(flat);
+        EXPECT_EQ(m.mean, 0.1) << n;
+        EXPECT_EQ(m.m2, 0.0) << n;
+        EXPECT_EQ(stats::varianceFast(flat), 0.0) << n;
+        EXPECT_EQ(stats::skewness(flat), 0.0) << n;
+        EXPECT_EQ(stats::kurtosis(flat), 0.0) << n;
+    }
+}
+
+TEST_F(TimeSeriesStatsTest, HypothesisTestsSeparateTheTextbookCases) {
+    namespace ht = ts::analysis::hypothesisTesting;
+    // 1..5: no skew, population kurtosis 1.7, so JB = 5/6 * 1.3^2 / 4.
+    const std::vector<double> ramp{1, 2, 3, 4, 5};
+    EXPECT_NEAR(ht::jarqueBera(ramp).statistic, 5.0 / 6.0 * 1.69 / 4.0, 1e-12);
+    EXPECT_GT(ht::jarqueBera(noise).p_value, 0.01);
+    std::vector<double> squared;
+    for (double e : noise) squared.push_back(e * e);
+    EXPECT_LT(ht::jarqueBera(squared).p_value, 1e-6);
+
+    EXPECT_GT(ht::adf(walk).p_value, 0.1);
+    EXPECT_LT(ht::adf(noise).p_value, 0.01);
+    EXPECT_LT(ht::adf(autoregressive, 1).statistic, -3.5);
+
+    const auto pagan = ht::breuschPagan(heteroskedastic);
+    EXPECT_LT(pagan.p_value, 1e-3);
+    EXPECT_GT(ht::breuschPagan(noise).p_value, 0.01);
+    // One degree of freedom: the chi-squared tail is erfc(sqrt(x / 2)).
+    EXPECT_NEAR(pagan.p_value, std::erfc(std::sqrt(pagan.statistic / 2.0)), 1e-12);
+
+    EXPECT_LT(ht::breuschGodfrey(autoregressive).p_value, 1e-6);
+    const auto godfrey = ht::breuschGodfrey(noise, 2);
+    EXPECT_GT(godfrey.p_value, 0.01);
+    // Two degrees of freedom: the tail is exp(-x / 2).
+    EXPECT_NEAR(godfrey.p_value, std::exp(-godfrey.statistic / 2.0), 1e-12);
+
+    // A constant sample has no statistic; a gap or a too-short sample is an error.
+    EXPECT_TRUE(std::isnan(ht::adf(std::vector<double>(50, 3.0)).statistic));
+    EXPECT_TRUE(std::isnan(ht::breuschPagan(std::vector<double>(50, 3.0)).p_value));
+    // Nor with a value whose mean does not round back to it.
+    const auto flatJb = ht::jarqueBera(std::vector<double>(50, 0.1));
+    EXPECT_TRUE(std::isnan(flatJb.statistic));
+    EXPECT_TRUE(std::isnan(flatJb.p_value));
+    std::vector<double> gapped = noise;
+    gapped[10] = NAN;
+    EXPECT_THROW(ht::adf(gapped), std::invalid_argument);
+    EXPECT_THROW(ht::breuschGodfrey(ramp, 3), std::invalid_argument);
+}
+
+TEST_F(TimeSeriesStatsTest, BatchHypothesisTestsMatchTheSingleSeriesResults) {
+    namespace ht = ts::analysis::hypothesisTesting;
+    ts::Timestamps stamps(noise.size());
+    std::iota(stamps.begin(), stamps.end(), ts::Timestamp{1000});
+    std::vector<TimeSeries> columns{TimeSeries("col0", stamps, noise)};
+    const ts::TimestampsPtr grid = columns[0].getSharedTimestamps();
+    for (const auto* values : {&walk, &autoregressive, &heteroskedastic}) {
+        columns.emplace_back("col" + std::to_string(columns.size()), grid, *values);
+    }
+    const auto panel = std::make_shared<ts::TimeSeriesPanel>(ts::TimeSeriesPanel::fromSeries(columns));
+    std::vector<ts::TimeSeriesView> views;
+    for (size_t j = 0; j < panel->cols(); ++j) views.push_back(panel->columnView(j));
+    // A shorter window puts a second length into the breuschPagan grouping.
+    views.push_back(panel->columnView(3).slice(0, 1200));
+
+    auto expectMatches = [](const std::vector<ht::HypothesisTestResult>& batch, size_t i,
+                            const ht::HypothesisTestResult& single) {
+        EXPECT_NEAR(batch[i].statistic, single.statistic, 1e-9 * std::abs(single.statistic)) << "series " << i;
+        EXPECT_NEAR(batch[i].p_value, single.p_value, 1e-9) << "series " << i;
+    };
+    const auto jb = ht::jarqueBera(views);
+    const auto adf = ht::adf(views);
+    const auto pagan = ht::breuschPagan(views);
+    const auto godfrey = ht::breuschGodfrey(views);
+    ASSERT_EQ(pagan.size(), views.size());
+    for (size_t i = 0; i < views.size(); ++i) {
+        expectMatches(jb, i, ht::jarqueBera(views[i]));
+        expectMatches(adf, i, ht::adf(views[i]));
+        expectMatches(pagan, i, ht::breuschPagan(views[i]));
+        expectMatches(godfrey, i, ht::breuschGodfrey(views[i]));
+    }
+    const auto panelPagan = ht::breuschPagan(*panel);
+    const auto panelAdf = ht::adf(*panel, 3);
+    for (size_t j = 0; j < panel->cols(); ++j) {
+        expectMatches(panelPagan, j, pagan[j]);
+        expectMatches(panelAdf, j, ht::adf(panel->column(j), 3));
+    }
+
+    // A gap anywhere rejects the whole batch, naming the series.
+    ts::ValidityBitmap bitmap(noise.size());
+    bitmap.set(42, false);
+    columns[2].setValidity(bitmap);
+    const auto gappedSeries = std::make_shared<const TimeSeries>(columns[2]);
+    views.push_back(gappedSeries->view());
+    EXPECT_THROW(ht::adf(views), std::invalid_argument);
+    EXPECT_NO_THROW(ht::jarqueBera(views));
+}
+
+TEST_F(TimeSeriesStatsTest, DurbinLevinsonGivesEveryOrderOfTheYuleWalkerSystem) {
+    namespace stats = ts::analysis::stats;
+    constexpr size_t maxLag = 6;
+    const auto gamma = stats::autocovariances(autoregressive, maxLag);
+    const stats::DurbinLevinson recursion = stats::durbinLevinson(gamma, maxLag);
+    ASSERT_EQ(recursion.maxOrder(), maxLag);
+
+    for (size_t k = 1; k <= maxLag; ++k) {
+        // Each order solves its own Toeplitz system, and its last coefficient is the PACF.
+        const Eigen::MatrixXd R = stats::toeplitzFromAutocovariances(gamma, k);
+        const Eigen::VectorXd r = Eigen::Map<const Eigen::VectorXd>(gamma.data() + 1, static_cast<Eigen::Index>(k));
+        const Eigen::VectorXd phi = R.ldlt().solve(r);
+        const auto coefficients = recursion.coefficients(k);
+        for (size_t j = 0; j < k; ++j) EXPECT_NEAR(coefficients[j], phi(static_cast<Eigen::Index>(j)), 1e-10);
+        EXPECT_DOUBLE_EQ(recursion.partialAutocorrelations[k], coefficients[k - 1]);
+        EXPECT_NEAR(recursion.innovationVariances[k], gamma[0] - r.dot(phi), 1e-9 * gamma[0]);
+        EXPECT_LE(recursion.innovationVariances[k], recursion.innovationVariances[k - 1]);
+    }
+    // AR(1) with phi = 0.6: one clear spike, nothing of note after it.
+    const auto partial = stats::pacf(autoregressive, maxLag);
+    EXPECT_NEAR(partial[1], 0.6, 0.05);
+    for (size_t k = 2; k <= maxLag; ++k) EXPECT_LT(std::abs(partial[k]), 0.1) << "lag " << k;
+    EXPECT_THROW(recursion.coefficients(maxLag + 1), std::invalid_argument);
+
+    // A constant sample has nothing to predict: the recursion stops contributing.
+    const auto flat = stats::durbinLevinson(std::vector<double>{0.0, 0.0, 0.0}, 2);
+    EXPECT_EQ(flat.partialAutocorrelations, (std::vector<double>{1.0, 0.0, 0.0}));
+}
+
+TEST_F(TimeSeriesStatsTest, TDigestQuantilesStayWithinTheDocumentedRankError) {
+    namespace stats = ts::analysis::stats;
+    std::mt19937 rng(7);
+    std::normal_distribution<double> normal;
+    for (const bool lognormal : {false, true}) {
+        std::vector<double> samples(1'000'000);
+        for (double& v : samples) v = lognormal ? std::exp(normal(rng)) : normal(rng);
+
+        stats::TDigest whole;
+        whole.add(samples);
+        // Per-thread style: eight sketches over contiguous shards, folded in order.
+        std::vector<stats::TDigest> shards(8);
+        for (size_t i = 0; i < samples.size(); ++i) shards[i * shards.size() / samples.size()].add(samples[i]);
+        stats::TDigest merged;
+        for (const auto& shard : shards) merged.merge(shard);
+
+        std::sort(samples.begin(), samples.end());
+        const auto n = static_cast<double>(samples.size());
+        auto rankOf = [&](double v) {
+            return static_cast<double>(std::lower_bound(samples.begin(), samples.end(), v) - samples.begin()) / n;
+        };
+        EXPECT_EQ(merged.count(), samples.size());
+        EXPECT_LE(whole.centroids().size(), static_cast<size_t>(whole.compression()));
+        EXPECT_EQ(whole.quantile(0.0), samples.front());
+        EXPECT_EQ(merged.quantile(1.0), samples.back());
+        for (const double q : {1e-4, 1e-3, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999, 0.9999}) {
+            const double bound = (q <= 1e-3 || q >= 0.999) ? 2e-4 : 1e-3;
+            EXPECT_NEAR(rankOf(whole.quantile(q)), q, bound) << "q " << q;
+            EXPECT_NEAR(rankOf(merged.quantile(q)), q, bound) << "merged, q " << q;
+            EXPECT_NEAR(whole.cdf(stats::quantileSorted(samples, q)), q, bound) << "cdf, q " << q;
+        }
+    }
+}
+
+TEST_F(TimeSeriesStatsTest, TDigestIsExactWhileNothingHasMerged) {
+    namespace stats = ts::analysis::stats;
+    stats::TDigest sketch;
+    const std::vector<double> values{5.0, 1.0, NAN, 4.0, 2.0, 3.0};
+    sketch.add(values);
+    EXPECT_EQ(sketch.count(), 5u);  // the NaN is skipped
+    const std::vector<double> sorted{1.0, 2.0, 3.0, 4.0, 5.0};
+    for (const double q : {0.0, 0.1, 0.5, 0.8, 1.0}) {
+        EXPECT_DOUBLE_EQ(sketch.quantile(q), stats::quantileSorted(sorted, q)) << "q " << q;
+    }
+    EXPECT_EQ(sketch.cdf(0.0), 0.0);
+    EXPECT_EQ(sketch.cdf(5.0), 1.0);
+    EXPECT_THROW(stats::TDigest().quantile(0.5), std::invalid_argument);
+    EXPECT_THROW(sketch.quantile(1.5), std::invalid_argument);
+}
+
+TEST_F(TimeSeriesStatsTest, RollingStatisticsMatchTheStatsOnEachWindow) {
+    namespace stats = ts::analysis::stats;
+    using Stat = stats::RollingStatistic;
+    // A walk around 1e4 (so a naive power sum would cancel), with a NaN every 13 rows and one
+    // gap longer than the smallest window.
+    std::vector<double> values(noise.size());
+    for (size_t i = 0; i < values.size(); ++i) values[i] = 1e4 + walk[i];
+    for (size_t i = 5; i < values.size(); i += 13) values[i] = NAN;
+    for (size_t i = 700; i < 706; ++i) values[i] = NAN;
+
+    for (const size_t window : {size_t{1}, size_t{5}, size_t{64}}) {
+        const auto sum = stats::rolling(values, window, Stat::Sum);
+        const auto mean = stats::rolling(values, window, Stat::Mean);
+        const auto variance = stats::rolling(values, window, Stat::Variance);
+        const auto skew = stats::rolling(values, window, Stat::Skewness);
+        const auto lo = stats::rolling(values, window, Stat::Min);
+        const auto hi = stats::rolling(values, window, Stat::Max);
+        const auto z = stats::rolling(values, window, Stat::ZScore);
+        const auto median = stats::rolling(values, window, Stat::Median);
+        const auto q90 = stats::rollingQuantile(values, window, 0.9);
+
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i + 1 < window) {
+                EXPECT_TRUE(std::isnan(mean[i]) && std::isnan(lo[i]) && std::isnan(median[i])) << "row " << i;
+                continue;
+            }
+            std::vector<double> present;
+            for (size_t j = i + 1 - window; j <= i; ++j) {
+                if (std::isfinite(values[j])) present.push_back(values[j]);
+            }
+            if (present.empty()) {
+                EXPECT_TRUE(std::isnan(sum[i]) && std::isnan(hi[i]) && std::isnan(q90[i])) << "row " << i;
+                continue;
+            }
+            const double m = stats::mean(present);
+            EXPECT_NEAR(mean[i], m, 1e-9) << "window " << window << " row " << i;
+            EXPECT_NEAR(sum[i], m * static_cast<double>(present.size()), 1e-7);
+            EXPECT_EQ(lo[i], *std::min_element(present.begin(), present.end()));
+            EXPECT_EQ(hi[i], *std::max_element(present.begin(), present.end()));
+            std::sort(present.begin(), present.end());
+            EXPECT_DOUBLE_EQ(median[i], stats::quantileSorted(present, 0.5));
+            EXPECT_DOUBLE_EQ(q90[i], stats::quantileSorted(present, 0.9));
+            if (present.size() < 2) {
+                EXPECT_TRUE(std::isnan(variance[i]) && std::isnan(z[i])) << "row " << i;
+                continue;
+            }
+            const double v = stats::varianceFast(present);
+            EXPECT_NEAR(variance[i], v, 1e-8 * std::max(1.0, v)) << "window " << window << " row " << i;
+            EXPECT_NEAR(skew[i], stats::skewness(present), 1e-6) << "window " << window << " row " << i;
+            if (std::isfinite(values[i]) && v > 0.0) EXPECT_NEAR(z[i], (values[i] - m) / std::sqrt(v), 1e-6);
+        }
+    }
+
+    // The mask alone decides, so a decoy payload is skipped; a constant window has zero spread.
+    const std::vector<double> flat{2.0, 2.0, 1e6, 2.0, 2.0};
+    ts::ValidityBitmap bitmap(flat.size());
+    bitmap.set(2, false);
+    const auto flatVariance = stats::rolling(flat, bitmap.mask(), 3, Stat::Variance);
+    const auto flatMax = stats::rolling(flat, bitmap.mask(), 3, Stat::Max);
+    for (size_t i = 2; i < flat.size(); ++i) {
+        EXPECT_EQ(flatVariance[i], 0.0);
+        EXPECT_EQ(flatMax[i], 2.0);
+    }
+    EXPECT_THROW(stats::rolling(values, 0, Stat::Mean), std::invalid_argument);
+    EXPECT_THROW(stats::rollingQuantile(values, 5, 1.5), std::invalid_argument);
+}
+
+TEST_F(TimeSeriesStatsTest, EwmaMatchesTheExplicitlyWeightedSums) {
+    namespace stats = ts::analysis::stats;
+    const auto params = stats::EwmaParameters::fromHalfLife(10.0);
+    EXPECT_NEAR(params.halfLife(), 10.0, 1e-12);
+    std::vector<double> x(noise.begin(), noise.begin() + 300);
+    std::vector<double> y(autoregressive.begin(), autoregressive.begin() + 300);
+    for (size_t i = 7; i < x.size(); i += 31) x[i] = NAN;
+
+    const auto mean = stats::ewma(x, params, stats::EwmaStatistic::Mean);
+    const auto variance = stats::ewma(x, params, stats::EwmaStatistic::Variance);
+    const auto covariance = stats::ewmaCovariance(x, y, params);
+    auto riskMetrics = params;
+    riskMetrics.demean = false;
+    const auto zeroMean = stats::ewma(x, riskMetrics, stats::EwmaStatistic::Variance);
+
+    // Weights decay^(i - j) over the present rows, missing ones still ageing the rest.
+    for (const size_t i : {size_t{0}, size_t{1}, size_t{7}, size_t{40}, size_t{299}}) {
+        double w = 0.0, w2 = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0;
+        for (size_t j = 0; j <= i; ++j) {
+            if (std::isnan(x[j])) continue;
+            const double weight = std::pow(params.decay, static_cast<double>(i - j));
+            w += weight;
+            w2 += weight * weight;
+            sx += weight * x[j];
+            sy += weight * y[j];
+            sxx += weight * x[j] * x[j];
+        }
+        const double mx = sx / w, my = sy / w;
+        double m2 = 0.0, cxy = 0.0;
+        for (size_t j = 0; j <= i; ++j) {
+            if (std::isnan(x[j])) continue;
+            const double weight = std::pow(params.decay, static_cast<double>(i - j));
+            m2 += weight * (x[j] - mx) * (x[j] - mx);
+            cxy += weight * (x[j] - mx) * (y[j] - my);
+        }
+        EXPECT_NEAR(mean[i], mx, 1e-12) << "row " << i;
+        EXPECT_NEAR(zeroMean[i], sxx / w, 1e-12) << "row " << i;
+        if (w * w - w2 <= 1e-12) {
+            EXPECT_TRUE(std::isnan(variance[i]) && std::isnan(covariance[i])) << "row " << i;
+            continue;
+        }
+        EXPECT_NEAR(variance[i], m2 * w / (w * w - w2), 1e-10) << "row " << i;
+        EXPECT_NEAR(covariance[i], cxy * w / (w * w - w2), 1e-10) << "row " << i;
+    }
+
+    // All columns in one pass agree with the pairwise kernel and with the incremental state.
+    const std::vector<std::vector<double>> columns{
+        std::vector<double>(noise.begin(), noise.begin() + 300),
+        std::vector<double>(walk.begin(), walk.begin() + 300),
+        std::vector<double>(autoregressive.begin(), autoregressive.begin() + 300)};
+    std::vector<double> block;
+    for (const auto& c : columns) block.insert(block.end(), c.begin(), c.end());
+    auto grid = std::make_shared<const ts::TimestampGrid>(0, 60000, 300);
+    const ts::TimeSeriesPanel panel(grid, {"noise", "walk", "ar"}, block);
+    const auto all = stats::ewmaCovariance(panel, params);
+    const Eigen::MatrixXd cov = all.covariance();
+    const auto pair = stats::ewmaCovariance(columns[1], columns[2], params);
+    EXPECT_NEAR(cov(1, 2), pair.back(), 1e-10);
+    EXPECT_NEAR(cov(2, 1), pair.back(), 1e-10);
+    EXPECT_NEAR(cov(0, 0), stats::ewma(columns[0], params, stats::EwmaStatistic::Variance).back(), 1e-10);
+    EXPECT_NEAR(all.correlation(1, 2), stats::ewmaCorrelation(columns[1], columns[2], params).back(), 1e-12);
+
+    // The views overload reads the same rows; views of equal length on another grid are refused.
+    // (Column views keep their panel alive, so they need one that is shared.)
+    const auto owned = std::make_shared<const ts::TimeSeriesPanel>(panel);
+    const std::vector<ts::TimeSeriesView> views{owned->columnView(0), owned->columnView(1), owned->columnView(2)};
+    EXPECT_NEAR(stats::ewmaCovariance(views, params).covariance()(1, 2), cov(1, 2), 1e-12);
+    auto shifted = std::make_shared<TimeSeries>(
+        "shifted", std::make_shared<const ts::TimestampGrid>(30000, 60000, 300), 0, columns[2]);
+    const std::vector<ts::TimeSeriesView> misaligned{owned->columnView(0), shifted->view()};
+    EXPECT_THROW(stats::ewmaCovariance(misaligned, params), std::invalid_argument);
+
+    EXPECT_THROW(stats::EwmaParameters::fromHalfLife(0.0), std::invalid_argument);
+    EXPECT_THROW(stats::ewma(x, {.decay = 1.0}, stats::EwmaStatistic::Mean), std::invalid_argument);
+    EXPECT_THROW(stats::ewmaCovariance(x, noise, params), std::invalid_argument);
+}
@@ -1,17 +1,22 @@
 // "Copyright (c) 2026 JBBLET All Rights Reserved."
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <stdexcept>
 #include <utility>
 #include <vector>
 
 #include "finlib/common/FinlibTypes.hpp"
+#include "finlib/common/TimestampGrid.hpp"
 #include "finlib/common/utils/TimeSeriesUtils.hpp"
+#include "finlib/core/Resampling.hpp"
 #include "finlib/core/TimeSeries.hpp"
 
 using ts::TimeSeries;
 using ts::Timestamp;
+using ts::TimestampGrid;
 using ts::Timestamps;
 using ts::TimestampsPtr;
 
@@ -21,7 +26,7 @@ namespace {
 
 constexpr Timestamp kOpenEnded = std::numeric_limits<Timestamp>::max();
 
-TimestampsPtr gridOf(std::vector<Timestamp> ticks) { return std::make_shared<Timestamps>(std::move(ticks)); }
+TimestampsPtr gridOf(std::vector<Timestamp> ticks) { return std::make_shared<const TimestampGrid>(std::move(ticks)); }
 
 // Compares a series' values tick-by-tick against what the caller expects to read back.
 void expectValues(const TimeSeries& series, const std::vector<double>& expected) {
@@ -36,6 +41,123 @@ TimestampsPtr standardGrid() { return gridOf({100, 150, 200, 250}); }
 
 }  // namespace
 
+// ============================================================
+// TimestampGrid
+// ============================================================
+
+TEST(TimestampGridTest, RegularGridIndexesAndSearchesArithmetically) {
+    const TimestampGrid grid(100, 10, 5);  // 100, 110, 120, 130, 140
+    EXPECT_TRUE(grid.isRegular());
+    EXPECT_EQ(grid.size(), 5u);
+    EXPECT_EQ(grid[3], 130);
+    EXPECT_EQ(grid.back(), 140);
+    EXPECT_EQ(grid.lowerBound(99), 0u);
+    EXPECT_EQ(grid.lowerBound(110), 1u);
+    EXPECT_EQ(grid.lowerBound(111), 2u);
+    EXPECT_EQ(grid.upperBound(110), 2u);
+    EXPECT_EQ(grid.upperBound(1'000), 5u);
+    // Open bounds must not overflow the (ts - start) arithmetic.
+    EXPECT_EQ(grid.lowerBound(std::numeric_limits<Timestamp>::max()), 5u);
+    EXPECT_EQ(grid.upperBound(std::numeric_limits<Timestamp>::min()), 0u);
+    // Restricted to a sub-range, results clamp to it.
+    EXPECT_EQ(grid.lowerBound(100, 2, 4), 2u);
+    EXPECT_EQ(grid.upperBound(1'000, 2, 4), 4u);
+    EXPECT_FALSE(grid.isMaterialised());
+}
+
+TEST(TimestampGridTest, RegularGridMaterialisesOnlyWhenASpanIsRequested) {
+    const TimestampGrid grid(0, 5, 4);
+    EXPECT_EQ(grid, (Timestamps{0, 5, 10, 15}));
+    EXPECT_FALSE(grid.isMaterialised());
+    const auto span = grid.span();
+    EXPECT_TRUE(grid.isMaterialised());
+    EXPECT_EQ(Timestamps(span.begin(), span.end()), (Timestamps{0, 5, 10, 15}));
+}
+
+TEST(TimestampGridTest, ExplicitGridSearchesLikeTheVectorItHolds) {
+    const TimestampGrid grid(Timestamps{1, 3, 3, 7});
+    EXPECT_FALSE(grid.isRegular());
+    EXPECT_EQ(grid.lowerBound(3), 1u);
+    EXPECT_EQ(grid.upperBound(3), 3u);
+    EXPECT_EQ(grid.lowerBound(8), 4u);
+}
+
+TEST(TimestampGridTest, MatchesComparesRowsAcrossRepresentations) {
+    const TimestampGrid regular(100, 10, 5);
+    const TimestampGrid sameTicks(Timestamps{110, 120, 130});
+    EXPECT_TRUE(regular.matches(1, sameTicks, 0, 3));
+    EXPECT_FALSE(regular.matches(0, sameTicks, 0, 3));
+    EXPECT_TRUE(regular.matches(1, TimestampGrid(110, 10, 9), 0, 4));
+    EXPECT_FALSE(regular.matches(1, TimestampGrid(110, 20, 9), 0, 2));
+    EXPECT_FALSE(regular.matches(3, sameTicks, 0, 3));  // runs off the end of `regular`
+    EXPECT_FALSE(regular.isMaterialised());
+}
+
+TEST(TimestampGridTest, RejectsANonPositiveStep) {
+    EXPECT_THROW(TimestampGrid(0, 0, 3), std::invalid_argument);
+    EXPECT_THROW(TimestampGrid(0, -5, 3), std::invalid_argument);
+}
+
+TEST(TimestampGridTest, SeriesOnARegularGridNeverMaterialiseIt) {
+    auto grid = utils::makeRegularTimestamps(0, 90, 10);
+    TimeSeries series("s", grid, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    EXPECT_EQ(series.lowerBound(35), 4u);
+    EXPECT_EQ(series.upperBound(40), 5u);
+    EXPECT_EQ(series.exactValue(70), 7.0);
+    EXPECT_EQ(series.latestValue(75), 7.0);
+
+    // Aligned against an explicit copy of the same ticks: the slow path compares on the grids.
+    Timestamps ticks;
+    for (Timestamp t = 0; t <= 90; t += 10) ticks.push_back(t);
+    TimeSeries explicitCopy("e", ticks, std::vector<double>(10, 1.0));
+    EXPECT_EQ((series + explicitCopy).getValues()[9], 10.0);
+
+    // Resampling onto a regular target reads it by index.
+    auto target = utils::makeRegularTimestamps(5, 85, 20);
+    const TimeSeries resampled = ts::resample(series, target, ts::InterpolationStrategy::Latest);
+    EXPECT_TRUE(std::ranges::equal(resampled.getValues(), std::vector<double>{0, 2, 4, 6, 8}));
+    EXPECT_EQ(resampled.getSharedTimestamps(), target);
+
+    EXPECT_FALSE(grid->isMaterialised());
+    EXPECT_FALSE(target->isMaterialised());
+}
+
+TEST(TimestampGridTest, FingerprintDependsOnTheTicksNotTheRepresentation) {
+    const TimestampGrid regular(100, 10, 5);
+    const TimestampGrid sameTicks(Timestamps{100, 110, 120, 130, 140});
+    const TimestampGrid oneTickOff(Timestamps{100, 110, 121, 130, 140});
+    EXPECT_EQ(regular.fingerprint(), sameTicks.fingerprint());
+    EXPECT_NE(sameTicks.fingerprint(), oneTickOff.fingerprint());
+    EXPECT_NE(TimestampGrid(100, 10, 4).fingerprint(), regular.fingerprint());
+    EXPECT_FALSE(regular.isMaterialised());
+
+    // Whole-grid alignment between two distinct explicit grids: the fingerprints reject, an
+    // element compare confirms.
+    EXPECT_TRUE(sameTicks.matches(0, TimestampGrid(Timestamps{100, 110, 120, 130, 140}), 0, 5));
+    EXPECT_FALSE(sameTicks.matches(0, oneTickOff, 0, 5));
+}
+
+TEST(TimestampGridTest, InternReturnsOneGridPerDistinctContent) {
+    const TimestampsPtr first = TimestampGrid::intern(gridOf({7, 8, 9, 1'000'003}));
+    const TimestampsPtr again = TimestampGrid::intern(gridOf({7, 8, 9, 1'000'003}));
+    TimestampsPtr other = TimestampGrid::intern(gridOf({7, 8, 9, 1'000'004}));
+    EXPECT_EQ(first, again);
+    EXPECT_NE(first, other);
+
+    // Series built on interned grids align by pointer.
+    TimeSeries a("a", first, {1, 2, 3, 4});
+    TimeSeries b("b", again, {1, 1, 1, 1});
+    EXPECT_EQ((a + b).getValues()[3], 5.0);
+
+    // The table holds weak references: interning never keeps a grid alive, and the next request
+    // for released content simply becomes the new canonical grid.
+    const std::weak_ptr<const TimestampGrid> watch = other;
+    other.reset();
+    EXPECT_TRUE(watch.expired());
+    const TimestampsPtr fresh = TimestampGrid::intern(gridOf({7, 8, 9, 1'000'004}));
+    EXPECT_EQ(TimestampGrid::intern(gridOf({7, 8, 9, 1'000'004})), fresh);
+}
+
 // ============================================================
 // makeRegularTimestamps
 // ============================================================
@@ -55,6 +177,26 @@ TEST(MakeRegularTimestampsTest, YieldsASingleTickWhenBeginEqualsEnd) {
     EXPECT_EQ(*grid, (Timestamps{5}));
 }
 
+TEST(MakeRegularTimestampsTest, BuildsAnImplicitGrid) {
+    auto grid = utils::makeRegularTimestamps(0, 3'600'000, 60'000);
+    EXPECT_TRUE(grid->isRegular());
+    EXPECT_EQ(grid->size(), 61u);
+    EXPECT_FALSE(grid->isMaterialised());
+}
+
+TEST(MakeRegularTimestampsTest, IdenticalRequestsShareOneGrid) {
+    auto grid = utils::makeRegularTimestamps(0, 3'600'000, 60'000);
+    // Any end inside the last step describes the same ticks.
+    EXPECT_EQ(utils::makeRegularTimestamps(0, 3'600'000 + 59'999, 60'000), grid);
+    EXPECT_EQ(TimestampGrid::regular(0, 60'000, 61), grid);
+    EXPECT_NE(utils::makeRegularTimestamps(0, 3'600'000, 30'000), grid);
+
+    // Series on separately requested grids meet on the pointer fast path.
+    const TimeSeries a = utils::generateConstantTimeSeries("a", 0, 3'600'000, 60'000, 1.0);
+    const TimeSeries b = utils::generateConstantTimeSeries("b", 0, 3'600'000, 60'000, 2.0);
+    EXPECT_EQ(a.getSharedTimestamps(), b.getSharedTimestamps());
+}
+
 TEST(MakeRegularTimestampsTest, YieldsOnlyBeginWhenFrequencyExceedsTheSpan) {
     auto grid = utils::makeRegularTimestamps(0, 10, 100);
     EXPECT_EQ(*grid, (Timestamps{0}));
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "TestMockTimeSeries.hpp"
 #include "finlib/common/Error.hpp"
@@ -120,3 +122,22 @@ TEST_F(TimeSeriesViewTest, ScalarArithmeticSharesTimestampPointer) {
     EXPECT_EQ(result.getSharedTimestamps(), series->getSharedTimestamps());
     EXPECT_EQ(result.tsOffset(), 1u);
 }
+
+TEST_F(TimeSeriesViewTest, ViewOutlivesItsSourceSwappingValues) {
+    // The view pins the value block it reads, so neither an in-place mutation nor an assignment
+    // of the source frees it underneath (run under ASan to see the difference).
+    auto view = series->slice(1, 3);
+    series->applyInPlace([](double v) { return -v; });
+    EXPECT_EQ(view[0], 20.0);
+    EXPECT_EQ(series->getValues()[1], -20.0);
+
+    // The id outlives the assignment too; one longer than the small-string buffer lives on the heap.
+    const std::string longId = "A series id long enough to be heap allocated";
+    *series = TimeSeries(longId, series->getSharedTimestamps(), 0, std::vector<double>(5, -1.0));
+    auto assigned = series->slice(0, 2);
+    *series = TimeSeries("Replaced", series->getSharedTimestamps(), 0, std::vector<double>(5, 1.0));
+    EXPECT_EQ(assigned[0], -1.0);
+    EXPECT_EQ(view[2], 40.0);
+    EXPECT_EQ(assigned.getTimeSeriesId(), longId);
+    EXPECT_NE(assigned.toString().find(longId), std::string::npos);
+}